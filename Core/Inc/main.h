@@ -67,6 +67,11 @@ extern "C" {
 void Error_Handler(void);
 
 /* USER CODE BEGIN EFP */
+void QSPI_BeginWrite(void);
+void QSPI_EndWrite(void);
+HAL_StatusTypeDef QSPI_EraseSector(uint32_t address);
+HAL_StatusTypeDef QSPI_Program(uint32_t address, const void *data, uint32_t len);
+void debug(const char *fmt, ...);
 
 /* USER CODE END EFP */
 
@@ -87,6 +92,8 @@ void Error_Handler(void);
 #define MCU_ACTIVE_GPIO_Port GPIOG
 
 /* USER CODE BEGIN Private defines */
+#define PWM_OUT_Pin GPIO_PIN_8
+#define PWM_OUT_GPIO_Port GPIOA
 
 /* USER CODE END Private defines */
 
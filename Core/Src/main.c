@@ -14,6 +14,7 @@
  * the License. You may obtain a copy of the License at:
  *                             www.st.com/SLA0044
  *	PA4 - DAC
+ *	PA5 - DAC OUT2 (dual-режим, DHR12RD)
  * 	налаштувати таймер 7 на 1кГц +
  * 	налаштувати ногодриг +
  * 	спробувати змінити колір кнопки при натисканні +
@@ -83,6 +84,13 @@
 #define FLASH_REVC03_MANUFACTURER_ID	0xEF
 #define FLASH_N25Q128A_DUMMY_CYCLES		0x0A
 #define FLASH_W25Q128J_DUMMY_CYCLES		0x06
+#define FLASH_WRITE_ENABLE				0x06
+#define FLASH_READ_STATUS_REG			0x05
+#define FLASH_PAGE_PROGRAM				0x02
+#define FLASH_SUBSECTOR_ERASE_4K		0x20
+#define FLASH_STATUS_BUSY				0x01
+#define FLASH_PAGE_SIZE					256U
+#define FLASH_ERASE_TIMEOUT_MS			800U
 
 /* USER CODE END PD */
 
@@ -133,6 +141,7 @@ const osThreadAttr_t videoTask_attributes = {
 };
 /* USER CODE BEGIN PV */
 static FMC_SDRAM_CommandTypeDef Command;
+static uint8_t qspi_manufacturer_id;
 /* USER CODE END PV */
 
 /* Private function prototypes -----------------------------------------------*/
@@ -160,7 +169,6 @@ void EnableMemoryMappedMode(uint8_t manufacturer_id);
 
 /* Private user code ---------------------------------------------------------*/
 /* USER CODE BEGIN 0 */
-extern uint16_t sine_table[];
 
 int _write(int file, char *ptr, int len)
 {
@@ -248,10 +256,10 @@ int main(void)
 
 	// Генеруємо таблицю синуса ДО старту FreeRTOS
 //	Generete_SineTable(3000);
-//	SCB_CleanDCache_by_Addr((uint32_t*) sine_table, SINE_SAMPLES * sizeof(uint16_t));
-	
-	// Запускаємо DAC DMA (без старту таймера)
-	HAL_DAC_Start_DMA(&hdac, DAC1_CHANNEL_1, (uint32_t*) sine_table, SINE_SAMPLES, DAC_ALIGN_12B_R);
+	SignalGen_Init();
+
+	// Запускаємо DAC DMA (без старту таймера), DDS дозаповнює буфер по половинах
+	SignalGen_Start();
   /* USER CODE END 2 */
 
   /* Init scheduler */
@@ -425,7 +433,12 @@ static void MX_DAC_Init(void)
     Error_Handler();
   }
   /* USER CODE BEGIN DAC_Init 2 */
-
+  /** DAC channel OUT2 config (PA5), той самий тригер - оновлюється разом з OUT1
+  */
+  if (HAL_DAC_ConfigChannel(&hdac, &sConfig, DAC_CHANNEL_2) != HAL_OK)
+  {
+    Error_Handler();
+  }
   /* USER CODE END DAC_Init 2 */
 
 }
@@ -607,9 +620,8 @@ static void MX_QUADSPI_Init(void)
     Error_Handler();
   }
   /* USER CODE BEGIN QUADSPI_Init 2 */
-	uint8_t manufacturer_id;
-	GetManufacturerId( &manufacturer_id);
-	EnableMemoryMappedMode(manufacturer_id);
+	GetManufacturerId( &qspi_manufacturer_id);
+	EnableMemoryMappedMode(qspi_manufacturer_id);
 	HAL_NVIC_DisableIRQ(QUADSPI_IRQn);
   /* USER CODE END QUADSPI_Init 2 */
 
@@ -920,6 +932,115 @@ void EnableMemoryMappedMode(uint8_t manufacturer_id)
 	}
 }
 
+// Indirect-mode command without data phase (write enable, erase)
+static HAL_StatusTypeDef QSPI_Instruction(uint8_t instruction, uint32_t address_mode, uint32_t address)
+{
+	QSPI_CommandTypeDef s_command = {0};
+
+	s_command.InstructionMode = QSPI_INSTRUCTION_1_LINE;
+	s_command.Instruction = instruction;
+	s_command.AddressMode = address_mode;
+	s_command.AddressSize = QSPI_ADDRESS_24_BITS;
+	s_command.Address = address;
+	s_command.AlternateByteMode = QSPI_ALTERNATE_BYTES_NONE;
+	s_command.DataMode = QSPI_DATA_NONE;
+	s_command.DdrMode = QSPI_DDR_MODE_DISABLE;
+	s_command.DdrHoldHalfCycle = QSPI_DDR_HHC_ANALOG_DELAY;
+	s_command.SIOOMode = QSPI_SIOO_INST_EVERY_CMD;
+
+	return HAL_QSPI_Command( &hqspi, &s_command, HAL_QPSI_TIMEOUT_DEFAULT_VALUE);
+}
+
+// Poll the status register until the program/erase in progress ends
+static HAL_StatusTypeDef QSPI_WaitReady(uint32_t timeout)
+{
+	QSPI_CommandTypeDef s_command = {0};
+	QSPI_AutoPollingTypeDef s_config = {0};
+
+	s_command.InstructionMode = QSPI_INSTRUCTION_1_LINE;
+	s_command.Instruction = FLASH_READ_STATUS_REG;
+	s_command.AddressMode = QSPI_ADDRESS_NONE;
+	s_command.AlternateByteMode = QSPI_ALTERNATE_BYTES_NONE;
+	s_command.DataMode = QSPI_DATA_1_LINE;
+	s_command.DdrMode = QSPI_DDR_MODE_DISABLE;
+	s_command.DdrHoldHalfCycle = QSPI_DDR_HHC_ANALOG_DELAY;
+	s_command.SIOOMode = QSPI_SIOO_INST_EVERY_CMD;
+
+	s_config.Match = 0;
+	s_config.Mask = FLASH_STATUS_BUSY;
+	s_config.MatchMode = QSPI_MATCH_MODE_AND;
+	s_config.StatusBytesSize = 1;
+	s_config.Interval = 0x10;
+	s_config.AutomaticStop = QSPI_AUTOMATIC_STOP_ENABLE;
+
+	return HAL_QSPI_AutoPolling( &hqspi, &s_command, &s_config, timeout);
+}
+
+// Leave memory-mapped mode for erase/program. Nothing may read 0x90000000
+// until QSPI_EndWrite(): the scheduler stays locked in between, so only the
+// calling task runs (TouchGFX reads its assets from the same window)
+void QSPI_BeginWrite(void)
+{
+	osKernelLock();
+	HAL_QSPI_Abort( &hqspi);
+}
+
+void QSPI_EndWrite(void)
+{
+	EnableMemoryMappedMode(qspi_manufacturer_id);
+	osKernelUnlock();
+}
+
+// Erase the 4 KB subsector at address (offset inside the flash chip)
+HAL_StatusTypeDef QSPI_EraseSector(uint32_t address)
+{
+	if(QSPI_Instruction(FLASH_WRITE_ENABLE, QSPI_ADDRESS_NONE, 0) != HAL_OK)
+		return HAL_ERROR;
+	if(QSPI_Instruction(FLASH_SUBSECTOR_ERASE_4K, QSPI_ADDRESS_1_LINE, address) != HAL_OK)
+		return HAL_ERROR;
+	return QSPI_WaitReady(FLASH_ERASE_TIMEOUT_MS);
+}
+
+// Program len bytes at address, split on page boundaries (single line, 0x02)
+HAL_StatusTypeDef QSPI_Program(uint32_t address, const void *data, uint32_t len)
+{
+	const uint8_t *src = (const uint8_t *)data;
+	QSPI_CommandTypeDef s_command = {0};
+
+	s_command.InstructionMode = QSPI_INSTRUCTION_1_LINE;
+	s_command.Instruction = FLASH_PAGE_PROGRAM;
+	s_command.AddressMode = QSPI_ADDRESS_1_LINE;
+	s_command.AddressSize = QSPI_ADDRESS_24_BITS;
+	s_command.AlternateByteMode = QSPI_ALTERNATE_BYTES_NONE;
+	s_command.DataMode = QSPI_DATA_1_LINE;
+	s_command.DdrMode = QSPI_DDR_MODE_DISABLE;
+	s_command.DdrHoldHalfCycle = QSPI_DDR_HHC_ANALOG_DELAY;
+	s_command.SIOOMode = QSPI_SIOO_INST_EVERY_CMD;
+
+	while(len)
+	{
+		uint32_t n = FLASH_PAGE_SIZE - (address % FLASH_PAGE_SIZE);
+
+		if(n > len) n = len;
+		if(QSPI_Instruction(FLASH_WRITE_ENABLE, QSPI_ADDRESS_NONE, 0) != HAL_OK)
+			return HAL_ERROR;
+
+		s_command.Address = address;
+		s_command.NbData = n;
+		if(HAL_QSPI_Command( &hqspi, &s_command, HAL_QPSI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
+			return HAL_ERROR;
+		if(HAL_QSPI_Transmit( &hqspi, (uint8_t *)src, HAL_QPSI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
+			return HAL_ERROR;
+		if(QSPI_WaitReady(HAL_QPSI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
+			return HAL_ERROR;
+
+		address += n;
+		src += n;
+		len -= n;
+	}
+	return HAL_OK;
+}
+
 /* USER CODE END 4 */
 
 /* USER CODE BEGIN Header_StartDefaultTask */
@@ -175,7 +175,13 @@ void HAL_DAC_MspInit(DAC_HandleTypeDef* hdac)
     HAL_NVIC_SetPriority(TIM6_DAC_IRQn, 0, 0);
     HAL_NVIC_EnableIRQ(TIM6_DAC_IRQn);
     /* USER CODE BEGIN DAC_MspInit 1 */
-
+    /**DAC GPIO Configuration
+    PA5     ------> DAC_OUT2
+    */
+    GPIO_InitStruct.Pin = GPIO_PIN_5;
+    GPIO_InitStruct.Mode = GPIO_MODE_ANALOG;
+    GPIO_InitStruct.Pull = GPIO_NOPULL;
+    HAL_GPIO_Init(GPIOA, &GPIO_InitStruct);
     /* USER CODE END DAC_MspInit 1 */
 
   }
@@ -209,7 +215,7 @@ void HAL_DAC_MspDeInit(DAC_HandleTypeDef* hdac)
     /* DAC interrupt DeInit */
     HAL_NVIC_DisableIRQ(TIM6_DAC_IRQn);
     /* USER CODE BEGIN DAC_MspDeInit 1 */
-
+    HAL_GPIO_DeInit(GPIOA, GPIO_PIN_5);
     /* USER CODE END DAC_MspDeInit 1 */
   }
 
@@ -0,0 +1,112 @@
+/*
+ * blep.c
+ *
+ *  PolyBLEP, with x = distance from the edge in samples (|x| < 1):
+ *    just after the edge   r = 2x - x^2 - 1
+ *    just before the edge  r = (1 - |x|)^2
+ *  for a -1 -> +1 step. x comes from one 64-bit multiply by 2^48/dt,
+ *  computed once per block, so no division in the sample loop.
+ *  Codes go through the DAC correction (dds->cal) on the store.
+ */
+#include "blep.h"
+
+#define PHASE_HALF      0x80000000U
+
+uint64_t Blep_InvDt(uint32_t dt)
+{
+    return (dt != 0U) ? ((1ULL << 48) / dt) : 0U;
+}
+
+static inline int32_t residual(uint32_t t, uint32_t dt, uint64_t inv_dt)
+{
+    /* Window test: t in [0, dt) or t in (2^32 - dt, 2^32) */
+    if ((uint32_t)(t + dt) >= 2U * dt)
+        return 0;
+
+    if (t < dt)
+    {
+        int32_t x = (int32_t)((t * inv_dt) >> 32);             /* Q16 */
+        return (2 * x - (int32_t)(((int64_t)x * x) >> 16) - 65536) >> 1;
+    }
+    else
+    {
+        int32_t y = 65536 - (int32_t)(((uint32_t)-t * inv_dt) >> 32);
+        return (int32_t)(((int64_t)y * y) >> 17);
+    }
+}
+
+int32_t Blep_Residual(uint32_t t, uint32_t dt, uint64_t inv_dt)
+{
+    return residual(t, dt, inv_dt);
+}
+
+static inline uint16_t to_dac(int32_t v, uint16_t low, uint32_t span)
+{
+    int32_t u = v + 32768;
+
+    if (u < 0) u = 0;
+    if (u > 65535) u = 65535;
+    return (uint16_t)(low + (((uint32_t)u * span + 32768U) >> 16));
+}
+
+DDS_INLINE void fill_pulse(DDS_t *dds, uint32_t duty, uint16_t low, uint16_t high, const uint16_t *cal,
+                           uint16_t *dst, uint32_t count)
+{
+    const uint32_t dt = (dds->tuning_word < PHASE_HALF) ? dds->tuning_word : PHASE_HALF - 1U;
+    const uint64_t inv_dt = Blep_InvDt(dt);
+    const uint32_t span = (uint32_t)(high - low);
+    uint32_t phase = dds->phase;
+
+    while (count--)
+    {
+        int32_t v = (phase < duty) ? 32767 : -32768;
+
+        v += residual(phase, dt, inv_dt);           /* rising edge at 0     */
+        v -= residual(phase - duty, dt, inv_dt);    /* falling edge at duty */
+
+        *dst++ = DDS_Cal(cal, to_dac(v, low, span));
+        phase += dds->tuning_word;
+    }
+    dds->phase = phase;
+}
+
+void Blep_FillPulse(DDS_t *dds, uint32_t duty, uint16_t low, uint16_t high, uint16_t *dst, uint32_t count)
+{
+    if (dds->cal)
+        fill_pulse(dds, duty, low, high, dds->cal, dst, count);
+    else
+        fill_pulse(dds, duty, low, high, NULL, dst, count);
+}
+
+DDS_INLINE void fill_ramp(DDS_t *dds, uint16_t low, uint16_t high, int down, const uint16_t *cal,
+                          uint16_t *dst, uint32_t count)
+{
+    const uint32_t dt = (dds->tuning_word < PHASE_HALF) ? dds->tuning_word : PHASE_HALF - 1U;
+    const uint64_t inv_dt = Blep_InvDt(dt);
+    const uint32_t span = (uint32_t)(high - low);
+    uint32_t phase = dds->phase;
+
+    while (count--)
+    {
+        /* Same alignment as Waveform_FillRamp: the reset is at phase = 1/2 */
+        uint32_t u = phase + PHASE_HALF;
+        int32_t v;
+
+        if (down)
+            v = (int32_t)(~u >> 16) - 32768 + residual(u, dt, inv_dt);
+        else
+            v = (int32_t)(u >> 16) - 32768 - residual(u, dt, inv_dt);
+
+        *dst++ = DDS_Cal(cal, to_dac(v, low, span));
+        phase += dds->tuning_word;
+    }
+    dds->phase = phase;
+}
+
+void Blep_FillRamp(DDS_t *dds, uint16_t low, uint16_t high, int down, uint16_t *dst, uint32_t count)
+{
+    if (dds->cal)
+        fill_ramp(dds, low, high, down, dds->cal, dst, count);
+    else
+        fill_ramp(dds, low, high, down, NULL, dst, count);
+}
@@ -0,0 +1,33 @@
+/*
+ * blep.h
+ *
+ *  Band-limited square/pulse and ramp kernels (PolyBLEP). The naive
+ *  kernels in waveform.c alias badly once the fundamental is a sizeable
+ *  fraction of the 1 MS/s update rate; these smooth the one or two
+ *  samples around each discontinuity with a 2nd-order polynomial step.
+ *
+ *  Fixed point, phase-driven like waveform.c, so they render block by
+ *  block with no state beyond the DDS phase.
+ */
+#ifndef BLEP_H
+#define BLEP_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include "dds.h"
+
+/* PolyBLEP residual in Q15 for a -1 -> +1 step, t = phase past the edge */
+int32_t Blep_Residual(uint32_t t, uint32_t dt, uint64_t inv_dt);
+uint64_t Blep_InvDt(uint32_t dt);
+
+void Blep_FillPulse(DDS_t *dds, uint32_t duty, uint16_t low, uint16_t high, uint16_t *dst, uint32_t count);
+void Blep_FillRamp(DDS_t *dds, uint16_t low, uint16_t high, int down, uint16_t *dst, uint32_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BLEP_H */
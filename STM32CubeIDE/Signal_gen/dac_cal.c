@@ -0,0 +1,73 @@
+/*
+ * dac_cal.c
+ *
+ *  The measured points describe the DAC as a piecewise-linear curve
+ *  code -> uV. Building the table inverts it: for every wanted code the
+ *  ideal voltage is located on the curve and interpolated back to a DAC
+ *  code. Both walk upwards, so the build is one pass over 4096 codes.
+ *  Beyond the first/last point the end spans are extrapolated, then the
+ *  result is clamped to the DAC range.
+ */
+#include "dac_cal.h"
+#include <stddef.h>
+
+#define DAC_CAL_MAX_CODE    (DAC_CAL_CODES - 1U)
+
+uint16_t DacCal_ProbeCode(uint32_t index, uint32_t count)
+{
+    if (count < 2U || index >= count - 1U)
+        return (uint16_t)DAC_CAL_MAX_CODE;
+    return (uint16_t)((index * DAC_CAL_MAX_CODE + (count - 1U) / 2U) / (count - 1U));
+}
+
+/* At least two points, code and output both strictly rising */
+int DacCal_Check(const DacCalPoint_t *pts, uint32_t count)
+{
+    if (pts == NULL || count < 2U || count > DAC_CAL_MAX_POINTS)
+        return 0;
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (pts[i].code > DAC_CAL_MAX_CODE)
+            return 0;
+        if (i > 0U && (pts[i].code <= pts[i - 1U].code || pts[i].out_uv <= pts[i - 1U].out_uv))
+            return 0;
+    }
+    return 1;
+}
+
+int DacCal_Build(const DacCalPoint_t *pts, uint32_t count, int32_t vref_uv, uint16_t *lut)
+{
+    uint32_t seg = 0;
+
+    if (!DacCal_Check(pts, count) || vref_uv <= 0)
+        return 0;
+
+    for (uint32_t c = 0; c < DAC_CAL_CODES; c++)
+    {
+        int64_t target = ((int64_t)c * vref_uv + DAC_CAL_MAX_CODE / 2U) / DAC_CAL_MAX_CODE;
+        const DacCalPoint_t *a, *b;
+        int64_t num, den, d;
+
+        while (seg + 2U < count && target > pts[seg + 1U].out_uv)
+            seg++;
+        a = &pts[seg];
+        b = &pts[seg + 1U];
+
+        /* d = a.code + (target - a.uv) * dcode / duv, rounded to nearest */
+        num = (target - a->out_uv) * (int64_t)(b->code - a->code);
+        den = (int64_t)b->out_uv - a->out_uv;
+        d = a->code + ((num >= 0) ? (num + den / 2) / den : -((-num + den / 2) / den));
+
+        if (d < 0) d = 0;
+        if (d > (int64_t)DAC_CAL_MAX_CODE) d = DAC_CAL_MAX_CODE;
+        lut[c] = (uint16_t)d;
+    }
+    return 1;
+}
+
+void DacCal_Identity(uint16_t *lut)
+{
+    for (uint32_t c = 0; c < DAC_CAL_CODES; c++)
+        lut[c] = (uint16_t)c;
+}
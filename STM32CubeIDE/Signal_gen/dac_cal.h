@@ -0,0 +1,43 @@
+/*
+ * dac_cal.h
+ *
+ *  DAC gain, offset and INL correction. A 4096-entry table maps the code
+ *  a kernel wants to the code that actually produces that voltage; the
+ *  kernels look it up on the store (DDS_t.cal), so the correction rides
+ *  in the pass that writes the DMA buffer and costs no extra pass.
+ *
+ *  The table is built from measured points: the DAC is stepped through
+ *  DacCal_ProbeCode(i, count) as DC levels with no correction active,
+ *  the output is measured (uV) and the (code, uV) pairs are stored.
+ *  Two points correct gain and offset; more points follow the INL bow
+ *  piecewise linearly. The ideal response is code * vref / 4095.
+ *
+ *  No HAL dependency, builds on the host (Tests/).
+ */
+#ifndef DAC_CAL_H
+#define DAC_CAL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+#define DAC_CAL_CODES       4096U
+#define DAC_CAL_MAX_POINTS  33U     /* 0, 128, ... 3968, 4095 */
+
+typedef struct {
+    uint16_t code;      /* code written to the DAC             */
+    int32_t out_uv;     /* measured output, microvolts         */
+} DacCalPoint_t;
+
+uint16_t DacCal_ProbeCode(uint32_t index, uint32_t count);
+int  DacCal_Check(const DacCalPoint_t *pts, uint32_t count);
+int  DacCal_Build(const DacCalPoint_t *pts, uint32_t count, int32_t vref_uv, uint16_t *lut);
+void DacCal_Identity(uint16_t *lut);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DAC_CAL_H */
@@ -0,0 +1,69 @@
+/*
+ * dac_wave.c
+ *
+ *  The triangle period in triggers is fixed by the swing, so the search
+ *  is FreqPlan_Search with N pinned to that period: only the timer
+ *  divider moves.
+ */
+#include "dac_wave.h"
+
+#define DACWAVE_MAX_BITS   12U
+
+uint32_t DacWave_AmplitudeBits(uint16_t low, uint16_t high)
+{
+    uint32_t span;
+
+    if (high <= low)
+        return 0;
+
+    span = (uint32_t)(high - low) + 1U;
+    for (uint32_t bits = 1; bits <= DACWAVE_MAX_BITS; bits++)
+    {
+        if (span == (1U << bits))
+            return bits;
+    }
+    return 0;
+}
+
+int DacWave_PlanTriangle(const FreqPlanLimits_t *lim, uint16_t low, uint16_t high,
+                         uint32_t freq_mhz, DacWave_t *w)
+{
+    FreqPlanLimits_t pinned = *lim;
+    uint32_t bits = DacWave_AmplitudeBits(low, high);
+
+    if (bits == 0U)
+        return 0;
+
+    pinned.n_min = 2U * ((1U << bits) - 1U);
+    pinned.n_max = pinned.n_min;
+    if (!FreqPlan_Search(&pinned, freq_mhz, &w->timer))
+        return 0;
+
+    w->kind = DACWAVE_TRIANGLE;
+    w->bits = bits;
+    w->base = low;
+    return 1;
+}
+
+int DacWave_PlanNoise(const FreqPlanLimits_t *lim, uint16_t low, uint16_t high, DacWave_t *w)
+{
+    uint32_t bits = DacWave_AmplitudeBits(low, high);
+
+    if (bits == 0U)
+        return 0;
+
+    /* New LFSR value on every trigger at the full DAC rate */
+    w->kind = DACWAVE_NOISE;
+    w->bits = bits;
+    w->base = low;
+    w->timer.psc = 0;
+    w->timer.arr = lim->min_divider - 1U;
+    w->timer.n = 1;
+    w->timer.k = lim->min_divider;
+    return 1;
+}
+
+uint32_t DacWave_Frequency_mHz(const FreqPlanLimits_t *lim, const DacWave_t *w)
+{
+    return FreqPlan_Frequency_mHz(lim, &w->timer);
+}
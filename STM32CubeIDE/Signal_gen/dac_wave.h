@@ -0,0 +1,54 @@
+/*
+ * dac_wave.h
+ *
+ *  Planning for the DAC's built-in wave generators. With WAVE1 set, every
+ *  TIM7 trigger steps a hardware counter and the DAC outputs
+ *
+ *      DHR + triangle counter   (0 .. 2^bits - 1 .. 0, period 2 * (2^bits - 1))
+ *      DHR + (LFSR & mask)      (mask = 2^bits - 1)
+ *
+ *  so no table, no DMA and no CPU once started. The swing is limited to
+ *  2^bits - 1 and the triangle frequency to timer_clk / (D * period), so
+ *  the planner only accepts [low, high] swings of that form and timer
+ *  dividers D within the error tolerance. Everything else stays on DMA.
+ *
+ *  No HAL dependency; signal_gen.c programs DAC_CR, DHR and TIM7.
+ */
+#ifndef DAC_WAVE_H
+#define DAC_WAVE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include "freq_plan.h"
+
+typedef enum {
+    DACWAVE_OFF = 0,       /* DMA path                              */
+    DACWAVE_TRIANGLE,
+    DACWAVE_NOISE
+} DacWaveKind_t;
+
+typedef struct {
+    DacWaveKind_t kind;
+    uint32_t bits;          /* swing 2^bits - 1, DAC_CR MAMP = bits-1 */
+    uint16_t base;          /* DHR value the counter is added to      */
+    FreqPlan_t timer;       /* TIM7 PSC/ARR, n = triggers per period  */
+} DacWave_t;
+
+/* bits if high - low == 2^bits - 1 (1..12), else 0 */
+uint32_t DacWave_AmplitudeBits(uint16_t low, uint16_t high);
+
+/* lim: timer clock, DAC rate limit and tolerance; n_min/n_max are ignored */
+int DacWave_PlanTriangle(const FreqPlanLimits_t *lim, uint16_t low, uint16_t high,
+                         uint32_t freq_mhz, DacWave_t *w);
+int DacWave_PlanNoise(const FreqPlanLimits_t *lim, uint16_t low, uint16_t high, DacWave_t *w);
+
+uint32_t DacWave_Frequency_mHz(const FreqPlanLimits_t *lim, const DacWave_t *w);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DAC_WAVE_H */
@@ -0,0 +1,164 @@
+/*
+ * dds.c
+ *
+ *  f_out = tuning_word * f_s / 2^32, so at 1 MS/s one LSB of the tuning
+ *  word is ~0.23 mHz. The top table_bits of the phase index the table.
+ */
+#include "dds.h"
+#include "dsp_intrin.h"
+
+void DDS_Init(DDS_t *dds, const uint16_t *table, uint32_t table_bits, uint32_t sample_rate_hz)
+{
+    dds->phase = 0;
+    dds->tuning_word = 0;
+    dds->sample_rate_hz = sample_rate_hz;
+    dds->cal = NULL;
+    DDS_SetTable(dds, table, table_bits);
+}
+
+void DDS_SetTable(DDS_t *dds, const uint16_t *table, uint32_t table_bits)
+{
+    dds->table = table;
+    dds->table_shift = 32U - table_bits;
+}
+
+uint32_t DDS_TuningWord_mHz(uint32_t sample_rate_hz, uint32_t freq_mhz)
+{
+    uint64_t fs_mhz = (uint64_t)sample_rate_hz * 1000U;
+
+    /* Round to nearest; anything at or above Nyquist is clamped */
+    if (fs_mhz == 0 || (uint64_t)freq_mhz * 2U >= fs_mhz)
+        return 0x80000000U;
+
+    return (uint32_t)((((uint64_t)freq_mhz << 32) + fs_mhz / 2U) / fs_mhz);
+}
+
+void DDS_SetFrequency_mHz(DDS_t *dds, uint32_t freq_mhz)
+{
+    /* Single aligned word store: safe against the DMA refill ISR */
+    dds->tuning_word = DDS_TuningWord_mHz(dds->sample_rate_hz, freq_mhz);
+}
+
+uint32_t DDS_GetFrequency_mHz(const DDS_t *dds)
+{
+    uint64_t fs_mhz = (uint64_t)dds->sample_rate_hz * 1000U;
+
+    return (uint32_t)(((uint64_t)dds->tuning_word * fs_mhz + (1ULL << 31)) >> 32);
+}
+
+void DDS_Fill(DDS_t *dds, uint16_t *dst, uint32_t count)
+{
+    const uint16_t *table = dds->table;
+    const uint32_t shift = dds->table_shift;
+    const uint32_t step = dds->tuning_word;
+    uint32_t phase = dds->phase;
+
+    while (count >= 4U)
+    {
+        dst[0] = table[phase >> shift]; phase += step;
+        dst[1] = table[phase >> shift]; phase += step;
+        dst[2] = table[phase >> shift]; phase += step;
+        dst[3] = table[phase >> shift]; phase += step;
+        dst += 4;
+        count -= 4U;
+    }
+    while (count--)
+    {
+        *dst++ = table[phase >> shift];
+        phase += step;
+    }
+
+    dds->phase = phase;
+}
+
+/* Level (and the DAC correction) is applied per sample, so an amplitude
+ * change never touches the table. Scalar form, kept as the reference */
+DDS_INLINE void fill_scaled_ref(DDS_t *dds, uint16_t low, uint16_t high, const uint16_t *cal,
+                                uint16_t *dst, uint32_t count)
+{
+    const uint16_t *table = dds->table;
+    const uint32_t shift = dds->table_shift;
+    const uint32_t step = dds->tuning_word;
+    const uint32_t span = (uint32_t)(high - low);
+    uint32_t phase = dds->phase;
+
+    while (count >= 4U)
+    {
+        dst[0] = DDS_Cal(cal, low + ((table[phase >> shift] * span + 0x8000U) >> 16)); phase += step;
+        dst[1] = DDS_Cal(cal, low + ((table[phase >> shift] * span + 0x8000U) >> 16)); phase += step;
+        dst[2] = DDS_Cal(cal, low + ((table[phase >> shift] * span + 0x8000U) >> 16)); phase += step;
+        dst[3] = DDS_Cal(cal, low + ((table[phase >> shift] * span + 0x8000U) >> 16)); phase += step;
+        dst += 4;
+        count -= 4U;
+    }
+    while (count--)
+    {
+        *dst++ = DDS_Cal(cal, low + ((table[phase >> shift] * span + 0x8000U) >> 16));
+        phase += step;
+    }
+
+    dds->phase = phase;
+}
+
+/* Packed form. Two gathered entries go into one word and flip to signed
+ * (u ^ 0x8000 = u - 32768), then __SMLAD / __SMLADX against (span, 0)
+ * give one product per lane. The accumulator holds low << 16, the
+ * 32768 * span taken out by the flip and the rounding, so acc >> 16 is
+ * the scalar code exactly; without cal both codes leave in one store.
+ * span must fit a signed lane (< 0x8000) */
+DDS_INLINE void fill_scaled(DDS_t *dds, uint16_t low, uint16_t high, const uint16_t *cal,
+                            uint16_t *dst, uint32_t count)
+{
+    const uint16_t *table = dds->table;
+    const uint32_t shift = dds->table_shift;
+    const uint32_t step = dds->tuning_word;
+    const uint32_t span = (uint32_t)(high - low);
+    const uint32_t acc = ((uint32_t)low << 16) + (span << 15) + 0x8000U;
+    uint32_t phase = dds->phase;
+
+    while (count >= 2U)
+    {
+        uint32_t x, y0, y1;
+
+        x = table[phase >> shift]; phase += step;
+        x = __PKHBT(x, table[phase >> shift], 16) ^ 0x80008000U; phase += step;
+        y0 = __SMLAD(x, span, acc);
+        y1 = __SMLADX(x, span, acc);
+        if (cal)
+        {
+            dst[0] = cal[(uint16_t)(y0 >> 16)];
+            dst[1] = cal[(uint16_t)(y1 >> 16)];
+        }
+        else
+        {
+            store2(dst, __PKHTB(y1, y0, 16));
+        }
+        dst += 2;
+        count -= 2U;
+    }
+    if (count)
+    {
+        *dst = DDS_Cal(cal, (uint16_t)(__SMLAD(table[phase >> shift] ^ 0x8000U, span, acc) >> 16));
+        phase += step;
+    }
+
+    dds->phase = phase;
+}
+
+void DDS_FillScaled(DDS_t *dds, uint16_t low, uint16_t high, uint16_t *dst, uint32_t count)
+{
+    if ((uint32_t)(high - low) > 0x7FFFU)
+        DDS_FillScaled_Ref(dds, low, high, dst, count);
+    else if (dds->cal)
+        fill_scaled(dds, low, high, dds->cal, dst, count);
+    else
+        fill_scaled(dds, low, high, NULL, dst, count);
+}
+
+void DDS_FillScaled_Ref(DDS_t *dds, uint16_t low, uint16_t high, uint16_t *dst, uint32_t count)
+{
+    if (dds->cal)
+        fill_scaled_ref(dds, low, high, dds->cal, dst, count);
+    else
+        fill_scaled_ref(dds, low, high, NULL, dst, count);
+}
@@ -0,0 +1,61 @@
+/*
+ * dds.h
+ *
+ *  Direct digital synthesis core: 32-bit phase accumulator that walks a
+ *  power-of-two master table and writes DAC samples block by block.
+ *
+ *  No HAL dependency, so the same source builds on the host (Tests/).
+ */
+#ifndef DDS_H
+#define DDS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct {
+    uint32_t phase;           /* 2^32 = one period of the master table */
+    uint32_t tuning_word;     /* phase increment per DAC sample        */
+    const uint16_t *table;    /* one period, 1 << table_bits entries   */
+    uint32_t table_shift;     /* 32 - table_bits                       */
+    uint32_t sample_rate_hz;  /* DAC update rate (TIM7 TRGO)           */
+    const uint16_t *cal;      /* DAC code correction, 4096 entries, or NULL */
+} DDS_t;
+
+/* Shaped kernels store every code through this. They test cal once per
+ * block and inline both paths, so NULL costs nothing in the sample loop */
+static inline uint16_t DDS_Cal(const uint16_t *cal, uint32_t code)
+{
+    return cal ? cal[code] : (uint16_t)code;
+}
+
+#if defined(__GNUC__)
+#define DDS_INLINE  static inline __attribute__((always_inline))
+#else
+#define DDS_INLINE  static inline
+#endif
+
+void     DDS_Init(DDS_t *dds, const uint16_t *table, uint32_t table_bits, uint32_t sample_rate_hz);
+void     DDS_SetTable(DDS_t *dds, const uint16_t *table, uint32_t table_bits);
+
+uint32_t DDS_TuningWord_mHz(uint32_t sample_rate_hz, uint32_t freq_mhz);
+void     DDS_SetFrequency_mHz(DDS_t *dds, uint32_t freq_mhz);
+uint32_t DDS_GetFrequency_mHz(const DDS_t *dds);
+
+/* Raw table copy, no correction (the table already holds DAC codes) */
+void     DDS_Fill(DDS_t *dds, uint16_t *dst, uint32_t count);
+
+/* Table holds a normalized period in offset binary (0x8000 = mid-scale);
+ * dst = cal[low + ((u * (high - low) + 0x8000) >> 16)] */
+void     DDS_FillScaled(DDS_t *dds, uint16_t low, uint16_t high, uint16_t *dst, uint32_t count);
+/* Scalar loop DDS_FillScaled must match bit for bit (tests, bench) */
+void     DDS_FillScaled_Ref(DDS_t *dds, uint16_t low, uint16_t high, uint16_t *dst, uint32_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DDS_H */
@@ -0,0 +1,99 @@
+/*
+ * dither.c
+ *
+ *  x = (low << 8) + (table * span) >> 8 is the wanted level in Q8 codes.
+ *  Per sample:
+ *
+ *    w = x - (2 e1 - e2)           error feedback (shaped mode only)
+ *    q = (w + tpdf + 128) >> 8     tpdf = sum of two 8-bit uniforms - 255
+ *    e = (q << 8) - w
+ *
+ *  One xorshift32 step gives both uniforms. At the rails q is clamped
+ *  and e with it, so the loop cannot wind up on a clipped signal.
+ */
+#include "dither.h"
+
+#define DITHER_CODE_MAX     4095
+#define DITHER_ERR_MAX      (2 << 8)    /* |e| <= 2 LSB */
+
+static inline uint32_t xorshift32(uint32_t *s)
+{
+    uint32_t x = *s;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *s = x;
+    return x;
+}
+
+void Dither_Init(Dither_t *d, uint32_t seed)
+{
+    d->rng = seed ? seed : 0x9E3779B9U;
+    d->e1 = 0;
+    d->e2 = 0;
+    d->mode = DITHER_OFF;
+}
+
+void Dither_SetMode(Dither_t *d, DitherMode_t mode)
+{
+    d->mode = mode;
+    d->e1 = 0;
+    d->e2 = 0;
+}
+
+DDS_INLINE void fill(Dither_t *d, DDS_t *dds, uint16_t low, uint16_t high, int shaped,
+                     const uint16_t *cal, uint16_t *dst, uint32_t count)
+{
+    const uint16_t *table = dds->table;
+    const uint32_t shift = dds->table_shift;
+    const uint32_t step = dds->tuning_word;
+    const uint32_t span = (uint32_t)(high - low);
+    const int32_t base = (int32_t)low << 8;
+    uint32_t phase = dds->phase;
+    uint32_t rng = d->rng;
+    int32_t e1 = d->e1, e2 = d->e2;
+
+    while (count--)
+    {
+        int32_t w = base + (int32_t)((table[phase >> shift] * span) >> 8);
+        uint32_t r = xorshift32(&rng);
+        int32_t q, e;
+
+        if (shaped)
+            w -= 2 * e1 - e2;
+        q = (w + (int32_t)(r & 0xFFU) + (int32_t)((r >> 8) & 0xFFU) - 255 + 128) >> 8;
+        if (q < 0) q = 0;
+        if (q > DITHER_CODE_MAX) q = DITHER_CODE_MAX;
+
+        e = (q << 8) - w;
+        if (e > DITHER_ERR_MAX) e = DITHER_ERR_MAX;
+        if (e < -DITHER_ERR_MAX) e = -DITHER_ERR_MAX;
+        e2 = e1;
+        e1 = e;
+
+        *dst++ = DDS_Cal(cal, (uint32_t)q);
+        phase += step;
+    }
+
+    dds->phase = phase;
+    d->rng = rng;
+    d->e1 = e1;
+    d->e2 = e2;
+}
+
+void Dither_FillScaled(Dither_t *d, DDS_t *dds, uint16_t low, uint16_t high, uint16_t *dst, uint32_t count)
+{
+    if (d->mode == DITHER_OFF)
+        DDS_FillScaled(dds, low, high, dst, count);
+    else if (d->mode == DITHER_TPDF)
+    {
+        if (dds->cal) fill(d, dds, low, high, 0, dds->cal, dst, count);
+        else          fill(d, dds, low, high, 0, NULL, dst, count);
+    }
+    else
+    {
+        if (dds->cal) fill(d, dds, low, high, 1, dds->cal, dst, count);
+        else          fill(d, dds, low, high, 1, NULL, dst, count);
+    }
+}
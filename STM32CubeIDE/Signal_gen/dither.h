@@ -0,0 +1,50 @@
+/*
+ * dither.h
+ *
+ *  Optional output stage for the table path (sine, harmonic): the scaled
+ *  sample is kept with 8 fractional bits instead of being rounded to a
+ *  12-bit code, and the quantizer in front of the DAC adds
+ *
+ *    DITHER_TPDF    triangular dither, +/-1 LSB: no staircase, the error
+ *                   becomes signal-independent white noise
+ *    DITHER_SHAPED  TPDF plus 2nd-order error feedback, NTF = (1 - z^-1)^2:
+ *                   the noise is pushed towards fs/2 (500 kHz at 1 MS/s);
+ *                   below 16 kHz it sits ~40 dB under plain rounding,
+ *                   at the price of a +-4 LSB wideband spread
+ *
+ *  Fixed point only, fused into the table read, so it replaces
+ *  DDS_FillScaled rather than adding a pass. The DAC correction
+ *  (dds->cal) is applied to the quantized code as usual.
+ */
+#ifndef DITHER_H
+#define DITHER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include "dds.h"
+
+typedef enum {
+    DITHER_OFF = 0,
+    DITHER_TPDF,
+    DITHER_SHAPED
+} DitherMode_t;
+
+typedef struct {
+    uint32_t rng;           /* xorshift32, never 0                  */
+    int32_t e1, e2;         /* last two quantizer errors, Q8 LSB    */
+    DitherMode_t mode;
+} Dither_t;
+
+void Dither_Init(Dither_t *d, uint32_t seed);
+void Dither_SetMode(Dither_t *d, DitherMode_t mode);
+
+void Dither_FillScaled(Dither_t *d, DDS_t *dds, uint16_t low, uint16_t high, uint16_t *dst, uint32_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DITHER_H */
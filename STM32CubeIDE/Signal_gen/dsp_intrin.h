@@ -0,0 +1,74 @@
+/*
+ * dsp_intrin.h
+ *
+ *  Cortex-M7 DSP instructions used by the packed kernels. On the target
+ *  they come from CMSIS; on the host (Tests/) plain-C models with the
+ *  same wrap/saturation rules stand in, so the packed loops are checked
+ *  bit for bit against their scalar references.
+ */
+#ifndef DSP_INTRIN_H
+#define DSP_INTRIN_H
+
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1)
+#include "cmsis_compiler.h"
+#else
+static inline int32_t dsp_lane(uint32_t x, uint32_t shift)
+{
+    return (int16_t)(uint16_t)(x >> shift);
+}
+
+static inline int32_t dsp_sat(int32_t v, int32_t lo, int32_t hi)
+{
+    return (v < lo) ? lo : (v > hi) ? hi : v;
+}
+
+static inline uint32_t __SMLAD(uint32_t x, uint32_t y, uint32_t acc)
+{
+    return (uint32_t)(dsp_lane(x, 0) * dsp_lane(y, 0)) + (uint32_t)(dsp_lane(x, 16) * dsp_lane(y, 16)) + acc;
+}
+
+static inline uint32_t __SMLADX(uint32_t x, uint32_t y, uint32_t acc)
+{
+    return (uint32_t)(dsp_lane(x, 0) * dsp_lane(y, 16)) + (uint32_t)(dsp_lane(x, 16) * dsp_lane(y, 0)) + acc;
+}
+
+static inline uint32_t __QADD16(uint32_t x, uint32_t y)
+{
+    uint32_t lo = (uint16_t)dsp_sat(dsp_lane(x, 0) + dsp_lane(y, 0), -32768, 32767);
+    uint32_t hi = (uint16_t)dsp_sat(dsp_lane(x, 16) + dsp_lane(y, 16), -32768, 32767);
+    return lo | (hi << 16);
+}
+
+static inline uint32_t __USAT16(uint32_t x, uint32_t bits)
+{
+    int32_t max = (int32_t)(1U << bits) - 1;
+    return (uint32_t)dsp_sat(dsp_lane(x, 0), 0, max) | ((uint32_t)dsp_sat(dsp_lane(x, 16), 0, max) << 16);
+}
+
+static inline int32_t __SSAT(int32_t v, uint32_t bits)
+{
+    int32_t max = (int32_t)(1U << (bits - 1U)) - 1;
+    return dsp_sat(v, -max - 1, max);
+}
+
+#define __PKHBT(a, b, s)    ((((uint32_t)(a)) & 0x0000FFFFUL) | ((((uint32_t)(b)) << (s)) & 0xFFFF0000UL))
+#define __PKHTB(a, b, s)    ((((uint32_t)(a)) & 0xFFFF0000UL) | ((((uint32_t)(b)) >> (s)) & 0x0000FFFFUL))
+#endif
+
+/* Two halfwords per word; dst/src need not be word aligned */
+static inline uint32_t load2(const void *p)
+{
+    uint32_t w;
+    memcpy(&w, p, sizeof(w));
+    return w;
+}
+
+static inline void store2(void *p, uint32_t w)
+{
+    memcpy(p, &w, sizeof(w));
+}
+
+#endif /* DSP_INTRIN_H */
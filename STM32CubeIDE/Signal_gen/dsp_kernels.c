@@ -0,0 +1,132 @@
+/*
+ * dsp_kernels.c
+ *
+ *  Packed kernels load and store two samples per word. Per-lane gain is
+ *  __SMLAD (bottom lane) and __SMLADX (top lane) against (gain, 0), with
+ *  the rounding constant in the accumulator. Interpolation and mixing are
+ *  one __SMLAD each: (a, b) . (wa, wb) + acc.
+ *
+ *  Odd counts finish with one scalar step of the reference code.
+ */
+#include "dsp_kernels.h"
+#include "dsp_intrin.h"
+
+#define ROUND_Q15   0x4000
+
+static inline int32_t clamp(int32_t v, int32_t lo, int32_t hi)
+{
+    return (v < lo) ? lo : (v > hi) ? hi : v;
+}
+
+/* ========== Gain / offset ========== */
+
+void Dsp_GainOffset_Ref(const int16_t *src, int16_t gain_q15, int16_t offset, uint16_t *dst, uint32_t count)
+{
+    for (uint32_t i = 0; i < count; i++)
+    {
+        int16_t v = (int16_t)((src[i] * gain_q15 + ROUND_Q15) >> 15);
+        dst[i] = (uint16_t)clamp(clamp(v + offset, -32768, 32767), 0, 4095);
+    }
+}
+
+void Dsp_GainOffset(const int16_t *src, int16_t gain_q15, int16_t offset, uint16_t *dst, uint32_t count)
+{
+    const uint32_t g = (uint16_t)gain_q15;
+    const uint32_t off = __PKHBT(offset, offset, 16);
+
+    for (; count >= 2U; count -= 2U, src += 2, dst += 2)
+    {
+        uint32_t x = load2(src);
+        int32_t p0 = (int32_t)__SMLAD(x, g, ROUND_Q15) >> 15;
+        int32_t p1 = (int32_t)__SMLADX(x, g, ROUND_Q15) >> 15;
+
+        store2(dst, __USAT16(__QADD16(__PKHBT(p0, p1, 16), off), 12));
+    }
+    if (count)
+        Dsp_GainOffset_Ref(src, gain_q15, offset, dst, 1);
+}
+
+/* ========== 12-bit saturation ========== */
+
+void Dsp_Saturate12_Ref(const int16_t *src, uint16_t *dst, uint32_t count)
+{
+    for (uint32_t i = 0; i < count; i++)
+        dst[i] = (uint16_t)clamp(src[i], 0, 4095);
+}
+
+void Dsp_Saturate12(const int16_t *src, uint16_t *dst, uint32_t count)
+{
+    for (; count >= 2U; count -= 2U, src += 2, dst += 2)
+        store2(dst, __USAT16(load2(src), 12));
+    if (count)
+        Dsp_Saturate12_Ref(src, dst, 1);
+}
+
+/* ========== Interpolated table lookup ========== */
+
+void Dsp_InterpFill_Ref(const int16_t *table, uint32_t table_bits, uint32_t *phase, uint32_t step,
+                        int16_t *dst, uint32_t count)
+{
+    const uint32_t shift = 32U - table_bits;
+    const uint32_t mask = (1U << table_bits) - 1U;
+    uint32_t ph = *phase;
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        uint32_t idx = ph >> shift;
+        int32_t frac = (int32_t)((ph >> (shift - 15U)) & 0x7FFFU);
+        int32_t a = table[idx], b = table[(idx + 1U) & mask];
+
+        dst[i] = (int16_t)((a * 32768 + (b - a) * frac + ROUND_Q15) >> 15);
+        ph += step;
+    }
+    *phase = ph;
+}
+
+void Dsp_InterpFill(const int16_t *table, uint32_t table_bits, uint32_t *phase, uint32_t step,
+                    int16_t *dst, uint32_t count)
+{
+    const uint32_t shift = 32U - table_bits;
+    const uint32_t mask = (1U << table_bits) - 1U;
+    uint32_t ph = *phase;
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        uint32_t idx = ph >> shift;
+        int32_t frac = (int32_t)((ph >> (shift - 15U)) & 0x7FFFU);
+        int32_t a = table[idx];
+        uint32_t ab = __PKHBT(a, table[(idx + 1U) & mask], 16);
+
+        /* a * (32768 - frac) + b * frac, the 32768 * a part in the accumulator */
+        dst[i] = (int16_t)((int32_t)__SMLAD(ab, __PKHBT(-frac, frac, 16),
+                                            (uint32_t)(a * 32768 + ROUND_Q15)) >> 15);
+        ph += step;
+    }
+    *phase = ph;
+}
+
+/* ========== Two-source mix ========== */
+
+void Dsp_Mix2_Ref(const int16_t *a, int16_t gain_a, const int16_t *b, int16_t gain_b,
+                  int16_t *dst, uint32_t count)
+{
+    for (uint32_t i = 0; i < count; i++)
+        dst[i] = (int16_t)clamp((a[i] * gain_a + b[i] * gain_b + ROUND_Q15) >> 15, -32768, 32767);
+}
+
+void Dsp_Mix2(const int16_t *a, int16_t gain_a, const int16_t *b, int16_t gain_b,
+              int16_t *dst, uint32_t count)
+{
+    const uint32_t g = __PKHBT(gain_a, gain_b, 16);
+
+    for (; count >= 2U; count -= 2U, a += 2, b += 2, dst += 2)
+    {
+        uint32_t wa = load2(a), wb = load2(b);
+        int32_t y0 = (int32_t)__SMLAD(__PKHBT(wa, wb, 16), g, ROUND_Q15) >> 15;
+        int32_t y1 = (int32_t)__SMLAD(__PKHTB(wb, wa, 16), g, ROUND_Q15) >> 15;
+
+        store2(dst, __PKHBT(__SSAT(y0, 16), __SSAT(y1, 16), 16));
+    }
+    if (count)
+        Dsp_Mix2_Ref(a, gain_a, b, gain_b, dst, 1);
+}
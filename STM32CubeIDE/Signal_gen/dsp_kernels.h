@@ -0,0 +1,50 @@
+/*
+ * dsp_kernels.h
+ *
+ *  Sample-loop kernels on Q15 data: gain/offset, 12-bit saturation,
+ *  interpolated table lookup and two-source mixing.
+ *
+ *  On a core with the DSP extension (__ARM_FEATURE_DSP, Cortex-M7) the
+ *  Dsp_* kernels work on packed halfword pairs with __SMLAD/__SMLADX,
+ *  __QADD16, __USAT16 and __SSAT. Elsewhere the same code builds against
+ *  plain-C models of those instructions, so Tests/ can check it on the
+ *  host. Dsp_*_Ref are straightforward scalar versions with the same
+ *  rounding; both must agree bit for bit.
+ *
+ *  Gains are Q15 in [-32767, 32767]; -32768 is not supported.
+ */
+#ifndef DSP_KERNELS_H
+#define DSP_KERNELS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/* dst = usat12(sat16(round(src * gain >> 15) + offset)) */
+void Dsp_GainOffset(const int16_t *src, int16_t gain_q15, int16_t offset, uint16_t *dst, uint32_t count);
+void Dsp_GainOffset_Ref(const int16_t *src, int16_t gain_q15, int16_t offset, uint16_t *dst, uint32_t count);
+
+/* dst = clamp(src, 0, 4095) */
+void Dsp_Saturate12(const int16_t *src, uint16_t *dst, uint32_t count);
+void Dsp_Saturate12_Ref(const int16_t *src, uint16_t *dst, uint32_t count);
+
+/* Linear interpolation between table[i] and table[i + 1] (wrapping),
+ * 15-bit fraction from the phase bits below the index. *phase advances */
+void Dsp_InterpFill(const int16_t *table, uint32_t table_bits, uint32_t *phase, uint32_t step,
+                    int16_t *dst, uint32_t count);
+void Dsp_InterpFill_Ref(const int16_t *table, uint32_t table_bits, uint32_t *phase, uint32_t step,
+                        int16_t *dst, uint32_t count);
+
+/* dst = sat16(round((a * gain_a + b * gain_b) >> 15)) */
+void Dsp_Mix2(const int16_t *a, int16_t gain_a, const int16_t *b, int16_t gain_b,
+              int16_t *dst, uint32_t count);
+void Dsp_Mix2_Ref(const int16_t *a, int16_t gain_a, const int16_t *b, int16_t gain_b,
+                  int16_t *dst, uint32_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DSP_KERNELS_H */
@@ -0,0 +1,41 @@
+/*
+ * dual_dac.c
+ *
+ *  Both channels are rendered with the regular single-channel kernels
+ *  into small stack chunks and interleaved, so every waveform works in
+ *  dual mode without a second set of kernels.
+ */
+#include "dual_dac.h"
+
+#define DUAL_DAC_CHUNK  64U
+
+uint32_t DualDac_PhaseFromDegrees(uint32_t degrees)
+{
+    return (uint32_t)(((uint64_t)(degrees % 360U) << 32) / 360U);
+}
+
+void DualDac_Fill(DDS_t *dds, const WaveParams_t *p, uint32_t offset, uint32_t mult,
+                  uint32_t *dst, uint32_t count)
+{
+    uint16_t ch1[DUAL_DAC_CHUNK];
+    uint16_t ch2[DUAL_DAC_CHUNK];
+    DDS_t slave = *dds;
+
+    if (mult == 0U) mult = 1U;
+    slave.tuning_word = dds->tuning_word * mult;
+
+    while (count)
+    {
+        uint32_t n = (count < DUAL_DAC_CHUNK) ? count : DUAL_DAC_CHUNK;
+
+        slave.phase = dds->phase * mult + offset;
+        Waveform_Fill(dds, p, ch1, n);
+        Waveform_Fill(&slave, p, ch2, n);
+
+        for (uint32_t i = 0; i < n; i++)
+            dst[i] = DualDac_Pack(ch1[i], ch2[i]);
+
+        dst += n;
+        count -= n;
+    }
+}
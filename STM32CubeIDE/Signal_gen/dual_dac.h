@@ -0,0 +1,41 @@
+/*
+ * dual_dac.h
+ *
+ *  Dual-channel rendering for the DAC dual data register (DHR12RD):
+ *  one 32-bit word per sample, channel 1 in bits 11:0, channel 2 in
+ *  bits 27:16. A single DMA stream moves both channels and TIM7 TRGO
+ *  latches them together, so the two outputs can never drift apart.
+ *
+ *  Channel 2 is slaved to the channel 1 accumulator:
+ *    phase2 = phase1 * mult + offset
+ *  which is exact modulo 2^32, so the relation holds for ever - mult 1
+ *  with offset 1/4 gives I/Q, mult 2..n gives locked Lissajous figures.
+ */
+#ifndef DUAL_DAC_H
+#define DUAL_DAC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include "dds.h"
+#include "waveform.h"
+
+#define DUAL_DAC_PHASE_90   0x40000000U
+
+static inline uint32_t DualDac_Pack(uint16_t ch1, uint16_t ch2)
+{
+    return (uint32_t)ch1 | ((uint32_t)ch2 << 16);
+}
+
+uint32_t DualDac_PhaseFromDegrees(uint32_t degrees);
+
+void DualDac_Fill(DDS_t *dds, const WaveParams_t *p, uint32_t offset, uint32_t mult,
+                  uint32_t *dst, uint32_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DUAL_DAC_H */
@@ -0,0 +1,141 @@
+/*
+ * freq_plan.c
+ *
+ *  Cost per candidate K is one modulo per N tried (largest N first), so
+ *  a typical plan - exact K on the first try - is a few hundred integer
+ *  divisions. Timer dividers above 65536 are split into PSC and ARR by
+ *  a short bounded divisor walk. The K walk is bounded by the error
+ *  tolerance, i.e. about 2 * K * ppm / 1e6 candidates at most.
+ */
+#include "freq_plan.h"
+
+#define TIM_MAX     65536U      /* PSC+1 and ARR+1 are 16-bit */
+#define SPLIT_TRIES 64U
+
+/* D = (psc+1)(arr+1), both factors <= 65536 */
+static int split_divider(uint32_t d, uint32_t *psc, uint32_t *arr)
+{
+    uint32_t p;
+
+    if (d <= TIM_MAX)
+    {
+        *psc = 0;
+        *arr = d - 1U;
+        return 1;
+    }
+
+    p = (d - 1U) / TIM_MAX + 1U;    /* smallest p with d / p <= 65536 */
+    for (uint32_t i = 0; i < SPLIT_TRIES && p <= TIM_MAX; i++, p++)
+    {
+        if (d % p == 0U)
+        {
+            *psc = p - 1U;
+            *arr = d / p - 1U;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static int factor(const FreqPlanLimits_t *lim, uint64_t k64, FreqPlan_t *plan)
+{
+    uint32_t k, n;
+
+    /* 32-bit K keeps the inner loop on the hardware divider (f >= 26 mHz) */
+    if (k64 > 0xFFFFFFFFU)
+        return 0;
+    k = (uint32_t)k64;
+    n = k / lim->min_divider;
+    if (n > lim->n_max) n = lim->n_max;
+
+    for (; n >= lim->n_min && n > 0U; n--)
+    {
+        if (k % n != 0U)
+            continue;
+        if (split_divider(k / n, &plan->psc, &plan->arr))
+        {
+            plan->n = n;
+            plan->k = k;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static inline uint64_t distance(uint64_t a, uint64_t b)
+{
+    return (a > b) ? a - b : b - a;
+}
+
+int FreqPlan_Search(const FreqPlanLimits_t *lim, uint32_t freq_mhz, FreqPlan_t *plan)
+{
+    uint64_t k_u, k0, max_dev_u;
+
+    if (freq_mhz == 0U)
+        return 0;
+
+    /* Ideal K in millionths (freq in mHz), then the nearest integer */
+    k_u = (uint64_t)lim->timer_clk_hz * 1000000000U / freq_mhz;
+    k0 = (k_u + 500000U) / 1000000U;
+    if (k0 < (uint64_t)lim->min_divider * lim->n_min)
+        return 0;
+    max_dev_u = k_u / 1000000U * lim->max_error_ppm
+              + (k_u % 1000000U) * lim->max_error_ppm / 1000000U;
+
+    /* Walk outwards from the nearest K; both sides, nearer first */
+    for (uint64_t step = 0; step < k0; step++)
+    {
+        uint64_t up = k0 + step, down = k0 - step;
+        uint64_t up_dev = distance(up * 1000000U, k_u);
+        uint64_t down_dev = distance(down * 1000000U, k_u);
+        int up_ok, down_ok;
+
+        up_ok = (up_dev <= max_dev_u);
+        down_ok = (step != 0U) && (down_dev <= max_dev_u);
+
+        if (!up_ok && !down_ok)
+            break;
+        if (up_ok && (!down_ok || up_dev <= down_dev))
+        {
+            if (factor(lim, up, plan)) return 1;
+            if (down_ok && factor(lim, down, plan)) return 1;
+        }
+        else
+        {
+            if (factor(lim, down, plan)) return 1;
+            if (up_ok && factor(lim, up, plan)) return 1;
+        }
+    }
+    return 0;
+}
+
+uint32_t FreqPlan_Frequency_mHz(const FreqPlanLimits_t *lim, const FreqPlan_t *plan)
+{
+    return (uint32_t)(((uint64_t)lim->timer_clk_hz * 1000U + plan->k / 2U) / plan->k);
+}
+
+uint32_t FreqPlan_SampleRate_Hz(const FreqPlanLimits_t *lim, const FreqPlan_t *plan)
+{
+    return (uint32_t)(lim->timer_clk_hz / ((uint64_t)(plan->psc + 1U) * (plan->arr + 1U)));
+}
+
+void FreqPlan_FillPeriod(const uint16_t *table, uint32_t n, uint32_t *index,
+                         uint16_t *dst, uint32_t count)
+{
+    uint32_t i = *index;
+
+    while (count)
+    {
+        uint32_t run = n - i;
+        if (run > count) run = count;
+
+        for (uint32_t j = 0; j < run; j++)
+            dst[j] = table[i + j];
+
+        dst += run;
+        count -= run;
+        i += run;
+        if (i == n) i = 0;
+    }
+    *index = i;
+}
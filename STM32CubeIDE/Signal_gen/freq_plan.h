@@ -0,0 +1,56 @@
+/*
+ * freq_plan.h
+ *
+ *  Exact-period frequency planner. The output frequency of an N-sample
+ *  period table clocked by TIM7 is
+ *
+ *      f = timer_clk / ((PSC + 1) * (ARR + 1) * N) = timer_clk / K
+ *
+ *  so the error depends only on the integer K. The planner rounds
+ *  timer_clk / f to K, then walks K outwards (K, K+1, K-1, ...) until
+ *  K factors into a legal (PSC, ARR, N): update rate no faster than the
+ *  DAC limit, N inside the RAM budget, largest N preferred. The walk
+ *  gives up once K is further than max_error_ppm from the ideal; the
+ *  caller then stays on the DDS. A plan repeats exactly every N
+ *  samples - no DDS phase-truncation spurs.
+ *
+ *  No HAL dependency; the caller programs TIM7 and the table.
+ */
+#ifndef FREQ_PLAN_H
+#define FREQ_PLAN_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+typedef struct {
+    uint32_t timer_clk_hz;  /* TIM7 kernel clock (108 MHz)            */
+    uint32_t min_divider;   /* (PSC+1)(ARR+1) floor = DAC rate limit  */
+    uint32_t n_min;         /* shortest period table                  */
+    uint32_t n_max;         /* longest period table (RAM)             */
+    uint32_t max_error_ppm; /* how far K may move from the ideal      */
+} FreqPlanLimits_t;
+
+typedef struct {
+    uint32_t psc;
+    uint32_t arr;
+    uint32_t n;             /* samples per period                     */
+    uint32_t k;             /* (psc+1) * (arr+1) * n                  */
+} FreqPlan_t;
+
+int FreqPlan_Search(const FreqPlanLimits_t *lim, uint32_t freq_mhz, FreqPlan_t *plan);
+
+uint32_t FreqPlan_Frequency_mHz(const FreqPlanLimits_t *lim, const FreqPlan_t *plan);
+uint32_t FreqPlan_SampleRate_Hz(const FreqPlanLimits_t *lim, const FreqPlan_t *plan);
+
+/* Cyclic copy of an N-sample period table, *index carries across blocks */
+void FreqPlan_FillPeriod(const uint16_t *table, uint32_t n, uint32_t *index,
+                         uint16_t *dst, uint32_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FREQ_PLAN_H */
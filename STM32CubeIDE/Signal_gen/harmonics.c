@@ -0,0 +1,81 @@
+/*
+ * harmonics.c
+ *
+ *  Harmonic k advances k << (32 - bits) per sample, so it completes
+ *  exactly k cycles per table. Products are taken >> 5 before summing,
+ *  which leaves room for 32 full-scale harmonics in an int32.
+ */
+#include "harmonics.h"
+#include "dsp_kernels.h"
+
+#define CHUNK           64U
+#define HEADROOM_SHIFT  5U      /* log2(HARMONICS_MAX) */
+
+void Harmonics_Clear(Harmonics_t *h)
+{
+    h->count = 0;
+    for (uint32_t k = 0; k < HARMONICS_MAX; k++)
+    {
+        h->amp_q15[k] = 0;
+        h->phase[k] = 0;
+    }
+}
+
+void Harmonics_Set(Harmonics_t *h, uint32_t k, int16_t amp_q15, uint32_t phase)
+{
+    if (k == 0U || k > HARMONICS_MAX)
+        return;
+
+    h->amp_q15[k - 1U] = amp_q15;
+    h->phase[k - 1U] = phase;
+    if (k > h->count)
+        h->count = k;
+}
+
+int32_t Harmonics_Build(const Harmonics_t *h, const int16_t *sine_q15, uint32_t sine_bits,
+                        int32_t *work, int16_t *dst, uint32_t bits)
+{
+    const uint32_t n = 1U << bits;
+    int16_t osc[CHUNK];
+    int32_t peak = 0;
+    int64_t recip;
+
+    for (uint32_t i = 0; i < n; i++)
+        work[i] = 0;
+
+    for (uint32_t k = 1; k <= h->count && k < n / 2U; k++)
+    {
+        const int32_t amp = h->amp_q15[k - 1U];
+        uint32_t phase = h->phase[k - 1U];
+
+        if (amp == 0)
+            continue;
+
+        for (uint32_t i = 0; i < n; i += CHUNK)
+        {
+            uint32_t len = (n - i < CHUNK) ? n - i : CHUNK;
+
+            Dsp_InterpFill(sine_q15, sine_bits, &phase, k << (32U - bits), osc, len);
+            for (uint32_t j = 0; j < len; j++)
+                work[i + j] += (osc[j] * amp) >> HEADROOM_SHIFT;
+        }
+    }
+
+    for (uint32_t i = 0; i < n; i++)
+    {
+        int32_t a = (work[i] < 0) ? -work[i] : work[i];
+        if (a > peak) peak = a;
+    }
+
+    /* Largest excursion to +-32767, zero stays at mid-scale */
+    if (peak == 0)
+    {
+        for (uint32_t i = 0; i < n; i++)
+            dst[i] = 0;
+        return 0;
+    }
+    recip = ((int64_t)32767 << 31) / peak;
+    for (uint32_t i = 0; i < n; i++)
+        dst[i] = (int16_t)((work[i] * recip + (1LL << 30)) >> 31);
+    return peak;
+}
@@ -0,0 +1,43 @@
+/*
+ * harmonics.h
+ *
+ *  Additive synthesis: one period built from up to HARMONICS_MAX sine
+ *  harmonics, each with its own amplitude and phase, then normalized so
+ *  the largest excursion is Q15 full scale. The result is an ordinary
+ *  master table, so it plays through the same DDS/DMA path as the sine.
+ *
+ *  Each harmonic is an oscillator reading the Q15 sine table with its own
+ *  phase accumulator (Dsp_InterpFill) - N x K table reads and MACs, no
+ *  trig calls.
+ */
+#ifndef HARMONICS_H
+#define HARMONICS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+#define HARMONICS_MAX   32U
+
+typedef struct {
+    uint32_t count;                     /* harmonics 1..count are used      */
+    int16_t amp_q15[HARMONICS_MAX];     /* [k-1]: relative amplitude, signed */
+    uint32_t phase[HARMONICS_MAX];      /* [k-1]: sine phase, 2^32 = 360 deg */
+} Harmonics_t;
+
+void Harmonics_Clear(Harmonics_t *h);
+void Harmonics_Set(Harmonics_t *h, uint32_t k, int16_t amp_q15, uint32_t phase);
+
+/* Renders 2^bits samples into dst (Q15, peak = +-32767). work holds 2^bits
+ * accumulators. Harmonics at or above table Nyquist are skipped.
+ * Returns the raw peak before normalization, 0 if the result is silent */
+int32_t Harmonics_Build(const Harmonics_t *h, const int16_t *sine_q15, uint32_t sine_bits,
+                        int32_t *work, int16_t *dst, uint32_t bits);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HARMONICS_H */
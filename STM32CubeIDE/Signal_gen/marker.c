@@ -0,0 +1,80 @@
+/*
+ * marker.c
+ *
+ *  A block of marks is a block of reset words with the marked samples
+ *  shifted one word later; the shift is what lines the edge up with the
+ *  DAC output (see marker.h).
+ */
+#include "marker.h"
+
+void Marker_Init(Marker_t *m, uint16_t pin)
+{
+    m->set = pin;
+    m->reset = (uint32_t)pin << 16;
+    m->carry = 0;
+}
+
+void Marker_Clear(Marker_t *m, uint32_t *bsrr, uint32_t count)
+{
+    if (count == 0U)
+        return;
+
+    bsrr[0] = m->carry ? m->set : m->reset;
+    for (uint32_t i = 1; i < count; i++)
+        bsrr[i] = m->reset;
+    m->carry = 0;
+}
+
+void Marker_Mark(Marker_t *m, uint32_t *bsrr, uint32_t count, uint32_t offset)
+{
+    if (offset + 1U < count)
+        bsrr[offset + 1U] = m->set;
+    else if (offset < count)
+        m->carry = 1;
+}
+
+void Marker_FillPhase(Marker_t *m, uint32_t phase, uint32_t tuning_word, uint32_t *bsrr, uint32_t count)
+{
+    uint32_t prev = m->carry;
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        bsrr[i] = prev ? m->set : m->reset;
+        prev = (phase < tuning_word);
+        phase += tuning_word;
+    }
+    m->carry = (uint8_t)prev;
+}
+
+void Marker_FillPeriod(Marker_t *m, uint32_t index, uint32_t n, uint32_t *bsrr, uint32_t count)
+{
+    Marker_Clear(m, bsrr, count);
+    for (uint32_t at = (n - index % n) % n; at < count; at += n)
+        Marker_Mark(m, bsrr, count, at);
+}
+
+/* Walks the segment list the way Seq_Fill will, without touching it */
+void Marker_FillSegments(Marker_t *m, const Sequencer_t *seq, uint32_t *bsrr, uint32_t count)
+{
+    uint32_t index = seq->index, at = seq->remaining;
+
+    Marker_Clear(m, bsrr, count);
+    if (!seq->active)
+        return;
+
+    /* A full segment ahead means it starts right here */
+    if (seq->remaining == seq->seg[index].samples)
+        Marker_Mark(m, bsrr, count, 0);
+
+    while (at < count)
+    {
+        if (++index >= seq->count)
+        {
+            if (!seq->loop)
+                return;
+            index = 0;
+        }
+        Marker_Mark(m, bsrr, count, at);
+        at += seq->seg[index].samples;
+    }
+}
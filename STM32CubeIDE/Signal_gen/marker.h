@@ -0,0 +1,57 @@
+/*
+ * marker.h
+ *
+ *  Sync/marker output for the scope: one GPIO BSRR word per DAC sample,
+ *  rendered next to the samples and written to the pin by a second DMA
+ *  stream paced in lockstep with TIM7. The pin is high for one sample at
+ *  phase 0 of every period (the first sample after the phase wraps), or
+ *  at the first sample of every sweep pass or sequence segment. Nothing
+ *  runs on the CPU at output time, so the edge has no software jitter.
+ *
+ *  The DAC takes a DMA word into DHR on one trigger and outputs it on the
+ *  next, while the marker DMA writes BSRR on the update itself; so word i
+ *  carries the mark of sample i - 1, and a mark on the last sample of a
+ *  block is carried into the next one.
+ */
+#ifndef MARKER_H
+#define MARKER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include "sequencer.h"
+
+typedef enum {
+    MARKER_OFF = 0,
+    MARKER_PERIOD,          /* phase 0 of every period                   */
+    MARKER_SEGMENT          /* sweep pass / sequence segment start       */
+} MarkerMode_t;
+
+typedef struct {
+    uint32_t set;           /* BSRR word raising the pin                 */
+    uint32_t reset;         /* and the one lowering it                   */
+    uint8_t carry;          /* last sample of the previous block marked  */
+} Marker_t;
+
+void Marker_Init(Marker_t *m, uint16_t pin);
+
+/* No marks in this block (the carried one still goes out) */
+void Marker_Clear(Marker_t *m, uint32_t *bsrr, uint32_t count);
+/* Mark sample offset of a block prepared with Marker_Clear */
+void Marker_Mark(Marker_t *m, uint32_t *bsrr, uint32_t count, uint32_t offset);
+
+/* DDS: samples whose phase lies in [0, tuning_word) start a period.
+ * phase - accumulator at the first sample of the block */
+void Marker_FillPhase(Marker_t *m, uint32_t phase, uint32_t tuning_word, uint32_t *bsrr, uint32_t count);
+/* Period table of n samples, index - table position of the first sample */
+void Marker_FillPeriod(Marker_t *m, uint32_t index, uint32_t n, uint32_t *bsrr, uint32_t count);
+/* Segment starts of the next count samples; call before Seq_Fill renders them */
+void Marker_FillSegments(Marker_t *m, const Sequencer_t *seq, uint32_t *bsrr, uint32_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MARKER_H */
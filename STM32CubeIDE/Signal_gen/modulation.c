@@ -0,0 +1,147 @@
+/*
+ * modulation.c
+ *
+ *  The carrier reads the same normalized Q15 sine as the modulator, not
+ *  the DAC-scaled bank behind the plain DDS path, because AM has to
+ *  scale it around mid-level before mapping into [low, high].
+ */
+#include "modulation.h"
+
+#define PM_INDEX_MAX_MRAD   6283U   /* 2 pi */
+
+static inline uint16_t to_dac(int32_t v, uint16_t low, uint32_t span)
+{
+    int32_t u = v + 32768;
+
+    if (u < 0) u = 0;
+    if (u > 65535) u = 65535;
+    return (uint16_t)(low + (((uint32_t)u * span + 32768U) >> 16));
+}
+
+void Modulation_Init(Modulation_t *m, const int16_t *sine_q15, uint32_t table_bits, uint32_t sample_rate_hz)
+{
+    m->type = MODULATION_NONE;
+    m->phase = 0;
+    m->tuning_word = 0;
+    m->depth_q15 = 0;
+    m->deviation = 0;
+    m->pm_gain = 0;
+    m->table = sine_q15;
+    m->table_shift = 32U - table_bits;
+    m->sample_rate_hz = sample_rate_hz;
+}
+
+void Modulation_SetRate_mHz(Modulation_t *m, uint32_t rate_mhz)
+{
+    m->tuning_word = DDS_TuningWord_mHz(m->sample_rate_hz, rate_mhz);
+}
+
+void Modulation_SetAM(Modulation_t *m, uint32_t depth_permille)
+{
+    if (depth_permille > 1000U) depth_permille = 1000U;
+    m->depth_q15 = (int32_t)((depth_permille * 32768U + 500U) / 1000U);
+    m->type = MODULATION_AM;
+}
+
+void Modulation_SetFM(Modulation_t *m, uint32_t deviation_mhz)
+{
+    uint32_t dev = DDS_TuningWord_mHz(m->sample_rate_hz, deviation_mhz);
+
+    /* Deviation alone below Nyquist; carrier + deviation is capped in the fill */
+    m->deviation = (dev >= 0x80000000U) ? 0x7FFFFFFF : (int32_t)dev;
+    m->type = MODULATION_FM;
+}
+
+void Modulation_SetPM(Modulation_t *m, uint32_t index_mrad)
+{
+    if (index_mrad > PM_INDEX_MAX_MRAD) index_mrad = PM_INDEX_MAX_MRAD;
+    /* 2^32 / (2 pi) = 683565275.6 phase units per rad */
+    m->pm_gain = (uint32_t)(((uint64_t)index_mrad * 683565276U + 500U) / 1000U);
+    m->type = MODULATION_PM;
+}
+
+void Modulation_Off(Modulation_t *m)
+{
+    m->type = MODULATION_NONE;
+}
+
+DDS_INLINE void fill(Modulation_t *m, DDS_t *carrier, uint16_t low, uint16_t high, const uint16_t *cal,
+                     uint16_t *dst, uint32_t count)
+{
+    const int16_t *table = m->table;
+    const uint32_t shift = m->table_shift;
+    const uint32_t span = (uint32_t)(high - low);
+    const uint32_t step = m->tuning_word;
+    uint32_t mphase = m->phase;
+    uint32_t phase = carrier->phase;
+    uint32_t tuning = carrier->tuning_word;
+
+    switch (m->type)
+    {
+    case MODULATION_AM:
+    {
+        const int32_t depth = m->depth_q15;
+        while (count--)
+        {
+            int32_t mod = table[mphase >> shift];
+            int32_t env = 32768 + ((depth * mod) >> 15);        /* 0 .. 65536, Q15 */
+            int32_t c = table[phase >> shift];
+
+            *dst++ = DDS_Cal(cal, to_dac((c * env) >> 16, low, span));
+            phase += tuning;
+            mphase += step;
+        }
+        break;
+    }
+    case MODULATION_FM:
+    {
+        /* Upper peak stays below Nyquist for the carrier of this block
+         * (it may have been retuned or swept since SetFM) */
+        const uint32_t room = (tuning < 0x80000000U) ? 0x7FFFFFFFU - tuning : 0U;
+        const int64_t dev = ((uint32_t)m->deviation > room) ? (int64_t)room : m->deviation;
+        while (count--)
+        {
+            int32_t mod = table[mphase >> shift];
+
+            *dst++ = DDS_Cal(cal, to_dac(table[phase >> shift], low, span));
+            phase += tuning + (uint32_t)((dev * mod) >> 15);
+            mphase += step;
+        }
+        break;
+    }
+    case MODULATION_PM:
+    {
+        const int64_t gain = m->pm_gain;
+        while (count--)
+        {
+            int32_t mod = table[mphase >> shift];
+            uint32_t p = phase + (uint32_t)((gain * mod) >> 15);
+
+            *dst++ = DDS_Cal(cal, to_dac(table[p >> shift], low, span));
+            phase += tuning;
+            mphase += step;
+        }
+        break;
+    }
+    case MODULATION_NONE:
+    default:
+        while (count--)
+        {
+            *dst++ = DDS_Cal(cal, to_dac(table[phase >> shift], low, span));
+            phase += tuning;
+        }
+        break;
+    }
+
+    m->phase = mphase;
+    carrier->phase = phase;
+}
+
+void Modulation_Fill(Modulation_t *m, DDS_t *carrier, uint16_t low, uint16_t high,
+                     uint16_t *dst, uint32_t count)
+{
+    if (carrier->cal)
+        fill(m, carrier, low, high, carrier->cal, dst, count);
+    else
+        fill(m, carrier, low, high, NULL, dst, count);
+}
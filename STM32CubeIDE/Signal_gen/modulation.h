@@ -0,0 +1,58 @@
+/*
+ * modulation.h
+ *
+ *  AM / FM / PM of a sine carrier by an internal sine modulating
+ *  oscillator. Rendered per DMA half-block in fixed point: the carrier
+ *  is the DDS phase accumulator, the modulator is a second accumulator
+ *  over the same Q15 master table, and every per-sample step is a table
+ *  read plus one or two multiplies.
+ *
+ *    AM  y = c * (1 + d*m) / 2          d = depth, peak stays in swing
+ *    FM  dphase = carrier + dev * m     dev = peak deviation (tuning)
+ *    PM  y = sin(phase + k * m)         k = peak phase deviation
+ */
+#ifndef MODULATION_H
+#define MODULATION_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include "dds.h"
+
+typedef enum {
+    MODULATION_NONE = 0,
+    MODULATION_AM,
+    MODULATION_FM,
+    MODULATION_PM,
+    MODULATION_COUNT
+} ModulationType_t;
+
+typedef struct {
+    ModulationType_t type;
+    uint32_t phase;         /* modulating oscillator, 2^32 = one period  */
+    uint32_t tuning_word;   /* modulating rate                           */
+    int32_t depth_q15;      /* AM: 0..32768 = 0..100 %                   */
+    int32_t deviation;      /* FM: peak tuning word deviation            */
+    uint32_t pm_gain;       /* PM: peak phase deviation, 2^32 = 2 pi rad */
+    const int16_t *table;   /* Q15 sine, one period                      */
+    uint32_t table_shift;   /* 32 - table_bits                           */
+    uint32_t sample_rate_hz;
+} Modulation_t;
+
+void Modulation_Init(Modulation_t *m, const int16_t *sine_q15, uint32_t table_bits, uint32_t sample_rate_hz);
+void Modulation_SetRate_mHz(Modulation_t *m, uint32_t rate_mhz);
+void Modulation_SetAM(Modulation_t *m, uint32_t depth_permille);
+void Modulation_SetFM(Modulation_t *m, uint32_t deviation_mhz);
+void Modulation_SetPM(Modulation_t *m, uint32_t index_mrad);
+void Modulation_Off(Modulation_t *m);
+
+void Modulation_Fill(Modulation_t *m, DDS_t *carrier, uint16_t low, uint16_t high,
+                     uint16_t *dst, uint32_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MODULATION_H */
@@ -0,0 +1,89 @@
+/*
+ * multitone.c
+ *
+ *  Tone-outer loop: for each tone the whole chunk is walked with its
+ *  phase and tuning word in registers, so the per-sample cost is one
+ *  table read and one MAC per tone plus a fixed scaling pass.
+ */
+#include "multitone.h"
+#include "dds.h"
+
+void MultiTone_Init(MultiTone_t *mt, const int16_t *sine_q15, uint32_t table_bits, uint32_t sample_rate_hz)
+{
+    mt->count = 0;
+    mt->table = sine_q15;
+    mt->table_shift = 32U - table_bits;
+    mt->sample_rate_hz = sample_rate_hz;
+}
+
+/* Q15 amplitudes from permille, scaled down together if they add up past 1000 */
+static void normalize(MultiTone_t *mt)
+{
+    uint32_t sum = 0;
+
+    for (uint32_t t = 0; t < mt->count; t++)
+        sum += mt->tone[t].amp_permille;
+    if (sum < 1000U)
+        sum = 1000U;
+
+    for (uint32_t t = 0; t < mt->count; t++)
+        mt->tone[t].amp_q15 = (int32_t)((uint64_t)mt->tone[t].amp_permille * 32767U / sum);
+}
+
+int MultiTone_Add(MultiTone_t *mt, uint32_t freq_mhz, uint32_t amp_permille, uint32_t phase_deg)
+{
+    MtTone_t *t;
+
+    if (mt->count >= MT_MAX_TONES || amp_permille > 1000U)
+        return 0;
+
+    t = &mt->tone[mt->count++];
+    t->tuning_word = DDS_TuningWord_mHz(mt->sample_rate_hz, freq_mhz);
+    t->phase = (uint32_t)(((uint64_t)(phase_deg % 360U) << 32) / 360U);
+    t->amp_permille = amp_permille;
+    normalize(mt);
+    return 1;
+}
+
+void MultiTone_Fill(MultiTone_t *mt, uint16_t low, uint16_t high, const uint16_t *cal,
+                    uint16_t *dst, uint32_t count)
+{
+    const int16_t *table = mt->table;
+    const uint32_t shift = mt->table_shift;
+    const int32_t span = (int32_t)high - (int32_t)low;
+    int32_t acc[MT_CHUNK];
+
+    while (count)
+    {
+        uint32_t n = (count < MT_CHUNK) ? count : MT_CHUNK;
+
+        for (uint32_t i = 0; i < n; i++)
+            acc[i] = 0;
+
+        for (uint32_t k = 0; k < mt->count; k++)
+        {
+            MtTone_t *t = &mt->tone[k];
+            uint32_t phase = t->phase;
+            const uint32_t tw = t->tuning_word;
+            const int32_t amp = t->amp_q15;
+
+            for (uint32_t i = 0; i < n; i++)
+            {
+                acc[i] += amp * table[phase >> shift];
+                phase += tw;
+            }
+            t->phase = phase;
+        }
+
+        /* Q30 -> Q15 (|v| <= 32767) -> [low, high] */
+        for (uint32_t i = 0; i < n; i++)
+        {
+            int32_t v = (acc[i] + (1 << 14)) >> 15;
+
+            dst[i] = DDS_Cal(cal, (uint32_t)(low + (((v + 32768) * span + 32768) >> 16)));
+        }
+
+        dst += n;
+        count -= n;
+    }
+}
@@ -0,0 +1,57 @@
+/*
+ * multitone.h
+ *
+ *  Sum of up to MT_MAX_TONES sine tones, each with its own frequency,
+ *  amplitude and start phase, mixed in fixed point straight into the DAC
+ *  block (intermodulation, DTMF-style tests).
+ *
+ *  Headroom: amplitudes are given in permille of the full swing. While
+ *  they add up to 1000 or less they are taken as is; above that all of
+ *  them are scaled by 1000 / sum, so the worst-case crest (every tone at
+ *  its peak at once) still lands exactly on the swing and never clips.
+ *  The scaled Q15 amplitudes sum to <= 32767, so the Q30 accumulator of
+ *  eight tones fits in 32 bits.
+ *
+ *  Tones are accumulated one at a time over a chunk of the block (one
+ *  phase accumulator in a register per pass), then the chunk is scaled
+ *  to [low, high] and stored through the DAC correction like the sine.
+ */
+#ifndef MULTITONE_H
+#define MULTITONE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+#define MT_MAX_TONES    8U
+#define MT_CHUNK        64U         /* samples accumulated per pass */
+
+typedef struct {
+    uint32_t phase;
+    uint32_t tuning_word;
+    uint32_t amp_permille;  /* as requested                        */
+    int32_t amp_q15;        /* after headroom scaling              */
+} MtTone_t;
+
+typedef struct {
+    MtTone_t tone[MT_MAX_TONES];
+    uint32_t count;
+    const int16_t *table;   /* signed Q15 sine, 1 << table_bits entries */
+    uint32_t table_shift;
+    uint32_t sample_rate_hz;
+} MultiTone_t;
+
+void MultiTone_Init(MultiTone_t *mt, const int16_t *sine_q15, uint32_t table_bits, uint32_t sample_rate_hz);
+int  MultiTone_Add(MultiTone_t *mt, uint32_t freq_mhz, uint32_t amp_permille, uint32_t phase_deg);
+
+/* Sum of the tones as a swing [low, high]; mid-level when empty */
+void MultiTone_Fill(MultiTone_t *mt, uint16_t low, uint16_t high, const uint16_t *cal,
+                    uint16_t *dst, uint32_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MULTITONE_H */
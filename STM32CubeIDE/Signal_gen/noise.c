@@ -0,0 +1,130 @@
+/*
+ * noise.c
+ *
+ *  Rows hold 12-bit signed values; the sum of NOISE_PINK_ROWS rows plus
+ *  the white term spans about +/-17 * 2048, which is scaled by 15/16
+ *  into Q15 and clipped on the rare peaks.
+ */
+#include "noise.h"
+#include <math.h>
+
+static inline uint32_t xorshift32(uint32_t *s)
+{
+    uint32_t x = *s;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *s = x;
+    return x;
+}
+
+static inline uint16_t to_dac(int32_t v, uint16_t low, uint32_t span)
+{
+    int32_t u = v + 32768;
+
+    if (u < 0) u = 0;
+    if (u > 65535) u = 65535;
+    return (uint16_t)(low + (((uint32_t)u * span + 32768U) >> 16));
+}
+
+static inline int32_t lowpass(Noise_t *n, int32_t v)
+{
+    n->lp += ((v - n->lp) * n->lp_coeff) >> 15;
+    return n->lp;
+}
+
+void Noise_Init(Noise_t *n, uint32_t seed)
+{
+    n->state = seed ? seed : 0x2545F491U;
+    n->counter = 0;
+    n->sum = 0;
+    for (uint32_t k = 0; k < NOISE_PINK_ROWS; k++)
+    {
+        n->rows[k] = (int32_t)xorshift32(&n->state) >> 20;
+        n->sum += n->rows[k];
+    }
+    n->lp = 0;
+    n->lp_coeff = 32768;
+}
+
+void Noise_SetBandwidth_Hz(Noise_t *n, uint32_t sample_rate_hz, uint32_t bandwidth_hz)
+{
+    if (bandwidth_hz == 0U || 2U * bandwidth_hz >= sample_rate_hz)
+    {
+        n->lp_coeff = 32768;
+        return;
+    }
+    /* One-pole: a = 1 - exp(-2 pi fc / fs) */
+    double a = 1.0 - exp(-6.283185307179586 * (double)bandwidth_hz / (double)sample_rate_hz);
+    n->lp_coeff = (int32_t)(a * 32768.0 + 0.5);
+    if (n->lp_coeff < 1) n->lp_coeff = 1;
+}
+
+void Noise_FillWhite(Noise_t *n, uint16_t low, uint16_t high, uint16_t *dst, uint32_t count)
+{
+    const uint32_t span = (uint32_t)(high - low);
+    uint32_t s = n->state;
+
+    if (n->lp_coeff >= 32768)
+    {
+        /* Full band: two samples per xorshift step, straight to DAC codes */
+        for (; count >= 2U; count -= 2U)
+        {
+            uint32_t r = xorshift32(&s);
+            *dst++ = (uint16_t)(low + (((r & 0xFFFFU) * span + 32768U) >> 16));
+            *dst++ = (uint16_t)(low + (((r >> 16) * span + 32768U) >> 16));
+        }
+        if (count)
+        {
+            uint32_t r = xorshift32(&s);
+            *dst = (uint16_t)(low + (((r >> 16) * span + 32768U) >> 16));
+        }
+    }
+    else
+    {
+        for (; count >= 2U; count -= 2U)
+        {
+            uint32_t r = xorshift32(&s);
+            *dst++ = to_dac(lowpass(n, (int16_t)r), low, span);
+            *dst++ = to_dac(lowpass(n, (int16_t)(r >> 16)), low, span);
+        }
+        if (count)
+            *dst = to_dac(lowpass(n, (int16_t)(xorshift32(&s) >> 16)), low, span);
+    }
+    n->state = s;
+}
+
+void Noise_FillPink(Noise_t *n, uint16_t low, uint16_t high, uint16_t *dst, uint32_t count)
+{
+    const uint32_t span = (uint32_t)(high - low);
+    const int filtered = (n->lp_coeff < 32768);
+    uint32_t s = n->state;
+    uint32_t counter = n->counter;
+    int32_t sum = n->sum;
+
+    while (count--)
+    {
+        uint32_t r = xorshift32(&s);
+        /* Bit NOISE_PINK_ROWS keeps ctz defined when the counter wraps */
+        uint32_t k = (uint32_t)__builtin_ctz(++counter | (1U << NOISE_PINK_ROWS));
+        int32_t v;
+
+        if (k < NOISE_PINK_ROWS)
+        {
+            /* Upper 12 bits redraw the row, lower 12 bits are the white term */
+            int32_t row = (int32_t)r >> 20;
+            sum += row - n->rows[k];
+            n->rows[k] = row;
+        }
+        v = sum + ((int32_t)(r << 20) >> 20);
+        v = (v * 15) >> 4;
+        if (filtered) v = lowpass(n, v);
+
+        *dst++ = to_dac(v, low, span);
+    }
+
+    n->state = s;
+    n->counter = counter;
+    n->sum = sum;
+}
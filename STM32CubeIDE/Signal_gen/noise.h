@@ -0,0 +1,46 @@
+/*
+ * noise.h
+ *
+ *  White and pink noise sources for the DMA refill path.
+ *
+ *  White: xorshift32, one state update yields two 16-bit samples.
+ *  Pink:  Voss-McCartney - NOISE_PINK_ROWS random rows, row k is redrawn
+ *         every 2^(k+1) samples (picked by the trailing zeros of a
+ *         counter), so each sample costs one row update plus the white
+ *         term regardless of the row count. -3 dB/octave from
+ *         fs / 2^NOISE_PINK_ROWS up.
+ *
+ *  Bandwidth is an optional one-pole low-pass after either source.
+ *  Amplitude is the usual [low, high] DAC swing.
+ */
+#ifndef NOISE_H
+#define NOISE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+#define NOISE_PINK_ROWS     16U
+
+typedef struct {
+    uint32_t state;                     /* xorshift32, never 0             */
+    uint32_t counter;                   /* Voss-McCartney row selector     */
+    int32_t rows[NOISE_PINK_ROWS];
+    int32_t sum;                        /* sum of rows                     */
+    int32_t lp;                         /* low-pass state, Q15             */
+    int32_t lp_coeff;                   /* Q15, 32768 = full band (bypass) */
+} Noise_t;
+
+void Noise_Init(Noise_t *n, uint32_t seed);
+void Noise_SetBandwidth_Hz(Noise_t *n, uint32_t sample_rate_hz, uint32_t bandwidth_hz);
+
+void Noise_FillWhite(Noise_t *n, uint16_t low, uint16_t high, uint16_t *dst, uint32_t count);
+void Noise_FillPink(Noise_t *n, uint16_t low, uint16_t high, uint16_t *dst, uint32_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NOISE_H */
@@ -0,0 +1,174 @@
+/*
+ * preset.c
+ *
+ *  Slot s lives at offset + s * PRESET_SLOT_BYTES; the header is read in
+ *  place from the mapped region, the table follows at PRESET_TABLE_OFFSET.
+ */
+#include "preset.h"
+#include <stddef.h>
+#include <string.h>
+
+/* CRC-32 (IEEE, reflected), a nibble at a time: 16-entry table */
+static const uint32_t crc_nibble[16] =
+{
+    0x00000000U, 0x1DB71064U, 0x3B6E20C8U, 0x26D930ACU,
+    0x76DC4190U, 0x6B6B51F4U, 0x4DB26158U, 0x5005713CU,
+    0xEDB88320U, 0xF00F9344U, 0xD6D6A3E8U, 0xCB61B38CU,
+    0x9B64C2B0U, 0x86D3D2D4U, 0xA00AE278U, 0xBDBDF21CU
+};
+
+uint32_t Preset_Crc32(const void *data, uint32_t len)
+{
+    const uint8_t *p = (const uint8_t *)data;
+    uint32_t crc = 0xFFFFFFFFU;
+
+    while (len--)
+    {
+        crc ^= *p++;
+        crc = (crc >> 4) ^ crc_nibble[crc & 0x0FU];
+        crc = (crc >> 4) ^ crc_nibble[crc & 0x0FU];
+    }
+    return ~crc;
+}
+
+static const PresetHeader_t *slot_header(const PresetStore_t *ps, uint32_t slot)
+{
+    return (const PresetHeader_t *)(const void *)(ps->flash.base + slot * PRESET_SLOT_BYTES);
+}
+
+static const uint16_t *slot_table(const PresetStore_t *ps, uint32_t slot)
+{
+    return (const uint16_t *)(const void *)(ps->flash.base + slot * PRESET_SLOT_BYTES + PRESET_TABLE_OFFSET);
+}
+
+static int slot_ok(const PresetStore_t *ps, uint32_t slot)
+{
+    const PresetHeader_t *h = slot_header(ps, slot);
+
+    if (h->magic != PRESET_MAGIC || h->version != PRESET_VERSION)
+        return 0;
+    if (h->header_crc != Preset_Crc32(h, offsetof(PresetHeader_t, header_crc)))
+        return 0;
+    if ((h->kind != PRESET_DDS && h->kind != PRESET_EXACT) || h->samples > PRESET_MAX_SAMPLES)
+        return 0;
+    return h->table_crc == Preset_Crc32(slot_table(ps, slot), h->samples * sizeof(uint16_t));
+}
+
+void Preset_Init(PresetStore_t *ps, const PresetFlash_t *flash)
+{
+    ps->flash = *flash;
+    Preset_Scan(ps);
+}
+
+uint32_t Preset_Scan(PresetStore_t *ps)
+{
+    uint32_t count = 0;
+
+    ps->valid = 0;
+    for (uint32_t s = 0; s < PRESET_SLOTS; s++)
+    {
+        if (slot_ok(ps, s))
+        {
+            ps->valid |= 1U << s;
+            count++;
+        }
+    }
+    return count;
+}
+
+const PresetHeader_t *Preset_Header(const PresetStore_t *ps, uint32_t slot)
+{
+    if (slot >= PRESET_SLOTS || !(ps->valid & (1U << slot)))
+        return NULL;
+    return slot_header(ps, slot);
+}
+
+const uint16_t *Preset_Table(const PresetStore_t *ps, uint32_t slot)
+{
+    const PresetHeader_t *h = Preset_Header(ps, slot);
+
+    return (h != NULL && h->samples) ? slot_table(ps, slot) : NULL;
+}
+
+int Preset_Find(const PresetStore_t *ps, const char *name)
+{
+    for (uint32_t s = 0; s < PRESET_SLOTS; s++)
+    {
+        const PresetHeader_t *h = Preset_Header(ps, s);
+
+        if (h != NULL && strncmp(h->name, name, PRESET_NAME_LEN) == 0)
+            return (int)s;
+    }
+    return -1;
+}
+
+int Preset_FreeSlot(const PresetStore_t *ps)
+{
+    for (uint32_t s = 0; s < PRESET_SLOTS; s++)
+        if (!(ps->valid & (1U << s)))
+            return (int)s;
+    return -1;
+}
+
+/* Sectors of a slot that hold data; only those are erased */
+static int erase_slot(PresetStore_t *ps, uint32_t slot, uint32_t bytes)
+{
+    uint32_t addr = ps->flash.offset + slot * PRESET_SLOT_BYTES;
+
+    for (uint32_t done = 0; done < bytes; done += PRESET_SECTOR_BYTES)
+        if (!ps->flash.erase(addr + done))
+            return 0;
+    return 1;
+}
+
+int Preset_Save(PresetStore_t *ps, uint32_t slot, const char *name,
+                const PresetHeader_t *params, const uint16_t *table)
+{
+    PresetHeader_t h = *params;
+    uint32_t addr = ps->flash.offset + slot * PRESET_SLOT_BYTES;
+    uint32_t table_bytes = h.samples * (uint32_t)sizeof(uint16_t);
+    int ok;
+
+    if (slot >= PRESET_SLOTS || h.samples > PRESET_MAX_SAMPLES || (h.samples && table == NULL))
+        return 0;
+
+    h.magic = PRESET_MAGIC;
+    h.version = PRESET_VERSION;
+    memset(h.name, 0, sizeof(h.name));
+    for (uint32_t i = 0; i < PRESET_NAME_LEN && name[i] != '\0'; i++)
+        h.name[i] = name[i];
+    h.table_crc = Preset_Crc32(table, table_bytes);
+    h.header_crc = Preset_Crc32(&h, offsetof(PresetHeader_t, header_crc));
+
+    ps->valid &= ~(1U << slot);
+    ps->flash.begin();
+    ok = erase_slot(ps, slot, PRESET_TABLE_OFFSET + table_bytes);
+    if (ok && table_bytes)
+        ok = ps->flash.program(addr + PRESET_TABLE_OFFSET, table, table_bytes);
+    if (ok)
+        ok = ps->flash.program(addr, &h, sizeof(h));
+    ps->flash.end();
+
+    /* Read back through the map, as recall will */
+    if (ok && slot_ok(ps, slot))
+    {
+        ps->valid |= 1U << slot;
+        return 1;
+    }
+    return 0;
+}
+
+/* The header sector alone: without a magic the slot reads empty */
+int Preset_Erase(PresetStore_t *ps, uint32_t slot)
+{
+    int ok;
+
+    if (slot >= PRESET_SLOTS)
+        return 0;
+
+    ps->valid &= ~(1U << slot);
+    ps->flash.begin();
+    ok = erase_slot(ps, slot, 1);
+    ps->flash.end();
+    return ok;
+}
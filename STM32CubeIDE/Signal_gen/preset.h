@@ -0,0 +1,98 @@
+/*
+ * preset.h
+ *
+ *  Waveform presets in a dedicated region of the QSPI flash. Each preset
+ *  sits in a fixed slot: a header page (parameters, name, CRCs) followed
+ *  by the rendered table, if any. The flash is read memory-mapped, so a
+ *  stored table is already addressable as uint16_t[] and a recall is a
+ *  DMA copy into a RAM bank plus a pointer switch - no regeneration.
+ *
+ *    PRESET_DDS     parameter block; with samples = 2^bits (<= 4096) also
+ *                   a normalized offset-binary table the DDS plays like
+ *                   the sine table (arbitrary waveform)
+ *    PRESET_EXACT   exact-mode period table in DAC codes plus the TIM7
+ *                   dividers it was planned for (samples = n)
+ *
+ *  The index is the slot headers themselves, checked once by Preset_Scan()
+ *  (magic, version, both CRCs) into a bitmask; recall trusts the bitmask.
+ *  A save writes the table first and the header last, so a save cut short
+ *  leaves the slot empty rather than half valid.
+ *
+ *  No HAL dependency: erase/program/map are callbacks (QSPI in main.c,
+ *  a RAM array on the host).
+ */
+#ifndef PRESET_H
+#define PRESET_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+#define PRESET_MAGIC        0x54455350U     /* "PSET" */
+#define PRESET_VERSION      1U
+#define PRESET_SLOTS        32U
+#define PRESET_SLOT_BYTES   0x4000U         /* header page + 8 KB table, 4 sectors */
+#define PRESET_SECTOR_BYTES 0x1000U         /* erase unit (subsector) */
+#define PRESET_TABLE_OFFSET 0x100U          /* one program page for the header */
+#define PRESET_MAX_SAMPLES  4096U
+#define PRESET_NAME_LEN     12U
+#define PRESET_REGION_BYTES (PRESET_SLOTS * PRESET_SLOT_BYTES)
+
+typedef enum {
+    PRESET_DDS = 1,
+    PRESET_EXACT
+} PresetKind_t;
+
+typedef struct {
+    uint32_t magic;         /* erased flash reads 0xFFFFFFFF          */
+    uint8_t version;
+    uint8_t kind;           /* PresetKind_t                           */
+    uint8_t form;           /* Waveform_t                             */
+    uint8_t band_limited;
+    char name[PRESET_NAME_LEN];     /* zero padded, not terminated when full */
+    uint32_t duty;
+    uint16_t low, high;
+    uint32_t freq_mhz;      /* DDS output frequency                   */
+    uint32_t psc, arr;      /* EXACT: TIM7 dividers                   */
+    uint32_t samples;       /* table length, 0 - parameters only      */
+    uint32_t table_crc;
+    uint32_t header_crc;    /* CRC-32 of all fields above             */
+} PresetHeader_t;
+
+typedef struct {
+    const uint8_t *base;    /* region as mapped in memory             */
+    uint32_t offset;        /* region start inside the flash chip     */
+    int  (*erase)(uint32_t addr);                               /* one sector */
+    int  (*program)(uint32_t addr, const void *data, uint32_t len);
+    void (*begin)(void);    /* unmap: nothing may read base until end */
+    void (*end)(void);      /* map again, drop stale cache lines      */
+} PresetFlash_t;
+
+typedef struct {
+    PresetFlash_t flash;
+    uint32_t valid;         /* bit per slot                           */
+} PresetStore_t;
+
+void     Preset_Init(PresetStore_t *ps, const PresetFlash_t *flash);
+uint32_t Preset_Scan(PresetStore_t *ps);
+
+const PresetHeader_t *Preset_Header(const PresetStore_t *ps, uint32_t slot);
+const uint16_t *Preset_Table(const PresetStore_t *ps, uint32_t slot);
+int Preset_Find(const PresetStore_t *ps, const char *name);
+int Preset_FreeSlot(const PresetStore_t *ps);
+
+/* params: kind, form, levels, frequency/dividers and samples; the rest is
+ * filled in. Blocking (erase ~50 ms per sector); call from a task */
+int Preset_Save(PresetStore_t *ps, uint32_t slot, const char *name,
+                const PresetHeader_t *params, const uint16_t *table);
+int Preset_Erase(PresetStore_t *ps, uint32_t slot);
+
+uint32_t Preset_Crc32(const void *data, uint32_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PRESET_H */
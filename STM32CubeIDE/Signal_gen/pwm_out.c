@@ -0,0 +1,60 @@
+/*
+ * pwm_out.c
+ *
+ *  The period in timer counts is rounded once; the prescaler only widens
+ *  it past 16 bits, so the frequency error is set by the rounding of
+ *  counts / (PSC + 1) and shrinks as the frequency falls.
+ */
+#include "pwm_out.h"
+
+int PwmOut_Plan(uint32_t timer_clk_hz, uint32_t freq_mhz, uint32_t duty,
+                uint32_t max_error_ppm, PwmPlan_t *plan)
+{
+    uint64_t clk_mhz = (uint64_t)timer_clk_hz * 1000U;
+    uint64_t counts, div, period, err;
+    uint32_t ccr;
+
+    if (freq_mhz == 0U)
+        return 0;
+
+    counts = (clk_mhz + freq_mhz / 2U) / freq_mhz;
+    if (counts < PWM_OUT_MIN_PERIOD || counts > 0x100000000ULL)
+        return 0;
+
+    div = (counts - 1U) / 65536U + 1U;
+    period = (counts + div / 2U) / div;
+    if (period > 65536U)
+        period = 65536U;
+    if (period < PWM_OUT_MIN_PERIOD)
+        return 0;
+
+    /* |f - f_out| / f_out = |f * div * period - clk| / clk */
+    err = (uint64_t)freq_mhz * div * period;
+    err = (err > clk_mhz) ? err - clk_mhz : clk_mhz - err;
+    if (err * 1000000U > (uint64_t)max_error_ppm * clk_mhz)
+        return 0;
+
+    /* Nearest duty, but always one edge each way */
+    ccr = (uint32_t)(((uint64_t)duty * period + 0x80000000U) >> 32);
+    if (ccr < 1U) ccr = 1U;
+    if (ccr > period - 1U) ccr = (uint32_t)period - 1U;
+
+    plan->psc = (uint32_t)div - 1U;
+    plan->arr = (uint32_t)period - 1U;
+    plan->ccr = ccr;
+    return 1;
+}
+
+uint32_t PwmOut_Frequency_mHz(uint32_t timer_clk_hz, const PwmPlan_t *plan)
+{
+    uint64_t k = (uint64_t)(plan->psc + 1U) * (plan->arr + 1U);
+
+    return (uint32_t)(((uint64_t)timer_clk_hz * 1000U + k / 2U) / k);
+}
+
+uint32_t PwmOut_Duty(const PwmPlan_t *plan)
+{
+    uint64_t d = ((uint64_t)plan->ccr << 32) / (plan->arr + 1U);
+
+    return (d > 0xFFFFFFFFU) ? 0xFFFFFFFFU : (uint32_t)d;
+}
@@ -0,0 +1,47 @@
+/*
+ * pwm_out.h
+ *
+ *  Planning for the timer PWM backend. Square and pulse waves come
+ *  straight out of a timer channel in PWM mode 1:
+ *
+ *      f    = timer_clk / ((PSC + 1) * (ARR + 1))
+ *      duty = CCR / (ARR + 1)
+ *
+ *  so no table, no DMA and no CPU once started, and the edge rate is the
+ *  timer clock instead of the DAC update rate. The output is a logic pin
+ *  (0 / VDD), so levels are not part of the plan. The smallest prescaler
+ *  that fits ARR into 16 bits is taken, which keeps the duty resolution
+ *  at its best; frequencies whose period cannot be hit within the
+ *  tolerance are refused and stay on the DAC.
+ *
+ *  No HAL dependency; signal_gen.c programs the timer.
+ */
+#ifndef PWM_OUT_H
+#define PWM_OUT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+#define PWM_OUT_MIN_PERIOD  2U          /* counts: one high, one low */
+
+typedef struct {
+    uint32_t psc;
+    uint32_t arr;
+    uint32_t ccr;           /* high while CNT < CCR, 1 .. ARR       */
+} PwmPlan_t;
+
+/* duty: high fraction, 2^32 = 100 % (WaveParams_t.duty) */
+int PwmOut_Plan(uint32_t timer_clk_hz, uint32_t freq_mhz, uint32_t duty,
+                uint32_t max_error_ppm, PwmPlan_t *plan);
+
+uint32_t PwmOut_Frequency_mHz(uint32_t timer_clk_hz, const PwmPlan_t *plan);
+uint32_t PwmOut_Duty(const PwmPlan_t *plan);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PWM_OUT_H */
@@ -0,0 +1,105 @@
+/*
+ * ramp.c
+ *
+ *  Levels move in Q16 steps per sample and snap to the targets on the
+ *  last one, so rounding never accumulates into an offset.
+ */
+#include "ramp.h"
+
+void Ramp_Init(Ramp_t *r, uint16_t low, uint16_t high, uint32_t gate, uint32_t length)
+{
+    r->low = (uint32_t)low << 16;
+    r->high = (uint32_t)high << 16;
+    r->gate = gate;
+    r->dlow = r->dhigh = r->dgate = 0;
+    r->remaining = 0;
+    r->length = length;
+    r->to_low = low;
+    r->to_high = high;
+    r->to_gate = gate;
+}
+
+static int32_t step(uint32_t from, uint32_t to, uint32_t n)
+{
+    return (int32_t)(((int64_t)to - (int64_t)from) / (int64_t)n);
+}
+
+void Ramp_To(Ramp_t *r, uint16_t low, uint16_t high, uint32_t gate)
+{
+    r->to_low = low;
+    r->to_high = high;
+    r->to_gate = gate;
+
+    if (r->length == 0U)
+    {
+        Ramp_Init(r, low, high, gate, 0);
+        return;
+    }
+    r->dlow = step(r->low, (uint32_t)low << 16, r->length);
+    r->dhigh = step(r->high, (uint32_t)high << 16, r->length);
+    r->dgate = step(r->gate, gate, r->length);
+    r->remaining = r->length;
+}
+
+static uint16_t level(uint32_t q16)
+{
+    return (uint16_t)((q16 + 0x8000U) >> 16);
+}
+
+uint32_t Ramp_Next(Ramp_t *r, uint32_t count, uint16_t *low, uint16_t *high, uint32_t *gate)
+{
+    uint32_t n = count, half;
+
+    if (r->remaining == 0U)
+    {
+        *low = r->to_low;
+        *high = r->to_high;
+        *gate = r->gate;
+        return n;
+    }
+
+    if (n > RAMP_CHUNK) n = RAMP_CHUNK;
+    if (n > r->remaining) n = r->remaining;
+    half = n / 2U;
+
+    *low = level(r->low + (uint32_t)(r->dlow * (int32_t)half));
+    *high = level(r->high + (uint32_t)(r->dhigh * (int32_t)half));
+    *gate = r->gate + (uint32_t)(r->dgate * (int32_t)half);
+
+    r->remaining -= n;
+    if (r->remaining == 0U)
+    {
+        r->low = (uint32_t)r->to_low << 16;
+        r->high = (uint32_t)r->to_high << 16;
+        r->gate = r->to_gate;
+    }
+    else
+    {
+        r->low += (uint32_t)(r->dlow * (int32_t)n);
+        r->high += (uint32_t)(r->dhigh * (int32_t)n);
+        r->gate += (uint32_t)(r->dgate * (int32_t)n);
+    }
+    return n;
+}
+
+void Ramp_Gate(uint32_t gate, uint16_t *dst, uint32_t count)
+{
+    for (uint32_t i = 0; i < count; i++)
+        dst[i] = (uint16_t)((dst[i] * gate + 0x8000U) >> 16);
+}
+
+void Ramp_Map(uint16_t from_low, uint16_t from_high, uint16_t low, uint16_t high, uint16_t max,
+              uint16_t *dst, uint32_t count)
+{
+    int32_t gain = 65536;       /* Q16 */
+
+    if (from_high > from_low)
+        gain = (int32_t)((((int64_t)high - low) << 16) / ((int32_t)from_high - from_low));
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        int32_t v = low + (int32_t)((((int64_t)dst[i] - from_low) * gain + 0x8000) >> 16);
+
+        dst[i] = (uint16_t)((v < 0) ? 0 : (v > max) ? max : v);
+    }
+}
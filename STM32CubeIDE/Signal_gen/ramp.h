@@ -0,0 +1,64 @@
+/*
+ * ramp.h
+ *
+ *  Parameter smoothing for the block fill: the swing (low/high) and an
+ *  output gate glide linearly to new targets over a set number of samples
+ *  instead of stepping. The fill loop asks for levels chunk by chunk and
+ *  renders each chunk with the ordinary kernels, so no kernel knows about
+ *  ramps; when idle the loop asks nothing and the cost is one compare.
+ *
+ *  The gate scales the whole output towards code 0: kernels that take
+ *  levels get low * gate and high * gate. Tables rendered with their
+ *  levels built in are mapped afterwards: the exact-mode period table
+ *  from its swing to the ramped one (Ramp_Map), sequences - whose
+ *  segments carry their own levels - by the gate alone (Ramp_Gate).
+ */
+#ifndef RAMP_H
+#define RAMP_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+#define RAMP_CHUNK      16U         /* samples rendered with one set of levels */
+#define RAMP_UNITY      65536U      /* gate fully open, Q16                    */
+
+typedef struct {
+    uint32_t low, high;     /* current levels, DAC codes Q16               */
+    uint32_t gate;          /* current gate, Q16                           */
+    int32_t dlow, dhigh, dgate;     /* per-sample step while running       */
+    uint32_t remaining;     /* samples left, 0 - idle                      */
+    uint32_t length;        /* samples per ramp, 0 - step at once          */
+    uint16_t to_low, to_high;
+    uint32_t to_gate;
+} Ramp_t;
+
+void Ramp_Init(Ramp_t *r, uint16_t low, uint16_t high, uint32_t gate, uint32_t length);
+
+/* New targets, reached in r->length samples from wherever the ramp is now */
+void Ramp_To(Ramp_t *r, uint16_t low, uint16_t high, uint32_t gate);
+
+static inline int Ramp_Active(const Ramp_t *r)
+{
+    return r->remaining != 0U;
+}
+
+/* Next chunk of at most count samples: levels at its middle (gate not
+ * applied), returns its length. After the ramp - the rest in one piece */
+uint32_t Ramp_Next(Ramp_t *r, uint32_t count, uint16_t *low, uint16_t *high, uint32_t *gate);
+
+/* codes * gate */
+void Ramp_Gate(uint32_t gate, uint16_t *dst, uint32_t count);
+
+/* Codes rendered for the swing [from_low, from_high] moved to [low, high],
+ * clamped to [0, max]; a flat source swing is only shifted */
+void Ramp_Map(uint16_t from_low, uint16_t from_high, uint16_t low, uint16_t high, uint16_t max,
+              uint16_t *dst, uint32_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RAMP_H */
@@ -0,0 +1,168 @@
+/*
+ * sequencer.c
+ *
+ *  The fill loop cuts the block at min(block left, segment left), loads
+ *  the segment's tuning word and renders the piece with the ordinary
+ *  waveform kernel. Nothing is pre-rendered, so a segment costs the same
+ *  per sample as the free-running shape plus one kernel call.
+ */
+#include "sequencer.h"
+
+void Seq_Init(Sequencer_t *seq, uint32_t sample_rate_hz, uint32_t (*cycles)(void))
+{
+    seq->count = 0;
+    seq->sample_rate_hz = sample_rate_hz;
+    seq->cycles = cycles;
+    seq->loop = 0;
+    seq->active = 0;
+    seq->index = 0;
+    seq->remaining = 0;
+    seq->hold = 0;
+    seq->stats = (SeqStats_t){ 0 };
+}
+
+int Seq_Add(Sequencer_t *seq, const WaveParams_t *wave, uint32_t freq_mhz, uint32_t duration_us)
+{
+    uint64_t samples = (uint64_t)duration_us * seq->sample_rate_hz / 1000000U;
+    SeqSegment_t *s;
+
+    if (seq->count >= SEQ_MAX_SEGMENTS || samples == 0U || samples > 0xFFFFFFFFU)
+        return 0;
+
+    s = &seq->seg[seq->count++];
+    s->wave = *wave;
+    s->tuning_word = DDS_TuningWord_mHz(seq->sample_rate_hz, freq_mhz);
+    s->samples = (uint32_t)samples;
+    return 1;
+}
+
+int Seq_AddDC(Sequencer_t *seq, uint16_t level, uint32_t duration_us)
+{
+    WaveParams_t dc = { WAVEFORM_SINE, 0, level, level, 0 };
+
+    return Seq_Add(seq, &dc, 0, duration_us);
+}
+
+void Seq_SetLoop(Sequencer_t *seq, int loop)
+{
+    seq->loop = loop ? 1U : 0U;
+}
+
+void Seq_Rewind(Sequencer_t *seq, DDS_t *dds)
+{
+    seq->index = 0;
+    seq->active = (seq->count > 0U) ? 1U : 0U;
+    seq->remaining = seq->active ? seq->seg[0].samples : 0U;
+    seq->stats = (SeqStats_t){ 0 };
+    dds->phase = 0;
+}
+
+/* Step to the next segment; phase restarts so every pass is identical */
+static void next_segment(Sequencer_t *seq, DDS_t *dds)
+{
+    if (++seq->index >= seq->count)
+    {
+        if (!seq->loop)
+        {
+            seq->active = 0;
+            return;
+        }
+        seq->index = 0;
+    }
+    seq->remaining = seq->seg[seq->index].samples;
+    seq->stats.switches++;
+    dds->phase = 0;
+}
+
+void Seq_Fill(Sequencer_t *seq, DDS_t *dds, uint16_t *dst, uint32_t count)
+{
+    while (count)
+    {
+        const SeqSegment_t *s;
+        uint32_t n, c0 = 0;
+
+        if (!seq->active)
+        {
+            while (count--) *dst++ = seq->hold;
+            return;
+        }
+
+        s = &seq->seg[seq->index];
+        n = (seq->remaining < count) ? seq->remaining : count;
+
+        if (seq->cycles) c0 = seq->cycles();
+        dds->tuning_word = s->tuning_word;
+        Waveform_Fill(dds, &s->wave, dst, n);
+        if (seq->cycles)
+        {
+            SeqStats_t *st = &seq->stats;
+            uint32_t c = seq->cycles() - c0;
+
+            st->pieces++;
+            st->sum_n += n;
+            st->sum_c += c;
+            st->sum_nn += (uint64_t)n * n;
+            st->sum_nc += (uint64_t)n * c;
+        }
+
+        seq->hold = dst[n - 1U];
+        dst += n;
+        count -= n;
+        seq->remaining -= n;
+        if (seq->remaining == 0U)
+            next_segment(seq, dds);
+    }
+}
+
+uint32_t Seq_Period_samples(const Sequencer_t *seq)
+{
+    uint64_t total = 0;
+
+    for (uint32_t i = 0; i < seq->count; i++)
+        total += seq->seg[i].samples;
+    return (total > 0xFFFFFFFFU) ? 0xFFFFFFFFU : (uint32_t)total;
+}
+
+/* Least-squares line through (samples, cycles) of every piece. Pieces cut
+ * by block edges have varying lengths, which is what makes the fit work */
+int Seq_Overhead(const SeqStats_t *st, uint32_t *overhead_cycles, uint32_t *cycles_per_sample_q8)
+{
+    double p = (double)st->pieces;
+    double den = p * (double)st->sum_nn - (double)st->sum_n * (double)st->sum_n;
+    double slope, icpt;
+
+    if (st->pieces < 2U || den <= 0.0)
+        return 0;
+
+    slope = (p * (double)st->sum_nc - (double)st->sum_n * (double)st->sum_c) / den;
+    if (slope < 0.0) slope = 0.0;
+    icpt = ((double)st->sum_c - slope * (double)st->sum_n) / p;
+    if (icpt < 0.0) icpt = 0.0;
+
+    *overhead_cycles = (uint32_t)(icpt + 0.5);
+    *cycles_per_sample_q8 = (uint32_t)(slope * 256.0 + 0.5);
+    return 1;
+}
+
+/* A block crossed by segments of L samples is cut into at most
+ * ceil(block / L) + 1 pieces; each piece pays the overhead once.
+ * 0 - no fit yet, or the budget cannot afford a single cut */
+uint32_t Seq_MinSegment_samples(const SeqStats_t *st, uint32_t block_samples, uint32_t budget_cycles)
+{
+    uint32_t overhead, slope_q8;
+    uint64_t render, pieces;
+
+    if (!Seq_Overhead(st, &overhead, &slope_q8))
+        return 0;
+
+    render = ((uint64_t)block_samples * slope_q8 + 255U) >> 8;
+    if (render >= budget_cycles)
+        return 0;
+    if (overhead == 0U)
+        return 1;
+
+    pieces = (budget_cycles - render) / overhead;
+    if (pieces < 2U)
+        return 0;
+    return (uint32_t)((block_samples + pieces - 2U) / (pieces - 1U));
+}
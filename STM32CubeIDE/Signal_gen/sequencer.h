@@ -0,0 +1,77 @@
+/*
+ * sequencer.h
+ *
+ *  Segment sequencer: a list of (shape, frequency, level, duration)
+ *  segments played back-to-back through the normal block fill. A block
+ *  that straddles a segment boundary is rendered in pieces, so every
+ *  transition lands on the exact sample, independent of the block size.
+ *  The DAC rate stays fixed for the whole sequence; segment durations
+ *  are counted in samples at that rate.
+ *
+ *  Each segment starts at phase 0, so a looped sequence repeats
+ *  sample for sample. Noise shapes are not sequenced (rendered as
+ *  mid-level by Waveform_Fill).
+ *
+ *  Per-piece cost is fitted on the fly (cycles = overhead + n * slope,
+ *  least squares over every piece rendered) when a cycle counter is
+ *  supplied; the intercept is the per-segment overhead and sets the
+ *  shortest segment the fill budget can carry.
+ */
+#ifndef SEQUENCER_H
+#define SEQUENCER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include "dds.h"
+#include "waveform.h"
+
+#define SEQ_MAX_SEGMENTS    16U
+
+typedef struct {
+    WaveParams_t wave;      /* DC: any shape with low == high  */
+    uint32_t tuning_word;
+    uint32_t samples;       /* duration at the DAC rate        */
+} SeqSegment_t;
+
+typedef struct {
+    uint32_t pieces;        /* pieces measured                 */
+    uint64_t sum_n;         /* least-squares accumulators:     */
+    uint64_t sum_c;         /*   n - samples in a piece        */
+    uint64_t sum_nn;        /*   c - cycles spent on it        */
+    uint64_t sum_nc;
+    uint32_t switches;      /* segment transitions played      */
+} SeqStats_t;
+
+typedef struct {
+    SeqSegment_t seg[SEQ_MAX_SEGMENTS];
+    uint32_t count;
+    uint32_t sample_rate_hz;
+    uint32_t (*cycles)(void);   /* free-running cycle counter, may be NULL */
+    uint8_t loop;
+    uint8_t active;
+    uint32_t index;             /* segment being played                */
+    uint32_t remaining;         /* samples left in it                  */
+    uint16_t hold;              /* last sample, held after the end     */
+    SeqStats_t stats;
+} Sequencer_t;
+
+void Seq_Init(Sequencer_t *seq, uint32_t sample_rate_hz, uint32_t (*cycles)(void));
+int  Seq_Add(Sequencer_t *seq, const WaveParams_t *wave, uint32_t freq_mhz, uint32_t duration_us);
+int  Seq_AddDC(Sequencer_t *seq, uint16_t level, uint32_t duration_us);
+void Seq_SetLoop(Sequencer_t *seq, int loop);
+
+void Seq_Rewind(Sequencer_t *seq, DDS_t *dds);
+void Seq_Fill(Sequencer_t *seq, DDS_t *dds, uint16_t *dst, uint32_t count);
+
+uint32_t Seq_Period_samples(const Sequencer_t *seq);
+int Seq_Overhead(const SeqStats_t *st, uint32_t *overhead_cycles, uint32_t *cycles_per_sample_q8);
+uint32_t Seq_MinSegment_samples(const SeqStats_t *st, uint32_t block_samples, uint32_t budget_cycles);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SEQUENCER_H */
@@ -0,0 +1,109 @@
+/*
+ * sg_stream.c
+ *
+ *  Circular DMA over N = 2 * half samples, NDTR counts down from N.
+ *  Half 0 is handed back on half-transfer (DMA now in [N/2, N)),
+ *  half 1 on transfer-complete (DMA wrapped, now in [0, N/2)).
+ */
+#include "sg_stream.h"
+#include <stddef.h>
+
+void SG_Stream_Init(SG_Stream_t *s, uint16_t *buffer, uint32_t half_samples,
+                    SG_StreamFill_t fill, SG_StreamCommit_t commit,
+                    SG_StreamRemaining_t remaining, void *ctx)
+{
+    s->buffer = buffer;
+    s->half_samples = half_samples;
+    s->fill = fill;
+    s->commit = commit;
+    s->remaining = remaining;
+    s->ctx = ctx;
+    s->expected_half = 0;
+    s->commit_pending = 0;
+    s->blocks = 0;
+    s->commits = 0;
+    s->late_refills = 0;
+}
+
+void SG_Stream_Prime(SG_Stream_t *s)
+{
+    SG_Stream_CommitNow(s);
+    s->fill(s->ctx, SG_Stream_Half(s, 0), s->half_samples);
+    s->fill(s->ctx, SG_Stream_Half(s, 1), s->half_samples);
+    s->expected_half = 0;
+}
+
+/* Task side: the ISR will not apply anything until EndUpdate() */
+void SG_Stream_BeginUpdate(SG_Stream_t *s)
+{
+    s->commit_pending = 0;
+}
+
+void SG_Stream_EndUpdate(SG_Stream_t *s)
+{
+    s->commit_pending = 1;
+}
+
+/* Apply a posted update right away. Only for a caller that holds off the
+ * DMA interrupt and re-renders ahead of the DMA itself */
+void SG_Stream_CommitNow(SG_Stream_t *s)
+{
+    if (s->commit_pending && s->commit != NULL)
+    {
+        s->commit_pending = 0;
+        s->commit(s->ctx);
+        s->commits++;
+    }
+}
+
+/* ISR side: called from the DMA half/complete callback */
+void SG_Stream_OnHalfDone(SG_Stream_t *s, uint32_t half)
+{
+    /* A skipped callback means a whole half was replayed stale */
+    if (half != s->expected_half)
+        s->late_refills++;
+    s->expected_half = half ^ 1U;
+
+    SG_Stream_CommitNow(s);
+
+    s->fill(s->ctx, SG_Stream_Half(s, half), s->half_samples);
+    s->blocks++;
+
+    /* Deadline: DMA must still be in the other half when we finish */
+    if (s->remaining != NULL)
+    {
+        uint32_t in_half = (SG_Stream_Position(s) >= s->half_samples) ? 1U : 0U;
+
+        if (in_half == half)
+            s->late_refills++;
+    }
+}
+
+uint32_t SG_Stream_Position(const SG_Stream_t *s)
+{
+    uint32_t total = 2U * s->half_samples;
+
+    return (total - s->remaining(s->ctx)) % total;
+}
+
+uint32_t SG_Stream_Ahead(const SG_Stream_t *s, uint32_t guard, uint32_t *index)
+{
+    uint32_t pos, half, ahead;
+
+    if (s->remaining == NULL)
+        return 0;
+
+    pos = SG_Stream_Position(s);
+    half = (pos >= s->half_samples) ? 1U : 0U;
+    ahead = (half + 1U) * s->half_samples - pos;
+
+    /* The other half holds fresh data once its callback has run; until
+     * then the callback is pending and will render it from scratch */
+    if (s->expected_half == half)
+        ahead += s->half_samples;
+
+    if (ahead <= guard)
+        return 0;
+    *index = (pos + guard) % (2U * s->half_samples);
+    return ahead - guard;
+}
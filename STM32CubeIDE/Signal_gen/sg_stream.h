@@ -0,0 +1,73 @@
+/*
+ * sg_stream.h
+ *
+ *  Ping-pong streaming over one circular DMA buffer. The DMA half/complete
+ *  callbacks hand the half that was just read back to the CPU; the renderer
+ *  refills it while the DMA plays the other half.
+ *
+ *  Updates (new master table, new parameters) are posted from task context
+ *  with SG_Stream_BeginUpdate()/SG_Stream_EndUpdate() and applied by the ISR
+ *  only before rendering a fresh half, so the DAC never sees a torn period.
+ *
+ *  No HAL dependency: the DMA position is read through a callback.
+ */
+#ifndef SG_STREAM_H
+#define SG_STREAM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+typedef void     (*SG_StreamFill_t)(void *ctx, uint16_t *dst, uint32_t count);
+typedef void     (*SG_StreamCommit_t)(void *ctx);
+typedef uint32_t (*SG_StreamRemaining_t)(void *ctx);	/* DMA NDTR */
+
+typedef struct {
+    uint16_t *buffer;               /* 2 * half_samples, DMA source  */
+    uint32_t half_samples;
+
+    SG_StreamFill_t fill;
+    SG_StreamCommit_t commit;       /* may be NULL                   */
+    SG_StreamRemaining_t remaining; /* may be NULL (no late check)   */
+    void *ctx;
+
+    uint32_t expected_half;         /* half the next callback should report */
+    volatile uint32_t commit_pending;
+
+    volatile uint32_t blocks;       /* halves rendered                     */
+    volatile uint32_t commits;      /* updates applied at a boundary       */
+    volatile uint32_t late_refills; /* refills that missed their deadline  */
+} SG_Stream_t;
+
+void SG_Stream_Init(SG_Stream_t *s, uint16_t *buffer, uint32_t half_samples,
+                    SG_StreamFill_t fill, SG_StreamCommit_t commit,
+                    SG_StreamRemaining_t remaining, void *ctx);
+void SG_Stream_Prime(SG_Stream_t *s);
+
+void SG_Stream_BeginUpdate(SG_Stream_t *s);
+void SG_Stream_EndUpdate(SG_Stream_t *s);
+void SG_Stream_CommitNow(SG_Stream_t *s);
+
+void SG_Stream_OnHalfDone(SG_Stream_t *s, uint32_t half);
+
+/* Buffer index the DMA reads next; needs the remaining callback */
+uint32_t SG_Stream_Position(const SG_Stream_t *s);
+
+/* Rendered samples the DMA has not read yet, skipping guard samples right
+ * in front of it. *index - the first of them; the run may wrap past the
+ * end of the buffer. Call with the DMA interrupt masked, so no fill is in
+ * progress. 0 - nothing left beyond the guard, or no remaining callback */
+uint32_t SG_Stream_Ahead(const SG_Stream_t *s, uint32_t guard, uint32_t *index);
+
+static inline uint16_t *SG_Stream_Half(SG_Stream_t *s, uint32_t half)
+{
+    return s->buffer + half * s->half_samples;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SG_STREAM_H */
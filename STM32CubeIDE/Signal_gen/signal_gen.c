@@ -1,38 +1,1759 @@
 /*
  * signal_gen.c
  *
- *  Created on: 8 лют. 2026 р.
+ *  Created on: 8 лют. 2026 р.
  *      Author: Олександр
  */
 #include "signal_gen.h"
-#include <math.h>
+#include "wave_tables.h"
+#include "dual_dac.h"
+#include "sweep.h"
+#include "modulation.h"
+#include "noise.h"
+#include "freq_plan.h"
+#include "dac_wave.h"
+#include "harmonics.h"
+#include "sequencer.h"
+#include "dac_cal.h"
+#include "dither.h"
+#include "zoh.h"
+#include "marker.h"
+#include "preset.h"
+#include "ramp.h"
+#include "multitone.h"
+#include "pwm_out.h"
 
-uint16_t sine_table[SINE_SAMPLES];
+extern DAC_HandleTypeDef hdac;
+extern TIM_HandleTypeDef htim7;
+
+// Нормований синус (offset binary) у RAM; амплітуду й зсув DDS
+// накладає на льоту, тож таблиця будується один раз
+static uint16_t sine_norm[SINE_SAMPLES];
+
+// Гармонічна таблиця: DDS читає активну, GUI будує іншу
+static uint16_t harm_bank[2][SINE_SAMPLES];
+static int32_t harm_work[SINE_SAMPLES];
+static uint32_t harm_active = 0;
+static volatile uint32_t harm_swap_pending = 0;
+static Harmonics_t sg_harm;
+static uint8_t sg_harm_set = 0;
+
+// Довільна таблиця (пресети, SetArbitrary): 2^bits нормованих відліків,
+// DDS грає її як синус; банки перемикаються на межі блоку, як гармоніки
+static uint16_t arb_bank[2][PRESET_MAX_SAMPLES] __attribute__((aligned(32)));
+static uint32_t arb_bits[2] = { SINE_TABLE_BITS, SINE_TABLE_BITS };
+static uint32_t arb_active = 0;
+static volatile uint32_t arb_swap_pending = 0;
+
+// Компенсація спаду sinc від утримання відліку DAC (синус і гармоніки)
+static uint8_t sg_zoh = 1, sg_zoh_next = 1;
+
+// Буфер DMA: поки DAC читає одну половину, DDS заповнює іншу
+// (у dual-режимі кожен відлік - слово DHR12RD, тобто два halfword)
+uint16_t dac_buffer[SG_BUFFER_SAMPLES * 2] __attribute__((aligned(32)));
+
+static DDS_t sg_dds;
+static SG_Stream_t sg_stream;
+
+// Параметри форми: GUI пише _next, ISR копіює на межі блоку
+static WaveParams_t sg_params;
+static WaveParams_t sg_params_next;
+
+// Канал 2 (PA5): phase2 = phase1 * mult + offset
+static uint8_t sg_dual = 0;
+static uint32_t sg_ch2_offset, sg_ch2_offset_next;
+static uint32_t sg_ch2_mult = 1, sg_ch2_mult_next = 1;
+
+// Свіп: ISR крокує tuning word раз на блок, GUI лише читає позицію
+static Sweep_t sg_sweep;
+static Sweep_t sg_sweep_next;
+static volatile uint8_t sg_sweep_pending = 0;
+
+// Модуляція синусної несучої; фаза модулятора живе лише в sg_mod
+static Modulation_t sg_mod;
+static Modulation_t sg_mod_next;
+
+// Шум: стан генератора живе тут, ISR лише заповнює блоки
+static Noise_t sg_noise;
+
+// Точний режим: таблиця рівно одного періоду + власні PSC/ARR TIM7
+static const FreqPlanLimits_t sg_plan_limits =
+{
+    SG_TIMER_CLK_HZ, SG_TIMER_CLK_HZ / SG_SAMPLE_RATE_HZ,
+    SG_EXACT_MIN_SAMPLES, SG_EXACT_MAX_SAMPLES, SG_EXACT_TOLERANCE_PPM
+};
+static uint16_t exact_bank[2][SG_EXACT_MAX_SAMPLES] __attribute__((aligned(32)));
+static uint32_t exact_active = 0;
+static uint8_t sg_exact = 0, sg_exact_next = 0;
+static FreqPlan_t sg_plan, sg_plan_next;
+static volatile uint8_t sg_exact_pending = 0;
+static uint32_t sg_exact_index = 0;
+
+// Нові PSC/ARR пишуться, коли DMA дійде до першого блоку з новим вмістом
+static uint32_t sg_timer_countdown = 0;
+static uint32_t sg_timer_psc = 0;
+static uint32_t sg_timer_arr = SG_TIMER_CLK_HZ / SG_SAMPLE_RATE_HZ - 1U;
+
+// Вбудований генератор DAC: DMA1_Stream5 вільний, CPU не задіяний
+static const FreqPlanLimits_t sg_hw_limits =
+{
+    SG_TIMER_CLK_HZ, SG_TIMER_CLK_HZ / SG_SAMPLE_RATE_HZ, 0, 0, SG_HW_WAVE_TOLERANCE_PPM
+};
+static DacWave_t sg_hw_wave = { DACWAVE_OFF, 0, 0, { 0, 0, 0, 0 } };
+static uint8_t sg_hw_auto = 1;
+
+// Меандр/імпульси на TIM1 CH1 (PA8): фронти з тактом APB2, без DMA і CPU.
+// sg_freq_mhz - задана частота: DDS обрізає її на Найквісті, таймер - ні
+static PwmPlan_t sg_pwm;
+static uint8_t sg_pwm_on = 0;
+static uint32_t sg_freq_mhz = SG_DEFAULT_FREQ_HZ * 1000U;
+
+// Секвенсор: GUI збирає _next, ISR копіює і перемотує на межі блоку
+static Sequencer_t sg_seq, sg_seq_next;
+static uint8_t sg_seq_on = 0, sg_seq_next_on = 0;
+static volatile uint8_t sg_seq_pending = 0;
+static uint32_t sg_seq_tuning = 0;
+
+// Багатотон: до MT_MAX_TONES синусів, змішаних у блок; GUI збирає _next,
+// ISR копіює на межі блоку (фази тонів стартують з заданих)
+static MultiTone_t sg_mt, sg_mt_next;
+static uint8_t sg_mt_on = 0, sg_mt_next_on = 0;
+static volatile uint8_t sg_mt_pending = 0;
+
+// Корекція DAC (код -> код): ISR читає активну таблицю, задача будує іншу
+static uint16_t cal_bank[2][DAC_CAL_CODES];
+static uint32_t cal_active = 0;
+static uint8_t sg_cal_next_on = 0;
+static volatile uint8_t sg_cal_swap = 0, sg_cal_pending = 0;
+
+// Дизер/формування шуму для синуса й гармонік; стан помилки живе в ISR
+static Dither_t sg_dither;
+static DitherMode_t sg_dither_next = DITHER_OFF;
+
+// Мітка синхронізації на TEST_PIN: DMA2_Stream1 (TIM8_UP) пише BSRR
+// відлік-у-відлік із DAC; TIM8 крокує в ногу з TIM7 (див. RunClock)
+static uint32_t marker_buffer[SG_BUFFER_SAMPLES] __attribute__((aligned(32)));
+static DMA_HandleTypeDef hdma_marker;
+static Marker_t sg_marker;
+static MarkerMode_t sg_marker_mode = MARKER_OFF;
+static uint8_t sg_sweep_start = 0;
+
+// Плавні рівні й ворота виходу: ISR веде рампу до цілей з коміту;
+// поки рампа стоїть, заповнення блоку її не бачить
+static Ramp_t sg_ramp;
+static uint32_t sg_gate_next = 0;
+static uint8_t sg_ramp_blocks = 0;
+
+static void SignalGen_SelectBackend(void);
+
+static volatile uint32_t sg_fill_us_max = 0;
+static volatile uint32_t sg_fill_overruns = 0;
+
+// Затримка останнього перемикання частоти/форми: від виклику до першого
+// нового відліку на PA4, мкс; late - DMA обігнав перемальований відлік
+static uint32_t sg_retune_us = 0;
+static uint32_t sg_retune_late = 0;
+
+// Пресети у верхніх 512 КБ QSPI; індекс - заголовки слотів, перевірені при
+// старті. Таблиці копіює DMA2_Stream0 у RAM: ISR ніколи не читає QSPI,
+// тож запис пресета (флеш не відображений) не зачіпає потік
+static PresetStore_t sg_presets;
+static DMA_HandleTypeDef hdma_copy;
+static uint32_t sg_recall_us = 0;
+
+// Таблиця DDS для форми; next - та, що стане активною після коміту
+static const uint16_t *SignalGen_Table(Waveform_t form, int next, uint32_t *bits)
+{
+    uint32_t h = harm_active ^ ((next && harm_swap_pending) ? 1U : 0U);
+    uint32_t a = arb_active ^ ((next && arb_swap_pending) ? 1U : 0U);
+
+    *bits = SINE_TABLE_BITS;
+    if (form == WAVEFORM_HARMONIC)
+        return harm_bank[h];
+    if (form == WAVEFORM_ARBITRARY)
+    {
+        *bits = arb_bits[a];
+        return arb_bank[a];
+    }
+    return sine_norm;
+}
+
+// Рендер одного періоду для точного режиму; викликати між Begin/EndUpdate
+static void SignalGen_BuildExactTable(void)
+{
+    uint16_t *table = exact_bank[exact_active ^ 1U];
+    const uint32_t n = sg_plan_next.n;
+    const uint32_t q = (uint32_t)((1ULL << 32) / n);
+    const uint32_t r = (uint32_t)((1ULL << 32) % n);
+    uint32_t acc = 0, bits;
+    DDS_t dds = sg_dds;
+    WaveParams_t p = sg_params_next;
+    const uint16_t *src = SignalGen_Table(p.form, 1, &bits);
+
+    // Частота дискретизації тут f * n, тож спад рахується від 2^32 / n
+    if (sg_zoh_next && (p.form == WAVEFORM_SINE || p.form == WAVEFORM_HARMONIC))
+        Zoh_ScaleSwing(&p.low, &p.high, Zoh_Gain_q16(q), SG_DAC_MAX);
+
+    DDS_SetTable(&dds, src, bits);
+
+    // Таблиця періоду вже в скоригованих кодах - FillPeriod лише копіює
+    dds.cal = sg_cal_next_on ? cal_bank[sg_cal_swap ? cal_active ^ 1U : cal_active] : NULL;
+    dds.tuning_word = q;
+    dds.phase = 0;
+
+    // phase_i = floor(i * 2^32 / n) без ділення на кожному відліку
+    for (uint32_t i = 0; i < n; i++)
+    {
+        uint32_t phase = dds.phase;
+
+        Waveform_Fill(&dds, &p, &table[i], 1);
+        dds.phase = phase + q;
+        acc += r;
+        if (acc >= n) { acc -= n; dds.phase++; }
+    }
+    sg_exact_pending = 1;
+}
+
+// Таблиця гармонік у неактивний банк; з компенсацією ZOH кожна гармоніка
+// підсилюється відносно основної на частоті, яку зараз видаватиме потік.
+// Викликати між Begin/EndUpdate
+static void SignalGen_BuildHarmonics(void)
+{
+    uint16_t *table = harm_bank[harm_active ^ 1U];
+    Harmonics_t h = sg_harm;
+
+    if (sg_zoh_next)
+        Zoh_Harmonics(&sg_harm, &h, sg_exact_next ? (uint32_t)((1ULL << 32) / sg_plan_next.n)
+                                                  : sg_dds.tuning_word);
+    Harmonics_Build(&h, WaveTable_Get(WAVE_SINE), WAVE_TABLE_BITS, harm_work,
+                    (int16_t*) table, SINE_TABLE_BITS);
+    WaveTable_OffsetBinary(table, (const int16_t*) table, SINE_SAMPLES);
+    harm_swap_pending = 1;
+}
+
+// Нова частота - нові відносні підсилення гармонік
+static void SignalGen_RetuneHarmonics(void)
+{
+    if (!sg_zoh_next || !sg_harm_set || sg_params_next.form != WAVEFORM_HARMONIC)
+        return;
+
+    SG_Stream_BeginUpdate(&sg_stream);
+    SignalGen_BuildHarmonics();
+    SG_Stream_EndUpdate(&sg_stream);
+}
+
+// Повернення на DDS 1 MS/s з тією ж частотою; викликати між Begin/EndUpdate
+static void SignalGen_LeaveExact(void)
+{
+    if (!sg_exact_next) return;
+
+    sg_exact_next = 0;
+    sg_exact_pending = 1;
+    DDS_SetFrequency_mHz(&sg_dds, FreqPlan_Frequency_mHz(&sg_plan_limits, &sg_plan_next));
+}
 
 void Generete_SineTable(int touch_value)
 {
-    float max_dac_val = (touch_value * 4095.0f) / 33.0f;
+    // 33 поділок слайдера = 3.3 В = 4095
+    uint32_t max_dac_val = ((uint32_t)touch_value * 4095U + 16U) / 33U;
+
+    // Розмах 0 -> max_dac_val: лише два слова, таблицю не перераховуємо
+    SignalGen_SetAmplitudeOffset(max_dac_val, max_dac_val / 2U);
+}
+
+// Амплітуда (розмах) і середній рівень у кодах DAC; застосовуються на межі блоку
+void SignalGen_SetAmplitudeOffset(uint32_t amplitude, uint32_t offset)
+{
+    uint32_t half = amplitude / 2U;
+    uint32_t low = (offset > half) ? offset - half : 0U;
+    uint32_t high = low + amplitude;
+
+    if (high > SG_DAC_MAX) high = SG_DAC_MAX;
+    if (low > high) low = high;
+
+    SG_Stream_BeginUpdate(&sg_stream);
+    sg_params_next.low = (uint16_t)low;
+    sg_params_next.high = (uint16_t)high;
+    if (sg_exact_next) SignalGen_BuildExactTable();
+    SG_Stream_EndUpdate(&sg_stream);
+    SignalGen_SelectBackend();
+}
+
+// TIM8 тактується вдвічі швидше за TIM7 (APB2), тож подвоєний дільник
+static void SignalGen_MarkerTimer(uint32_t psc, uint32_t arr)
+{
+    TIM8->PSC = (psc + 1U) * (SG_MARKER_TIMER_CLK_HZ / SG_TIMER_CLK_HZ) - 1U;
+    TIM8->ARR = arr;
+}
+
+// Період відліку DAC; обидва таймери буферизовані - нове з наступного update
+static void SignalGen_SetSampleTimer(uint32_t psc, uint32_t arr)
+{
+    htim7.Instance->PSC = psc;
+    htim7.Instance->ARR = arr;
+    if (sg_marker_mode != MARKER_OFF)
+        SignalGen_MarkerTimer(psc, arr);
+}
+
+// Мітки для відліків, які зараз рендеряться: стан береться до рендеру
+static void SignalGen_FillMarker(uint32_t *mk, uint32_t count)
+{
+    Waveform_t form = sg_params.form;
+
+    if (sg_seq_on)
+        Marker_FillSegments(&sg_marker, &sg_seq, mk, count);
+    else if (sg_mt_on)
+        // Період першого тону (у DTMF - нижнього)
+        Marker_FillPhase(&sg_marker, sg_mt.tone[0].phase, sg_mt.tone[0].tuning_word, mk, count);
+    else if (form == WAVEFORM_NOISE_WHITE || form == WAVEFORM_NOISE_PINK)
+        Marker_Clear(&sg_marker, mk, count);
+    else if (sg_exact)
+        Marker_FillPeriod(&sg_marker, sg_exact_index, sg_plan.n, mk, count);
+    else if (sg_marker_mode == MARKER_SEGMENT && (sg_sweep.active || sg_sweep_start))
+    {
+        Marker_Clear(&sg_marker, mk, count);
+        if (sg_sweep_start) Marker_Mark(&sg_marker, mk, count, 0);
+    }
+    else
+        // FM/PM: період несучої
+        Marker_FillPhase(&sg_marker, sg_dds.phase, sg_dds.tuning_word, mk, count);
+}
+
+//******************************* DDS вихід *******************************//
+// Відліки з рівнями low/high (halfword; у dual-режимі count / 2 слів).
+// Таблиця точного режиму має рівні sg_params вшиті - її коди переносяться
+// на low/high; сегменти секвенції мають власні рівні - лише ворота
+static void SignalGen_RenderLevels(uint16_t low, uint16_t high, uint32_t gate,
+                                   uint16_t *dst, uint32_t count)
+{
+    WaveParams_t lv = sg_params;
+    const WaveParams_t *p = &lv;
+
+    lv.low = low;
+    lv.high = high;
+
+    // Розмах під 1/sinc поточної частоти - раз на блок, тож стежить і за свіпом
+    if (sg_zoh && (sg_params.form == WAVEFORM_SINE || sg_params.form == WAVEFORM_HARMONIC))
+        Zoh_ScaleSwing(&lv.low, &lv.high, Zoh_Gain_q16(sg_dds.tuning_word), SG_DAC_MAX);
+
+    if (sg_dual)
+        DualDac_Fill(&sg_dds, p, sg_ch2_offset, sg_ch2_mult, (uint32_t*) dst, count / 2);
+    else if (sg_seq_on)
+    {
+        Seq_Fill(&sg_seq, &sg_dds, dst, count);
+        if (gate != RAMP_UNITY) Ramp_Gate(gate, dst, count);
+    }
+    else if (sg_mt_on)
+        MultiTone_Fill(&sg_mt, low, high, sg_dds.cal, dst, count);
+    else if (sg_params.form == WAVEFORM_NOISE_WHITE)
+        Noise_FillWhite(&sg_noise, p->low, p->high, dst, count);
+    else if (sg_params.form == WAVEFORM_NOISE_PINK)
+        Noise_FillPink(&sg_noise, p->low, p->high, dst, count);
+    else if (sg_exact)
+    {
+        FreqPlan_FillPeriod(exact_bank[exact_active], sg_plan.n, &sg_exact_index, dst, count);
+        if (low != sg_params.low || high != sg_params.high)
+            Ramp_Map(sg_params.low, sg_params.high, low, high, SG_DAC_MAX, dst, count);
+    }
+    else if (sg_mod.type != MODULATION_NONE && sg_params.form == WAVEFORM_SINE)
+        Modulation_Fill(&sg_mod, &sg_dds, p->low, p->high, dst, count);
+    else if (sg_dither.mode != DITHER_OFF && (sg_params.form == WAVEFORM_SINE
+             || sg_params.form == WAVEFORM_HARMONIC || sg_params.form == WAVEFORM_ARBITRARY))
+        Dither_FillScaled(&sg_dither, &sg_dds, p->low, p->high, dst, count);
+    else
+        Waveform_Fill(&sg_dds, p, dst, count);
+}
+
+// Відліки поточного стану в dst (halfword; у dual-режимі count / 2 слів)
+static void SignalGen_Render(uint16_t *dst, uint32_t count)
+{
+    const uint32_t step = sg_dual ? 2U : 1U;
+
+    if (sg_marker_mode != MARKER_OFF)
+    {
+        uint32_t *mk = &marker_buffer[(uint32_t)(dst - dac_buffer) / step];
+
+        SignalGen_FillMarker(mk, count / step);
+        SCB_CleanDCache_by_Addr(mk, count / step * sizeof(uint32_t));
+    }
+
+    // Рампа в уже відрендереному забороняє швидке перемикання (див. Retune)
+    if (Ramp_Active(&sg_ramp))
+        sg_ramp_blocks = 2;
+    else if (sg_ramp_blocks)
+        sg_ramp_blocks--;
+
+    if (!Ramp_Active(&sg_ramp))
+    {
+        // Спокій: ворота або відчинені, або вихід вимкнений і стоїть на нулі
+        if (sg_ramp.gate != 0U)
+            SignalGen_RenderLevels(sg_params.low, sg_params.high, RAMP_UNITY, dst, count);
+        else
+            for (uint32_t i = 0; i < count; i++) dst[i] = 0;
+    }
+    else
+    {
+        // Рампа: шматки по RAMP_CHUNK відліків, кожен зі своїми рівнями
+        uint16_t *p = dst;
+        uint32_t left = count;
+
+        while (left)
+        {
+            uint16_t low, high;
+            uint32_t gate;
+            uint32_t n = Ramp_Next(&sg_ramp, left / step, &low, &high, &gate) * step;
+
+            SignalGen_RenderLevels((uint16_t)((low * gate) >> 16), (uint16_t)((high * gate) >> 16),
+                                   gate, p, n);
+            p += n;
+            left -= n;
+        }
+    }
+    SCB_CleanDCache_by_Addr((uint32_t*) dst, count * sizeof(uint16_t));
+}
+
+static void SignalGen_FillBlock(void *ctx, uint16_t *dst, uint32_t count)
+{
+    uint32_t start = DWT->CYCCNT;
+
+    // PSC і ARR буферизовані (ARPE), тож обидва змінюються на одному update
+    if (sg_timer_countdown && --sg_timer_countdown == 0)
+        SignalGen_SetSampleTimer(sg_timer_psc, sg_timer_arr);
+
+    // Блок, з якого свіп починає (новий) прохід
+    sg_sweep_start = sg_sweep.active && sg_sweep.block == 0U;
+    if (sg_sweep.active)
+        sg_dds.tuning_word = Sweep_Next(&sg_sweep);
+
+    SignalGen_Render(dst, count);
+
+    // Час перегенерації блоку проти фіксованого бюджету
+    uint32_t us = (DWT->CYCCNT - start) / (SystemCoreClock / 1000000U);
+    if (us > sg_fill_us_max) sg_fill_us_max = us;
+    if (us > SG_FILL_BUDGET_US) sg_fill_overruns++;
+}
+
+// Перехід DDS <-> точний режим зберігає фазу, таймер - з наступного блоку
+static void SignalGen_CommitExact(void)
+{
+    if (sg_exact_next)
+    {
+        if (sg_exact)
+            sg_exact_index = (uint32_t)((uint64_t)sg_exact_index * sg_plan_next.n / sg_plan.n);
+        else
+            sg_exact_index = (uint32_t)(((uint64_t)sg_dds.phase * sg_plan_next.n) >> 32);
+        exact_active ^= 1U;
+        sg_plan = sg_plan_next;
+        sg_timer_psc = sg_plan.psc;
+        sg_timer_arr = sg_plan.arr;
+    }
+    else
+    {
+        if (sg_exact)
+            sg_dds.phase = (uint32_t)(((uint64_t)sg_exact_index << 32) / sg_plan.n);
+        sg_timer_psc = 0;
+        sg_timer_arr = SG_TIMER_CLK_HZ / SG_SAMPLE_RATE_HZ - 1U;
+    }
+    sg_exact = sg_exact_next;
+    sg_timer_countdown = 2;
+}
+
+// Викликається з ISR на межі половини буфера
+static void SignalGen_Commit(void *ctx)
+{
+    const uint16_t *table;
+    uint32_t bits;
+
+    if (harm_swap_pending)
+    {
+        harm_swap_pending = 0;
+        harm_active ^= 1U;
+    }
+    if (arb_swap_pending)
+    {
+        arb_swap_pending = 0;
+        arb_active ^= 1U;
+    }
+    sg_params = sg_params_next;
+    sg_zoh = sg_zoh_next;
+    if (sg_params.low != sg_ramp.to_low || sg_params.high != sg_ramp.to_high || sg_gate_next != sg_ramp.to_gate)
+        Ramp_To(&sg_ramp, sg_params.low, sg_params.high, sg_gate_next);
+    table = SignalGen_Table(sg_params.form, 0, &bits);
+    DDS_SetTable(&sg_dds, table, bits);
+    sg_ch2_offset = sg_ch2_offset_next;
+    sg_ch2_mult = sg_ch2_mult_next;
+
+    if (sg_dither.mode != sg_dither_next)
+        Dither_SetMode(&sg_dither, sg_dither_next);
+
+    uint32_t mod_phase = sg_mod.phase;
+    sg_mod = sg_mod_next;
+    sg_mod.phase = mod_phase;
+
+    if (sg_sweep_pending)
+    {
+        sg_sweep_pending = 0;
+        sg_sweep = sg_sweep_next;
+    }
+
+    if (sg_exact_pending)
+    {
+        sg_exact_pending = 0;
+        SignalGen_CommitExact();
+    }
+
+    if (sg_cal_pending)
+    {
+        sg_cal_pending = 0;
+        if (sg_cal_swap)
+        {
+            sg_cal_swap = 0;
+            cal_active ^= 1U;
+        }
+        sg_dds.cal = sg_cal_next_on ? cal_bank[cal_active] : NULL;
+    }
+
+    // Секвенція стартує з нуля фази на межі блоку; стоп повертає частоту DDS
+    if (sg_seq_pending)
+    {
+        sg_seq_pending = 0;
+        if (sg_seq_next_on)
+        {
+            if (!sg_seq_on) sg_seq_tuning = sg_dds.tuning_word;
+            sg_seq = sg_seq_next;
+            Seq_Rewind(&sg_seq, &sg_dds);
+        }
+        else if (sg_seq_on)
+            sg_dds.tuning_word = sg_seq_tuning;
+        sg_seq_on = sg_seq_next_on;
+    }
+
+    if (sg_mt_pending)
+    {
+        sg_mt_pending = 0;
+        if (sg_mt_next_on)
+            sg_mt = sg_mt_next;
+        sg_mt_on = sg_mt_next_on;
+    }
+}
+
+// NDTR рахує передачі DMA; потік рахує halfword
+static uint32_t SignalGen_DmaRemaining(void *ctx)
+{
+    uint32_t ndtr = __HAL_DMA_GET_COUNTER(hdac.DMA_Handle1);
+    return sg_dual ? ndtr * 2U : ndtr;
+}
+
+static void SignalGen_DmaHalfCplt(DMA_HandleTypeDef *hdma)
+{
+    SG_Stream_OnHalfDone(&sg_stream, 0);
+}
+
+static void SignalGen_DmaCplt(DMA_HandleTypeDef *hdma)
+{
+    SG_Stream_OnHalfDone(&sg_stream, 1);
+}
+
+static HAL_StatusTypeDef SignalGen_DmaWidth(uint32_t periph, uint32_t mem)
+{
+    DMA_HandleTypeDef *hdma = hdac.DMA_Handle1;
+
+    if (hdma->Init.PeriphDataAlignment == periph && hdma->Init.MemDataAlignment == mem)
+        return HAL_OK;
+
+    hdma->Init.PeriphDataAlignment = periph;
+    hdma->Init.MemDataAlignment = mem;
+    return HAL_DMA_Init(hdma);
+}
+
+// Один потік DMA1_Stream5 пише обидва канали через DHR12RD,
+// TIM7 TRGO оновлює їх одночасно
+static HAL_StatusTypeDef SignalGen_StartDual(void)
+{
+    DMA_HandleTypeDef *hdma = hdac.DMA_Handle1;
+
+    if (SignalGen_DmaWidth(DMA_PDATAALIGN_WORD, DMA_MDATAALIGN_WORD) != HAL_OK)
+        return HAL_ERROR;
+
+    hdma->XferHalfCpltCallback = SignalGen_DmaHalfCplt;
+    hdma->XferCpltCallback = SignalGen_DmaCplt;
+    hdma->XferErrorCallback = NULL;
+
+    SET_BIT(hdac.Instance->CR, DAC_CR_DMAEN1);
+    __HAL_DAC_ENABLE_IT(&hdac, DAC_IT_DMAUDR1);
+
+    if (HAL_DMA_Start_IT(hdma, (uint32_t) dac_buffer, (uint32_t) &hdac.Instance->DHR12RD,
+                         SG_BUFFER_SAMPLES) != HAL_OK)
+        return HAL_ERROR;
+
+    __HAL_DAC_ENABLE(&hdac, DAC_CHANNEL_1);
+    __HAL_DAC_ENABLE(&hdac, DAC_CHANNEL_2);
+    hdac.State = HAL_DAC_STATE_READY;
+    return HAL_OK;
+}
+
+static HAL_StatusTypeDef SignalGen_StartDac(void)
+{
+    if (sg_dual)
+        return SignalGen_StartDual();
+
+    if (SignalGen_DmaWidth(DMA_PDATAALIGN_HALFWORD, DMA_MDATAALIGN_HALFWORD) != HAL_OK)
+        return HAL_ERROR;
+    return HAL_DAC_Start_DMA(&hdac, DAC_CHANNEL_1, (uint32_t*) dac_buffer, SG_BUFFER_SAMPLES, DAC_ALIGN_12B_R);
+}
+
+// TIM8 лише рахує (без виходів); update -> запит DMA2_Stream1, канал 7.
+// DMA1 не дістає GPIO, тому мітка на DMA2 і таймері з APB2
+static HAL_StatusTypeDef SignalGen_MarkerInit(void)
+{
+    __HAL_RCC_TIM8_CLK_ENABLE();
+    __HAL_RCC_DMA2_CLK_ENABLE();
+
+    TIM8->CR1 = TIM_CR1_ARPE;
+    TIM8->RCR = 0;
+    SignalGen_MarkerTimer(htim7.Instance->PSC, htim7.Instance->ARR);
+    TIM8->EGR = TIM_EGR_UG;
+
+    hdma_marker.Instance = DMA2_Stream1;
+    hdma_marker.Init.Channel = DMA_CHANNEL_7;
+    hdma_marker.Init.Direction = DMA_MEMORY_TO_PERIPH;
+    hdma_marker.Init.PeriphInc = DMA_PINC_DISABLE;
+    hdma_marker.Init.MemInc = DMA_MINC_ENABLE;
+    hdma_marker.Init.PeriphDataAlignment = DMA_PDATAALIGN_WORD;
+    hdma_marker.Init.MemDataAlignment = DMA_MDATAALIGN_WORD;
+    hdma_marker.Init.Mode = DMA_CIRCULAR;
+    hdma_marker.Init.Priority = DMA_PRIORITY_LOW;
+    hdma_marker.Init.FIFOMode = DMA_FIFOMODE_DISABLE;
+    return HAL_DMA_Init(&hdma_marker);
+}
+
+// Кільце міток тієї ж довжини в переходах, що й кільце DAC (1024 в обох режимах)
+static HAL_StatusTypeDef SignalGen_StartMarker(void)
+{
+    TIM8->DIER &= ~TIM_DIER_UDE;
+    if (HAL_DMA_Start(&hdma_marker, (uint32_t) marker_buffer, (uint32_t) &TEST_PIN_GPIO_Port->BSRR,
+                      SG_BUFFER_SAMPLES) != HAL_OK)
+        return HAL_ERROR;
+    TIM8->DIER |= TIM_DIER_UDE;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef SignalGen_Start(void)
+{
+    HAL_StatusTypeDef st;
+    int run;
+
+    // Вбудований генератор DAC і PWM уже працюють без DMA
+    if (sg_hw_wave.kind != DACWAVE_OFF || sg_pwm_on)
+        return HAL_OK;
+
+    if (sg_marker_mode == MARKER_OFF)
+        return SignalGen_StartDac();
+
+    // Обидва потоки мають узяти перше слово на тому самому такті:
+    // таймери стоять, поки DMA озброюються, і рушають разом
+    run = (htim7.Instance->CR1 & TIM_CR1_CEN) != 0U;
+    SignalGen_RunClock(0);
+    st = SignalGen_StartDac();
+    if (st == HAL_OK)
+        st = SignalGen_StartMarker();
+    if (run)
+        SignalGen_RunClock(1);
+    return st;
+}
+
+static void SignalGen_Stop(void)
+{
+    // Зупиняє DMA1_Stream5 і знімає DMAEN1 в обох режимах
+    HAL_DAC_Stop_DMA(&hdac, DAC_CHANNEL_1);
+    if (sg_dual)
+        HAL_DAC_Stop(&hdac, DAC_CHANNEL_2);
+
+    if (sg_marker_mode != MARKER_OFF)
+    {
+        TIM8->DIER &= ~TIM_DIER_UDE;
+        HAL_DMA_Abort(&hdma_marker);
+    }
+}
+
+// Старт/стоп тактування DAC. З міткою TIM8 іде в ногу з TIM7: обидва
+// стартують поспіль, тож їхні update збігаються з постійним зсувом у
+// кілька тактів шини, і жоден потік DMA не обганяє інший
+void SignalGen_RunClock(int run)
+{
+    uint32_t primask = __get_PRIMASK();
+    int marker = (sg_marker_mode != MARKER_OFF);
+
+    __disable_irq();
+    htim7.Instance->CR1 &= ~TIM_CR1_CEN;
+    if (marker) TIM8->CR1 &= ~TIM_CR1_CEN;
+    if (run)
+    {
+        // UG на обох: лічильники й дільники з нуля; TRGO TIM7 і запит TIM8
+        // забирають рівно по одному слову з кожного кільця
+        if (marker)
+        {
+            htim7.Instance->EGR = TIM_EGR_UG;
+            TIM8->EGR = TIM_EGR_UG;
+        }
+        htim7.Instance->CR1 |= TIM_CR1_CEN;
+        if (marker) TIM8->CR1 |= TIM_CR1_CEN;
+    }
+    __set_PRIMASK(primask);
+}
+
+static void SignalGen_InitStream(void)
+{
+    uint32_t half = sg_dual ? SG_BUFFER_SAMPLES : SG_BUFFER_SAMPLES / 2;
 
-    for(int i = 0; i < SINE_SAMPLES; i++)
+    SG_Stream_Init(&sg_stream, dac_buffer, half,
+                   SignalGen_FillBlock, SignalGen_Commit, SignalGen_DmaRemaining, NULL);
+    // Усе, що чекало на межу блоку, застосовується до першого заповнення
+    SG_Stream_EndUpdate(&sg_stream);
+    SG_Stream_Prime(&sg_stream);
+}
+
+// Відрендерене наперед можна переписати, лише поки фаза лінійна в часі:
+// DDS зі сталим tuning word і без змін, прив'язаних до періоду таймера
+static int SignalGen_CanRetune(void)
+{
+    Waveform_t now = sg_params.form, next = sg_params_next.form;
+
+    return sg_hw_wave.kind == DACWAVE_OFF && !sg_pwm_on && !sg_exact && !sg_exact_pending && !sg_ramp_blocks
+        && !sg_seq_on && !sg_seq_pending && !sg_mt_on && !sg_mt_pending && !sg_sweep.active && !sg_sweep_pending
+        && sg_mod.type == MODULATION_NONE && sg_mod_next.type == MODULATION_NONE
+        && now != WAVEFORM_NOISE_WHITE && now != WAVEFORM_NOISE_PINK
+        && next != WAVEFORM_NOISE_WHITE && next != WAVEFORM_NOISE_PINK;
+}
+
+// Буфер від index (з переходом через кінець)
+static void SignalGen_RenderRun(uint32_t index, uint32_t count)
+{
+    uint32_t total = 2U * sg_stream.half_samples;
+
+    while (count)
+    {
+        uint32_t n = (total - index < count) ? total - index : count;
+
+        SignalGen_Render(&sg_stream.buffer[index], n);
+        index = (index + n) % total;
+        count -= n;
+    }
+}
+
+// Нова частота (і все, що чекає коміту) без очікування межі блоку.
+// Позиція DMA - з NDTR; фаза першого ще не прочитаного відліку - це фаза
+// кінця відрендерованого мінус ahead * старий tuning word. Звідти все
+// непрочитане перемальовується новим станом, тож фаза неперервна, а зміна
+// чутна через SG_RETUNE_GUARD_SAMPLES. Інакше - з наступного блоку, після
+// всього, що вже в буфері. Повертає затримку перемикання, мкс
+static uint32_t SignalGen_Retune(uint32_t tuning_word)
+{
+    const uint32_t step = sg_dual ? 2U : 1U;    // halfword на відлік
+    const uint32_t guard = SG_RETUNE_GUARD_SAMPLES * step;
+    uint32_t start = DWT->CYCCNT, primask = __get_PRIMASK();
+    uint32_t index = 0, ahead, head, us;
+
+    __disable_irq();
+    if (!SignalGen_CanRetune())
+    {
+        sg_dds.tuning_word = tuning_word;
+        ahead = SG_Stream_Ahead(&sg_stream, 0, &index);
+        __set_PRIMASK(primask);
+        sg_retune_us = (uint32_t)((uint64_t)(ahead / step) * 1000000U / SG_SAMPLE_RATE_HZ);
+        return sg_retune_us;
+    }
+
+    // Решту перемальовуємо, тримаючи лише переривання DMA: DMA рухається
+    // на відлік за мкс, рендер у десятки разів швидший
+    HAL_NVIC_DisableIRQ(DMA1_Stream5_IRQn);
+    ahead = SG_Stream_Ahead(&sg_stream, guard, &index);
+    us = (DWT->CYCCNT - start) / (SystemCoreClock / 1000000U)
+       + SG_RETUNE_GUARD_SAMPLES * 1000000U / SG_SAMPLE_RATE_HZ;
+    sg_dds.phase -= (ahead / step) * sg_dds.tuning_word;
+    sg_marker.carry = (sg_dds.phase - sg_dds.tuning_word) < sg_dds.tuning_word;
+    sg_dds.tuning_word = tuning_word;
+    SG_Stream_CommitNow(&sg_stream);
+
+    // Перший шматок укладається в захисний проміжок; якщо DMA за цей час
+    // дійшов далі index, один відлік уже прозвучав старим
+    head = (ahead < guard) ? ahead : guard;
+    SignalGen_RenderRun(index, head);
+    if (ahead && (index + 2U * sg_stream.half_samples - SG_Stream_Position(&sg_stream))
+                 % (2U * sg_stream.half_samples) > guard)
+        sg_retune_late++;
+    __set_PRIMASK(primask);
+
+    SignalGen_RenderRun((index + head) % (2U * sg_stream.half_samples), ahead - head);
+    HAL_NVIC_EnableIRQ(DMA1_Stream5_IRQn);
+
+    sg_retune_us = us;
+    return us;
+}
+
+// Частота, яку видавав би потік DMA (DDS або точний режим)
+static uint32_t SignalGen_StreamFrequency_mHz(void)
+{
+    if (sg_exact_next)
+        return FreqPlan_Frequency_mHz(&sg_plan_limits, &sg_plan_next);
+    return DDS_GetFrequency_mHz(&sg_dds);
+}
+
+// Задана частота, поки tuning word DDS їй відповідає (вище Найквіста теж);
+// інакше - та, що видає потік (точний режим, пресет, свіп)
+static uint32_t SignalGen_RequestedFrequency_mHz(void)
+{
+    if (!sg_exact_next && DDS_TuningWord_mHz(SG_SAMPLE_RATE_HZ, sg_freq_mhz) == sg_dds.tuning_word)
+        return sg_freq_mhz;
+    return SignalGen_StreamFrequency_mHz();
+}
+
+static void SignalGen_EnterHwWave(const DacWave_t *w)
+{
+    uint32_t mamp = (w->bits - 1U) << DAC_CR_MAMP1_Pos;
+
+    // WAVE1/MAMP1 міняються лише при вимкненому каналі
+    if (sg_hw_wave.kind == DACWAVE_OFF)
+        SignalGen_Stop();
+    else if (sg_hw_wave.kind != w->kind || sg_hw_wave.bits != w->bits)
+        HAL_DAC_Stop(&hdac, DAC_CHANNEL_1);
+
+    if (sg_hw_wave.kind != w->kind || sg_hw_wave.bits != w->bits)
     {
-        float angle = (2.0f * M_PI * i) / SINE_SAMPLES;
-        float sin_val = sinf(angle); // від -1 до +1
+        if (w->kind == DACWAVE_TRIANGLE)
+            HAL_DACEx_TriangleWaveGenerate(&hdac, DAC_CHANNEL_1, mamp);
+        else
+            HAL_DACEx_NoiseWaveGenerate(&hdac, DAC_CHANNEL_1, mamp);
+    }
+    HAL_DAC_SetValue(&hdac, DAC_CHANNEL_1, DAC_ALIGN_12B_R, w->base);
+    HAL_DAC_Start(&hdac, DAC_CHANNEL_1);
+
+    // TIM7 TRGO крокує лічильник DAC; ARPE - новий період з наступного update
+    sg_timer_countdown = 0;
+    SignalGen_SetSampleTimer(w->timer.psc, w->timer.arr);
+    sg_hw_wave = *w;
+}
+
+// Лише вимикає вбудований генератор; потік DMA перезапускає викликач
+static void SignalGen_LeaveHwWave(void)
+{
+    HAL_DAC_Stop(&hdac, DAC_CHANNEL_1);
+    CLEAR_BIT(hdac.Instance->CR, DAC_CR_WAVE1 | DAC_CR_MAMP1);
+    sg_hw_wave.kind = DACWAVE_OFF;
+
+    SignalGen_SetSampleTimer(sg_timer_psc, sg_timer_arr);
+}
+
+// TIM1 (APB2, не зайнятий: TIM8 крокує мітку) CH1 на PA8 - Arduino D10.
+// PWM mode 1; PSC, ARR і CCR1 буферизовані, тож нова частота чи скважність
+// діють з наступного періоду без обрізаного імпульсу
+static void SignalGen_PwmInit(void)
+{
+    GPIO_InitTypeDef gpio = { 0 };
+
+    __HAL_RCC_TIM1_CLK_ENABLE();
+    __HAL_RCC_GPIOA_CLK_ENABLE();
+
+    gpio.Pin = PWM_OUT_Pin;
+    gpio.Mode = GPIO_MODE_AF_PP;
+    gpio.Pull = GPIO_NOPULL;
+    gpio.Speed = GPIO_SPEED_FREQ_VERY_HIGH;
+    gpio.Alternate = GPIO_AF1_TIM1;
+    HAL_GPIO_Init(PWM_OUT_GPIO_Port, &gpio);
+
+    TIM1->CR1 = TIM_CR1_ARPE;
+    TIM1->RCR = 0;
+    TIM1->CCMR1 = TIM_CCMR1_OC1PE | TIM_CCMR1_OC1M_2;      // примусово низький
+    TIM1->CCER = TIM_CCER_CC1E;
+    TIM1->BDTR = TIM_BDTR_MOE;
+}
+
+static void SignalGen_EnterPwm(const PwmPlan_t *plan)
+{
+    static uint8_t ready = 0;
+
+    if (sg_pwm_on)
+    {
+        TIM1->PSC = plan->psc;
+        TIM1->ARR = plan->arr;
+        TIM1->CCR1 = plan->ccr;
+    }
+    else
+    {
+        // DAC тримає нижній рівень; потік DMA стоїть
+        if (sg_hw_wave.kind != DACWAVE_OFF)
+            SignalGen_LeaveHwWave();
+        else
+            SignalGen_Stop();
+        HAL_DAC_SetValue(&hdac, DAC_CHANNEL_1, DAC_ALIGN_12B_R, sg_params_next.low);
+        HAL_DAC_Start(&hdac, DAC_CHANNEL_1);
+
+        if (!ready) SignalGen_PwmInit();
+        ready = 1;
+        TIM1->PSC = plan->psc;
+        TIM1->ARR = plan->arr;
+        TIM1->CCR1 = plan->ccr;
+        // UG переносить тіньові регістри, тоді вихід з низького в PWM
+        TIM1->EGR = TIM_EGR_UG;
+        TIM1->CCMR1 = TIM_CCMR1_OC1PE | TIM_CCMR1_OC1M_2 | TIM_CCMR1_OC1M_1;
+        TIM1->CR1 |= TIM_CR1_CEN;
+    }
+    sg_pwm = *plan;
+    sg_pwm_on = 1;
+}
+
+// Вихід одразу в низький, лічильник стоп; потік DMA перезапускає викликач
+static void SignalGen_LeavePwm(void)
+{
+    TIM1->CCMR1 = TIM_CCMR1_OC1PE | TIM_CCMR1_OC1M_2;
+    TIM1->CR1 &= ~TIM_CR1_CEN;
+    HAL_DAC_Stop(&hdac, DAC_CHANNEL_1);
+    sg_pwm_on = 0;
+}
 
-        // Пряме масштабування: -1→0, +1→max_dac_val
-        float value = (sin_val + 1.0f) * max_dac_val / 2.0f;
+// Трикутник і білий шум переходять на вбудований генератор DAC, коли розмах
+// 2^n - 1, частота досяжна дільником TIM7 і нічого не модулює сигнал.
+// Меандр та імпульси від SG_PWM_MIN_FREQ_HZ - на TIM1, де DAC уже дає
+// надто мало відліків на період. Викликати з задачі після кожної зміни параметрів
+static void SignalGen_SelectBackend(void)
+{
+    DacWave_t w;
+    PwmPlan_t pwm;
+    const WaveParams_t *p = &sg_params_next;
+    uint32_t freq = SignalGen_RequestedFrequency_mHz();
+    int hw = 0, timer = 0;
 
-        if(value < 0.0f) value = 0.0f;
-        if(value > max_dac_val) value = max_dac_val;
+    if (sg_hw_auto && sg_gate_next == RAMP_UNITY && !sg_dual && !sg_seq_next_on && !sg_mt_next_on
+        && !sg_cal_next_on
+        && !SignalGen_IsSweeping()
+        && sg_mod_next.type == MODULATION_NONE)
+    {
+        if (p->form == WAVEFORM_TRIANGLE)
+            hw = DacWave_PlanTriangle(&sg_hw_limits, p->low, p->high,
+                                      SignalGen_StreamFrequency_mHz(), &w);
+        else if (p->form == WAVEFORM_NOISE_WHITE && sg_noise.lp_coeff == 32768)
+            hw = DacWave_PlanNoise(&sg_hw_limits, p->low, p->high, &w);
+        else if ((p->form == WAVEFORM_SQUARE || p->form == WAVEFORM_PULSE)
+                 && freq >= SG_PWM_MIN_FREQ_HZ * 1000U)
+            timer = PwmOut_Plan(SG_PWM_TIMER_CLK_HZ, freq,
+                                (p->form == WAVEFORM_SQUARE) ? 0x80000000U : p->duty,
+                                SG_PWM_TOLERANCE_PPM, &pwm);
+    }
 
-        sine_table[i] = (uint16_t)value;
+    if (timer)
+        SignalGen_EnterPwm(&pwm);
+    else if (hw)
+    {
+        if (sg_pwm_on) SignalGen_LeavePwm();
+        SignalGen_EnterHwWave(&w);
+    }
+    else if (sg_hw_wave.kind != DACWAVE_OFF || sg_pwm_on)
+    {
+        if (sg_pwm_on)
+            SignalGen_LeavePwm();
+        else
+            SignalGen_LeaveHwWave();
+        SignalGen_InitStream();
+        SignalGen_Start();
     }
-    volatile uint16_t val_0 = sine_table[0];
-    volatile uint16_t val_quarter = sine_table[128];
-    volatile uint16_t val_half = sine_table[256];
-    volatile uint16_t val_3quarter = sine_table[384];
+}
 
-    debug("Val 0 = %u\n", val_0);
-    debug("val_quarter = %u\n", val_quarter);
-    debug("val_half = %u\n", val_half);
-    debug("val_3quarter = %u\n", val_3quarter);
+// DMA2_Stream0 пам'ять -> пам'ять (лише DMA2 це вміє): слова пакетами по 4
+// через FIFO, тож QSPI віддає таблицю довгими читаннями. Без переривань
+static HAL_StatusTypeDef SignalGen_CopyInit(void)
+{
+    __HAL_RCC_DMA2_CLK_ENABLE();
+
+    hdma_copy.Instance = DMA2_Stream0;
+    hdma_copy.Init.Channel = DMA_CHANNEL_0;
+    hdma_copy.Init.Direction = DMA_MEMORY_TO_MEMORY;
+    hdma_copy.Init.PeriphInc = DMA_PINC_ENABLE;
+    hdma_copy.Init.MemInc = DMA_MINC_ENABLE;
+    hdma_copy.Init.PeriphDataAlignment = DMA_PDATAALIGN_WORD;
+    hdma_copy.Init.MemDataAlignment = DMA_MDATAALIGN_WORD;
+    hdma_copy.Init.Mode = DMA_NORMAL;
+    hdma_copy.Init.Priority = DMA_PRIORITY_LOW;
+    hdma_copy.Init.FIFOMode = DMA_FIFOMODE_ENABLE;
+    hdma_copy.Init.FIFOThreshold = DMA_FIFO_THRESHOLD_FULL;
+    hdma_copy.Init.MemBurst = DMA_MBURST_INC4;
+    hdma_copy.Init.PeriphBurst = DMA_PBURST_INC4;
+    return HAL_DMA_Init(&hdma_copy);
+}
+
+// Таблиця з пресета в банк RAM (вирівняний на 32 байти). Довжина
+// округлюється до пакета в 16 байт: банки й слоти мають запас
+static void SignalGen_CopyTable(uint16_t *dst, const uint16_t *src, uint32_t samples)
+{
+    uint32_t bytes = (samples * sizeof(uint16_t) + 31U) & ~31U;
+
+    SCB_CleanInvalidateDCache_by_Addr((uint32_t*) dst, bytes);
+    if (HAL_DMA_Start(&hdma_copy, (uint32_t) src, (uint32_t) dst, bytes / 4U) != HAL_OK
+        || HAL_DMA_PollForTransfer(&hdma_copy, HAL_DMA_FULL_TRANSFER, 10) != HAL_OK)
+    {
+        HAL_DMA_Abort(&hdma_copy);
+        for (uint32_t i = 0; i < samples; i++)
+            dst[i] = src[i];
+        return;
+    }
+    SCB_InvalidateDCache_by_Addr((uint32_t*) dst, bytes);
+}
+
+// Нова довільна таблиця в неактивний банк; викликати між Begin/EndUpdate
+static void SignalGen_LoadArbitrary(const uint16_t *table, uint32_t bits)
+{
+    uint32_t b = arb_active ^ 1U;
+
+    SignalGen_CopyTable(arb_bank[b], table, 1U << bits);
+    arb_bits[b] = bits;
+    arb_swap_pending = 1;
+}
+
+static int SignalGen_FlashErase(uint32_t addr)
+{
+    return QSPI_EraseSector(addr) == HAL_OK;
+}
+
+static int SignalGen_FlashProgram(uint32_t addr, const void *data, uint32_t len)
+{
+    return QSPI_Program(addr, data, len) == HAL_OK;
+}
+
+// Знову відображена в пам'ять; рядки кешу з регіону пресетів застаріли
+static void SignalGen_FlashEnd(void)
+{
+    QSPI_EndWrite();
+    SCB_InvalidateDCache_by_Addr((uint32_t*) (QSPI_BASE + SG_PRESET_OFFSET), PRESET_REGION_BYTES);
+}
+
+static const PresetFlash_t sg_preset_flash =
+{
+    (const uint8_t*) (QSPI_BASE + SG_PRESET_OFFSET), SG_PRESET_OFFSET,
+    SignalGen_FlashErase, SignalGen_FlashProgram, QSPI_BeginWrite, SignalGen_FlashEnd
+};
+
+void SignalGen_Init(void)
+{
+    // DWT лічильник тактів для вимірювання бюджету
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->LAR = 0xC5ACCE55;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    // Буферизований ARR: точний режим міняє період TIM7 на льоту
+    htim7.Instance->CR1 |= TIM_CR1_ARPE;
+
+    sg_params_next.form = WAVEFORM_SINE;
+    sg_params_next.duty = Waveform_DutyFromPermille(500);
+    sg_params_next.low = 0;
+    sg_params_next.high = 0;
+    sg_params_next.band_limited = 1;
+    sg_params = sg_params_next;
+    Ramp_Init(&sg_ramp, 0, 0, 0, SG_RAMP_SAMPLES);
+
+    Noise_Init(&sg_noise, DWT->CYCCNT);
+    Dither_Init(&sg_dither, DWT->CYCCNT ^ 0x5A5A5A5AU);
+
+    Modulation_Init(&sg_mod_next, WaveTable_Get(WAVE_SINE), WAVE_TABLE_BITS, SG_SAMPLE_RATE_HZ);
+    Modulation_SetRate_mHz(&sg_mod_next, SG_DEFAULT_MOD_RATE_HZ * 1000U);
+    sg_mod = sg_mod_next;
+
+    WaveTable_OffsetBinary(sine_norm, WaveTable_Get(WAVE_SINE), SINE_SAMPLES);
+    DDS_Init(&sg_dds, sine_norm, SINE_TABLE_BITS, SG_SAMPLE_RATE_HZ);
+
+    // Поки гармоніки чи довільна форма не задані - чистий синус в обох банках
+    for (uint32_t b = 0; b < 2U; b++)
+        for (uint32_t i = 0; i < SINE_SAMPLES; i++)
+            harm_bank[b][i] = arb_bank[b][i] = sine_norm[i];
+    DDS_SetFrequency_mHz(&sg_dds, SG_DEFAULT_FREQ_HZ * 1000U);
+
+    // QSPI уже відображена (MX_QUADSPI_Init); скан перевіряє CRC усіх таблиць
+    SignalGen_CopyInit();
+    Preset_Init(&sg_presets, &sg_preset_flash);
+
+    SignalGen_InitStream();
+}
+
+// Перемикання режиму перезапускає DMA: викликати з задачі, не з ISR
+void SignalGen_SetDualChannel(int enable)
+{
+    uint8_t dual = enable ? 1U : 0U;
+
+    if (dual == sg_dual) return;
+
+    if (sg_hw_wave.kind != DACWAVE_OFF)
+        SignalGen_LeaveHwWave();
+    else if (sg_pwm_on)
+        SignalGen_LeavePwm();
+    else
+        SignalGen_Stop();
+    SignalGen_LeaveExact();
+    if (dual && sg_seq_next_on)
+    {
+        sg_seq_next_on = 0;
+        sg_seq_pending = 1;
+    }
+    if (dual && sg_mt_next_on)
+    {
+        sg_mt_next_on = 0;
+        sg_mt_pending = 1;
+    }
+    sg_dual = dual;
+    SignalGen_InitStream();
+    SignalGen_Start();
+}
+
+int SignalGen_IsDualChannel(void)
+{
+    return sg_dual;
+}
+
+void SignalGen_SetPhaseOffset_deg(uint32_t degrees)
+{
+    SG_Stream_BeginUpdate(&sg_stream);
+    sg_ch2_offset_next = DualDac_PhaseFromDegrees(degrees);
+    SG_Stream_EndUpdate(&sg_stream);
+}
+
+void SignalGen_SetChannel2Multiplier(uint32_t mult)
+{
+    SG_Stream_BeginUpdate(&sg_stream);
+    sg_ch2_mult_next = mult ? mult : 1U;
+    SG_Stream_EndUpdate(&sg_stream);
+}
+
+void SignalGen_SetFrequency_mHz(uint32_t freq_mhz)
+{
+    // Фіксована частота скасовує свіп (інакше ISR перепише tuning word)
+    if (SignalGen_IsSweeping())
+        SignalGen_StopSweep();
+
+    if (sg_exact_next)
+    {
+        SG_Stream_BeginUpdate(&sg_stream);
+        SignalGen_LeaveExact();
+        SG_Stream_EndUpdate(&sg_stream);
+    }
+
+    // Фаза не рветься; під час секвенції частота діє після її зупинки
+    sg_freq_mhz = freq_mhz;
+    sg_seq_tuning = DDS_TuningWord_mHz(SG_SAMPLE_RATE_HZ, freq_mhz);
+    SignalGen_Retune(sg_seq_tuning);
+    SignalGen_RetuneHarmonics();
+    SignalGen_SelectBackend();
+}
+
+// Точна частота: підбір (PSC, ARR, N), таблиця періоду і таймер - одним комітом.
+// Повертає реально встановлену частоту
+uint32_t SignalGen_SetFrequencyExact_mHz(uint32_t freq_mhz)
+{
+    FreqPlan_t plan;
+    Waveform_t form = sg_params_next.form;
+
+    // Точний режим лише для простого періодичного сигналу, решта - через DDS
+    if (sg_dual || sg_seq_next_on || sg_mt_next_on || SignalGen_IsSweeping()
+        || sg_mod_next.type != MODULATION_NONE || form == WAVEFORM_NOISE_WHITE || form == WAVEFORM_NOISE_PINK
+        || !FreqPlan_Search(&sg_plan_limits, freq_mhz, &plan))
+    {
+        SignalGen_SetFrequency_mHz(freq_mhz);
+        return SignalGen_GetFrequency_mHz();
+    }
+
+    SG_Stream_BeginUpdate(&sg_stream);
+    sg_plan_next = plan;
+    sg_exact_next = 1;
+    if (sg_zoh_next && sg_harm_set && form == WAVEFORM_HARMONIC)
+        SignalGen_BuildHarmonics();
+    SignalGen_BuildExactTable();
+    SG_Stream_EndUpdate(&sg_stream);
+    SignalGen_SelectBackend();
+
+    return SignalGen_GetFrequency_mHz();
+}
+
+uint32_t SignalGen_GetFrequency_mHz(void)
+{
+    if (sg_hw_wave.kind == DACWAVE_TRIANGLE)
+        return DacWave_Frequency_mHz(&sg_hw_limits, &sg_hw_wave);
+    if (sg_pwm_on)
+        return PwmOut_Frequency_mHz(SG_PWM_TIMER_CLK_HZ, &sg_pwm);
+    return SignalGen_StreamFrequency_mHz();
+}
+
+void SignalGen_SetWaveform(Waveform_t form)
+{
+    if (form >= WAVEFORM_COUNT) form = WAVEFORM_SINE;
+
+    SG_Stream_BeginUpdate(&sg_stream);
+    sg_params_next.form = form;
+    if (form == WAVEFORM_HARMONIC && sg_zoh_next && sg_harm_set)
+        SignalGen_BuildHarmonics();
+    if (form == WAVEFORM_NOISE_WHITE || form == WAVEFORM_NOISE_PINK)
+        SignalGen_LeaveExact();
+    else if (sg_exact_next)
+        SignalGen_BuildExactTable();
+    SG_Stream_EndUpdate(&sg_stream);
+    SignalGen_Retune(sg_dds.tuning_word);
+    SignalGen_SelectBackend();
+}
+
+Waveform_t SignalGen_GetWaveform(void)
+{
+    return sg_params_next.form;
+}
+
+void SignalGen_SetDuty_permille(uint32_t permille)
+{
+    SG_Stream_BeginUpdate(&sg_stream);
+    sg_params_next.duty = Waveform_DutyFromPermille(permille);
+    if (sg_exact_next) SignalGen_BuildExactTable();
+    SG_Stream_EndUpdate(&sg_stream);
+}
+
+void SignalGen_SetBandLimited(int enable)
+{
+    SG_Stream_BeginUpdate(&sg_stream);
+    sg_params_next.band_limited = enable ? 1U : 0U;
+    if (sg_exact_next) SignalGen_BuildExactTable();
+    SG_Stream_EndUpdate(&sg_stream);
+}
+
+// Свіп стартує з межі наступного блоку; старий зупиняється там же
+int SignalGen_StartSweep(uint32_t start_mhz, uint32_t stop_mhz, uint32_t duration_ms,
+                         SweepMode_t mode, int repeat)
+{
+    int ok;
+
+    SG_Stream_BeginUpdate(&sg_stream);
+    SignalGen_LeaveExact();
+    ok = Sweep_Setup(&sg_sweep_next, SG_SAMPLE_RATE_HZ, SG_BUFFER_SAMPLES / 2,
+                     start_mhz, stop_mhz, duration_ms, mode, repeat);
+    sg_sweep_pending = 1;
+    SG_Stream_EndUpdate(&sg_stream);
+    SignalGen_SelectBackend();
+    return ok;
+}
+
+void SignalGen_StopSweep(void)
+{
+    SG_Stream_BeginUpdate(&sg_stream);
+    sg_sweep_next.active = 0;
+    sg_sweep_pending = 1;
+    SG_Stream_EndUpdate(&sg_stream);
+}
+
+int SignalGen_IsSweeping(void)
+{
+    return sg_sweep.active || sg_sweep_pending;
+}
+
+uint32_t SignalGen_GetSweepPosition_permille(void)
+{
+    return Sweep_Position_permille(&sg_sweep);
+}
+
+// 0 - повна смуга (fs/2); одне слово, ISR підхопить з наступного відліку
+void SignalGen_SetNoiseBandwidth_Hz(uint32_t bandwidth_hz)
+{
+    Noise_SetBandwidth_Hz(&sg_noise, SG_SAMPLE_RATE_HZ, bandwidth_hz);
+    SignalGen_SelectBackend();
+}
+
+// amount: AM - глибина ‰, FM - девіація мГц, PM - індекс мрад
+void SignalGen_SetModulation(ModulationType_t type, uint32_t amount, uint32_t rate_mhz)
+{
+    SG_Stream_BeginUpdate(&sg_stream);
+    if (type != MODULATION_NONE) SignalGen_LeaveExact();
+    Modulation_SetRate_mHz(&sg_mod_next, rate_mhz);
+    switch (type)
+    {
+    case MODULATION_AM: Modulation_SetAM(&sg_mod_next, amount); break;
+    case MODULATION_FM: Modulation_SetFM(&sg_mod_next, amount); break;
+    case MODULATION_PM: Modulation_SetPM(&sg_mod_next, amount); break;
+    default:            Modulation_Off(&sg_mod_next);           break;
+    }
+    SG_Stream_EndUpdate(&sg_stream);
+    SignalGen_SelectBackend();
+}
+
+// Адитивний синтез: таблиця періоду з гармонік, нормована на повну шкалу.
+// Будується в задачі (~N x K MAC), стає активною на межі блоку
+void SignalGen_SetHarmonics(const Harmonics_t *h)
+{
+    sg_harm = *h;
+    sg_harm_set = 1;
+
+    SG_Stream_BeginUpdate(&sg_stream);
+    SignalGen_BuildHarmonics();
+    if (sg_exact_next && sg_params_next.form == WAVEFORM_HARMONIC)
+        SignalGen_BuildExactTable();
+    SG_Stream_EndUpdate(&sg_stream);
+}
+
+// Довільна форма: нормований період (offset binary, 0x8000 - середина),
+// 2^bits відліків. Стає активною на межі блоку; форму обирає SetWaveform
+int SignalGen_SetArbitrary(const uint16_t *table, uint32_t bits)
+{
+    if (bits < SG_ARB_MIN_BITS || bits > SG_ARB_MAX_BITS)
+        return 0;
+
+    SG_Stream_BeginUpdate(&sg_stream);
+    SignalGen_LoadArbitrary(table, bits);
+    if (sg_exact_next && sg_params_next.form == WAVEFORM_ARBITRARY)
+        SignalGen_BuildExactTable();
+    SG_Stream_EndUpdate(&sg_stream);
+    return 1;
+}
+
+// Поточний стан у слот: параметри, а для точного режиму, гармонік і
+// довільної форми - ще й готова таблиця (гармоніки відновлюються як ARB).
+// Свіп і секвенція не зберігаються. Стирання й запис блокують на десятки
+// мс, QSPI у цей час не відображена - викликати з задачі TouchGFX
+int SignalGen_SavePreset(uint32_t slot, const char *name)
+{
+    PresetHeader_t h = { 0 };
+    const uint16_t *table = NULL;
+    uint32_t bits;
+
+    if (sg_seq_next_on || sg_mt_next_on || SignalGen_IsSweeping())
+        return 0;
+
+    // Банк, що стане активним, - під тим самим замком, що й коміт
+    SG_Stream_BeginUpdate(&sg_stream);
+    h.form = (uint8_t) sg_params_next.form;
+    h.duty = sg_params_next.duty;
+    h.low = sg_params_next.low;
+    h.high = sg_params_next.high;
+    h.band_limited = sg_params_next.band_limited;
+    if (sg_exact_next)
+    {
+        h.kind = PRESET_EXACT;
+        h.psc = sg_plan_next.psc;
+        h.arr = sg_plan_next.arr;
+        h.samples = sg_plan_next.n;
+        h.freq_mhz = FreqPlan_Frequency_mHz(&sg_plan_limits, &sg_plan_next);
+        table = exact_bank[sg_exact_pending ? exact_active ^ 1U : exact_active];
+    }
+    else
+    {
+        h.kind = PRESET_DDS;
+        h.freq_mhz = SignalGen_RequestedFrequency_mHz();
+        if (sg_params_next.form == WAVEFORM_HARMONIC || sg_params_next.form == WAVEFORM_ARBITRARY)
+        {
+            table = SignalGen_Table(sg_params_next.form, 1, &bits);
+            h.samples = 1U << bits;
+            h.form = WAVEFORM_ARBITRARY;
+        }
+    }
+    SG_Stream_EndUpdate(&sg_stream);
+
+    return Preset_Save(&sg_presets, slot, name, &h, table);
+}
+
+// Пресет зі слота: таблиця DMA-копією з QSPI у неактивний банк, далі як
+// звичайна зміна форми. DDS-пресет застосовується через Retune (звучить
+// за SG_RETUNE_GUARD_SAMPLES від DMA), точний - на межі блоку з таймером
+int SignalGen_RecallPreset(uint32_t slot)
+{
+    const PresetHeader_t *h = Preset_Header(&sg_presets, slot);
+    const uint16_t *table = Preset_Table(&sg_presets, slot);
+    uint32_t start = DWT->CYCCNT, bits = 0, index, us;
+
+    if (h == NULL || h->form >= WAVEFORM_COUNT)
+        return 0;
+    if (h->kind == PRESET_EXACT)
+    {
+        if (sg_dual || table == NULL || h->samples < SG_EXACT_MIN_SAMPLES || h->samples > SG_EXACT_MAX_SAMPLES)
+            return 0;
+    }
+    else if (table != NULL)
+    {
+        while ((1U << bits) < h->samples) bits++;
+        if ((1U << bits) != h->samples || bits < SG_ARB_MIN_BITS || bits > SG_ARB_MAX_BITS)
+            return 0;
+    }
+
+    if (SignalGen_IsSweeping())
+        SignalGen_StopSweep();
+    SignalGen_StopSequence();
+
+    SG_Stream_BeginUpdate(&sg_stream);
+    sg_params_next.form = (Waveform_t) h->form;
+    sg_params_next.duty = h->duty;
+    sg_params_next.low = h->low;
+    sg_params_next.high = h->high;
+    sg_params_next.band_limited = h->band_limited;
+    if (h->kind == PRESET_EXACT)
+    {
+        // Таблиця вже в кодах DAC для цього плану - лише копія
+        SignalGen_CopyTable(exact_bank[exact_active ^ 1U], table, h->samples);
+        sg_plan_next.psc = h->psc;
+        sg_plan_next.arr = h->arr;
+        sg_plan_next.n = h->samples;
+        sg_plan_next.k = (h->psc + 1U) * (h->arr + 1U) * h->samples;
+        Modulation_Off(&sg_mod_next);
+        sg_exact_next = 1;
+        sg_exact_pending = 1;
+    }
+    else
+    {
+        SignalGen_LeaveExact();
+        if (table != NULL)
+            SignalGen_LoadArbitrary(table, bits);
+    }
+    SG_Stream_EndUpdate(&sg_stream);
+
+    us = (DWT->CYCCNT - start) / (SystemCoreClock / 1000000U);
+    if (h->kind == PRESET_EXACT)
+        // Новий період звучить після всього, що вже в буфері, у старому темпі
+        us += (uint32_t)((uint64_t)SG_Stream_Ahead(&sg_stream, 0, &index)
+                         * (htim7.Instance->PSC + 1U) * (htim7.Instance->ARR + 1U)
+                         / (SG_TIMER_CLK_HZ / 1000000U));
+    else
+    {
+        sg_freq_mhz = h->freq_mhz;
+        sg_seq_tuning = DDS_TuningWord_mHz(SG_SAMPLE_RATE_HZ, h->freq_mhz);
+        us += SignalGen_Retune(sg_seq_tuning);
+    }
+    SignalGen_SelectBackend();
+
+    sg_recall_us = us;
+    return 1;
+}
+
+const PresetStore_t *SignalGen_GetPresets(void)
+{
+    return &sg_presets;
+}
+
+// Вирівнювання АЧХ утримання відліку; за замовчуванням увімкнене
+void SignalGen_SetZohCompensation(int enable)
+{
+    SG_Stream_BeginUpdate(&sg_stream);
+    sg_zoh_next = enable ? 1U : 0U;
+    if (sg_harm_set) SignalGen_BuildHarmonics();
+    if (sg_exact_next) SignalGen_BuildExactTable();
+    SG_Stream_EndUpdate(&sg_stream);
+}
+
+// Калібрування з виміряних точок (код, мкВ); pts == NULL вимикає корекцію.
+// Точки знімаються без корекції: SetAmplitudeOffset(0, DacCal_ProbeCode(i, n))
+// і вимір на PA4. Шум не коригується; dual-режим бере ту ж таблицю для PA5
+int SignalGen_SetCalibration(const DacCalPoint_t *pts, uint32_t count, int32_t vref_uv)
+{
+    int ok = 1;
+
+    SG_Stream_BeginUpdate(&sg_stream);
+    if (pts == NULL || count == 0U)
+        sg_cal_next_on = 0;
+    else if ((ok = DacCal_Build(pts, count, vref_uv, cal_bank[cal_active ^ 1U])) != 0)
+    {
+        sg_cal_swap = 1;
+        sg_cal_next_on = 1;
+    }
+    sg_cal_pending = 1;
+    if (sg_exact_next) SignalGen_BuildExactTable();
+    SG_Stream_EndUpdate(&sg_stream);
+    SignalGen_SelectBackend();
+    return ok;
+}
+
+int SignalGen_IsCalibrated(void)
+{
+    return sg_cal_next_on;
+}
+
+// Дрібні амплітуди без сходинок: TPDF або TPDF + формування шуму 2-го
+// порядку (шум квантування зсувається до fs/2). Лише табличні форми
+void SignalGen_SetDither(DitherMode_t mode)
+{
+    SG_Stream_BeginUpdate(&sg_stream);
+    sg_dither_next = mode;
+    SG_Stream_EndUpdate(&sg_stream);
+}
+
+DitherMode_t SignalGen_GetDither(void)
+{
+    return sg_dither_next;
+}
+
+static uint32_t SignalGen_Cycles(void)
+{
+    return DWT->CYCCNT;
+}
+
+// Послідовність сегментів без пауз; TIM7 лишається на 1 MS/s, тож межі
+// сегментів точні до відліку. seq будується задачею: Seq_Init(.., SG_SAMPLE_RATE_HZ, NULL) + Seq_Add
+int SignalGen_StartSequence(const Sequencer_t *seq)
+{
+    if (sg_dual || seq->count == 0U)
+        return 0;
+
+    if (SignalGen_IsSweeping())
+        SignalGen_StopSweep();
+
+    SG_Stream_BeginUpdate(&sg_stream);
+    SignalGen_LeaveExact();
+    sg_seq_next = *seq;
+    sg_seq_next.cycles = SignalGen_Cycles;
+    sg_seq_next_on = 1;
+    sg_seq_pending = 1;
+    if (sg_mt_next_on)
+    {
+        sg_mt_next_on = 0;
+        sg_mt_pending = 1;
+    }
+    SG_Stream_EndUpdate(&sg_stream);
+    SignalGen_SelectBackend();
+    return 1;
+}
+
+void SignalGen_StopSequence(void)
+{
+    if (!sg_seq_next_on) return;
+
+    SG_Stream_BeginUpdate(&sg_stream);
+    sg_seq_next_on = 0;
+    sg_seq_pending = 1;
+    SG_Stream_EndUpdate(&sg_stream);
+    SignalGen_SelectBackend();
+}
+
+int SignalGen_IsSequencing(void)
+{
+    return sg_seq_next_on;
+}
+
+// Накладні витрати на сегмент (такти) і найкоротший сегмент (мкс), який
+// вкладається в SG_FILL_BUDGET_US; 0 - ще мало вимірів
+void SignalGen_GetSequenceOverhead(uint32_t *overhead_cycles, uint32_t *min_segment_us)
+{
+    uint32_t slope_q8 = 0, primask = __get_PRIMASK();
+    uint32_t budget = SG_FILL_BUDGET_US * (SystemCoreClock / 1000000U);
+    SeqStats_t st;
+
+    __disable_irq();
+    st = sg_seq.stats;
+    __set_PRIMASK(primask);
+
+    *overhead_cycles = 0;
+    Seq_Overhead(&st, overhead_cycles, &slope_q8);
+    *min_segment_us = (uint32_t)((uint64_t)Seq_MinSegment_samples(&st, SG_BUFFER_SAMPLES / 2, budget)
+                                 * 1000000U / SG_SAMPLE_RATE_HZ);
+    debug("seq: %lu cycles/segment, %lu.%02lu cycles/sample, min segment %lu us\n",
+          *overhead_cycles, slope_q8 >> 8, ((slope_q8 & 0xFFU) * 100U) >> 8, *min_segment_us);
+}
+
+// Набір тонів замість форми; рівні low/high, ворота й рампи - ті самі.
+// mt будується задачею: MultiTone_Init(.., SignalGen_MultiToneTable(), ..) + MultiTone_Add
+int SignalGen_StartMultiTone(const MultiTone_t *mt)
+{
+    if (sg_dual || mt->count == 0U)
+        return 0;
+
+    if (SignalGen_IsSweeping())
+        SignalGen_StopSweep();
+
+    SG_Stream_BeginUpdate(&sg_stream);
+    SignalGen_LeaveExact();
+    sg_mt_next = *mt;
+    sg_mt_next_on = 1;
+    sg_mt_pending = 1;
+    if (sg_seq_next_on)
+    {
+        sg_seq_next_on = 0;
+        sg_seq_pending = 1;
+    }
+    SG_Stream_EndUpdate(&sg_stream);
+    SignalGen_SelectBackend();
+    return 1;
+}
+
+void SignalGen_StopMultiTone(void)
+{
+    if (!sg_mt_next_on) return;
+
+    SG_Stream_BeginUpdate(&sg_stream);
+    sg_mt_next_on = 0;
+    sg_mt_pending = 1;
+    SG_Stream_EndUpdate(&sg_stream);
+    SignalGen_SelectBackend();
+}
+
+int SignalGen_IsMultiTone(void)
+{
+    return sg_mt_next_on;
+}
+
+// Знаковий Q15 синус для MultiTone_Init (WAVE_TABLE_BITS)
+const int16_t *SignalGen_MultiToneTable(void)
+{
+    return WaveTable_Get(WAVE_SINE);
+}
+
+// Стенд на цілі: MultiTone_Fill блоку SG_BUFFER_SAMPLES / 2 для 1..MT_MAX_TONES
+// тонів (найкращий з трьох прогонів). Повертає, скільки тонів вкладається в
+// SG_FILL_BUDGET_US; cycles[k - 1] - такти на блок для k тонів (NULL - не
+// потрібні). Блокує на кілька мс - викликати з задачі
+uint32_t SignalGen_MultiToneMax(uint32_t cycles[MT_MAX_TONES])
+{
+    static uint16_t scratch[SG_BUFFER_SAMPLES / 2];
+    const uint32_t mhz = SystemCoreClock / 1000000U;
+    uint32_t max = 0;
+    MultiTone_t mt;
+
+    MultiTone_Init(&mt, WaveTable_Get(WAVE_SINE), WAVE_TABLE_BITS, SG_SAMPLE_RATE_HZ);
+    for (uint32_t k = 1; k <= MT_MAX_TONES; k++)
+    {
+        uint32_t best = 0xFFFFFFFFU;
+
+        MultiTone_Add(&mt, 1000U * (697U + 150U * k), 1000U, 0);
+        for (uint32_t run = 0; run < 3U; run++)
+        {
+            uint32_t c0 = DWT->CYCCNT, c;
+
+            MultiTone_Fill(&mt, 0, SG_DAC_MAX, sg_dds.cal, scratch, SG_BUFFER_SAMPLES / 2);
+            c = DWT->CYCCNT - c0;
+            if (c < best) best = c;
+        }
+        if (cycles)
+            cycles[k - 1U] = best;
+        if (best / mhz <= SG_FILL_BUDGET_US)
+            max = k;
+    }
+    return max;
+}
+
+// Вихід увімк./вимк. без клацання: ворота відчиняються/зачиняються рампою.
+// Вимкнений вихід стоїть на коді 0, а TIM7 і DMA крутяться далі (блок -
+// лише нулі), тож наступне увімкнення знову плавне. Перше запускає тактування
+void SignalGen_SetOutput(int on)
+{
+    int run = (htim7.Instance->CR1 & TIM_CR1_CEN) != 0U;
+
+    SG_Stream_BeginUpdate(&sg_stream);
+    sg_gate_next = on ? RAMP_UNITY : 0U;
+    SG_Stream_EndUpdate(&sg_stream);
+    SignalGen_Retune(sg_dds.tuning_word);
+    SignalGen_SelectBackend();
+    if (on && !run)
+        SignalGen_RunClock(1);
+}
+
+int SignalGen_IsOutputOn(void)
+{
+    return sg_gate_next != 0U;
+}
+
+// Тривалість рамп рівнів і воріт у відліках (0 - стрибком); з наступної зміни
+void SignalGen_SetRamp_samples(uint32_t samples)
+{
+    sg_ramp.length = samples;
+}
+
+// Імпульс в 1 відлік на TEST_PIN (PB8) на початку кожного періоду або
+// сегмента свіпу/секвенції. Увімкнення перезапускає потік DMA, щоб обидва
+// кільця стартували з нуля; PERIOD <-> SEGMENT - з наступного блоку
+void SignalGen_SetMarker(MarkerMode_t mode)
+{
+    static uint8_t ready = 0;
+
+    if (mode == sg_marker_mode) return;
+    if (mode != MARKER_OFF && sg_marker_mode != MARKER_OFF)
+    {
+        sg_marker_mode = mode;
+        return;
+    }
+
+    if (sg_hw_wave.kind == DACWAVE_OFF && !sg_pwm_on)
+        SignalGen_Stop();
+
+    if (mode != MARKER_OFF)
+    {
+        if (!ready && SignalGen_MarkerInit() != HAL_OK)
+            return;
+        ready = 1;
+        SignalGen_MarkerTimer(htim7.Instance->PSC, htim7.Instance->ARR);
+    }
+    else
+    {
+        TIM8->CR1 &= ~TIM_CR1_CEN;
+        HAL_GPIO_WritePin(TEST_PIN_GPIO_Port, TEST_PIN_Pin, GPIO_PIN_RESET);
+    }
+    Marker_Init(&sg_marker, TEST_PIN_Pin);
+    sg_marker_mode = mode;
+
+    if (sg_hw_wave.kind == DACWAVE_OFF && !sg_pwm_on)
+    {
+        SignalGen_InitStream();
+        SignalGen_Start();
+    }
+}
+
+MarkerMode_t SignalGen_GetMarker(void)
+{
+    return sg_marker_mode;
+}
+
+// 0 - завжди через DMA (наприклад, для порівняння форм)
+void SignalGen_SetHwWaveAuto(int enable)
+{
+    sg_hw_auto = enable ? 1U : 0U;
+    SignalGen_SelectBackend();
+}
+
+int SignalGen_IsHwWave(void)
+{
+    return sg_hw_wave.kind != DACWAVE_OFF;
+}
+
+// 1 - меандр/імпульси зараз іде з TIM1 на PA8, а не з DAC
+int SignalGen_IsPwmOut(void)
+{
+    return sg_pwm_on;
+}
+
+ModulationType_t SignalGen_GetModulation(void)
+{
+    return sg_mod_next.type;
+}
+
+uint32_t SignalGen_GetLateRefills(void)
+{
+    return sg_stream.late_refills;
+}
+
+uint32_t SignalGen_GetFillTimeMax_us(void)
+{
+    return sg_fill_us_max;
+}
+
+uint32_t SignalGen_GetFillOverruns(void)
+{
+    return sg_fill_overruns;
+}
+
+uint32_t SignalGen_GetRetuneLatency_us(void)
+{
+    return sg_retune_us;
+}
+
+uint32_t SignalGen_GetRetuneLate(void)
+{
+    return sg_retune_late;
+}
+
+uint32_t SignalGen_GetRecallLatency_us(void)
+{
+    return sg_recall_us;
+}
+
+// DAC дочитав першу половину -> перезаповнюємо її
+void HAL_DAC_ConvHalfCpltCallbackCh1(DAC_HandleTypeDef *hdac)
+{
+    SG_Stream_OnHalfDone(&sg_stream, 0);
+}
+
+// DAC дочитав другу половину (DMA_CIRCULAR почне знову з початку)
+void HAL_DAC_ConvCpltCallbackCh1(DAC_HandleTypeDef *hdac)
+{
+    SG_Stream_OnHalfDone(&sg_stream, 1);
 }
@@ -1,22 +1,141 @@
 /*
  * signal_gen.h
  *
- *  Created on: 8 лют. 2026 р.
+ *  Created on: 8 лют. 2026 р.
  *      Author: Олександр
  */
+#ifndef SIGNAL_GEN_H
+#define SIGNAL_GEN_H
+
 // In your header file
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 #include "main.h"
+#include "dds.h"
+#include "sg_stream.h"
+#include "wave_tables.h"
+#include "waveform.h"
+#include "dual_dac.h"
+#include "sweep.h"
+#include "modulation.h"
+#include "noise.h"
+#include "freq_plan.h"
+#include "dac_wave.h"
+#include "harmonics.h"
+#include "sequencer.h"
+#include "dac_cal.h"
+#include "dither.h"
+#include "zoh.h"
+#include "marker.h"
+#include "preset.h"
+#include "ramp.h"
+#include "multitone.h"
+#include "pwm_out.h"
 
 
-#define SINE_SAMPLES 128
+#define SINE_TABLE_BITS		WAVE_TABLE_BITS
+#define SINE_SAMPLES		(1U << SINE_TABLE_BITS)	// master table, power of two for DDS
 #define M_PI 3.14159265358979323846f
 
+#define SG_DAC_MAX			4095U		// 12-bit right aligned
+#define SG_TIMER_CLK_HZ		108000000U	// APB1 timer clock (TIM7)
+#define SG_MARKER_TIMER_CLK_HZ	216000000U	// APB2 timer clock (TIM8, marker DMA pacing)
+#define SG_PWM_TIMER_CLK_HZ	216000000U	// APB2 timer clock (TIM1, square/pulse on PA8)
+#define SG_SAMPLE_RATE_HZ	1000000U	// TIM7: 108 MHz / 108, also the DAC rate limit
+#define SG_BUFFER_SAMPLES	1024U		// DAC DMA circular buffer, refilled by halves (words in dual mode)
+#define SG_DEFAULT_FREQ_HZ	1000U
+#define SG_DEFAULT_MOD_RATE_HZ	100U
+#define SG_SLIDER_FREQ_STEP_HZ	100U	// slider 0..100 -> 0..10 kHz
+#define SG_EXACT_MIN_SAMPLES	16U		// exact mode: period table length range
+#define SG_EXACT_MAX_SAMPLES	2048U
+#define SG_EXACT_TOLERANCE_PPM	10U		// exact mode only within this error (below HSE crystal tolerance)
+#define SG_HW_WAVE_TOLERANCE_PPM	1000U	// DAC built-in triangle: timer divider may miss by 0.1 %
+#define SG_PWM_MIN_FREQ_HZ	50000U		// square/pulse from here go to TIM1 (DAC: < 20 samples per period)
+#define SG_PWM_TOLERANCE_PPM	10000U		// TIM1 period rounding: covers everything up to ~4.3 MHz
+#define SG_FILL_BUDGET_US	100U	// max time to render one half-buffer (512 us of output)
+#define SG_RETUNE_GUARD_SAMPLES	8U	// retune re-renders from this far ahead of the DMA
+#define SG_RAMP_SAMPLES		2000U	// level / on-off ramps: 2 ms at 1 MS/s
+#define SG_PRESET_OFFSET	0x00F80000U	// presets: top 512 KB of the QSPI flash (kept out of the linker map)
+#define SG_ARB_MIN_BITS		4U		// arbitrary table: 16 .. PRESET_MAX_SAMPLES entries
+#define SG_ARB_MAX_BITS		12U
+
+extern uint16_t dac_buffer[SG_BUFFER_SAMPLES * 2];
+
 void Generete_SineTable(int touch_value);
 
+void SignalGen_Init(void);
+HAL_StatusTypeDef SignalGen_Start(void);
+void SignalGen_RunClock(int run);
+void SignalGen_SetOutput(int on);
+int SignalGen_IsOutputOn(void);
+void SignalGen_SetRamp_samples(uint32_t samples);
+void SignalGen_SetFrequency_mHz(uint32_t freq_mhz);
+uint32_t SignalGen_SetFrequencyExact_mHz(uint32_t freq_mhz);
+uint32_t SignalGen_GetFrequency_mHz(void);
+void SignalGen_SetWaveform(Waveform_t form);
+Waveform_t SignalGen_GetWaveform(void);
+void SignalGen_SetDuty_permille(uint32_t permille);
+void SignalGen_SetAmplitudeOffset(uint32_t amplitude, uint32_t offset);
+void SignalGen_SetBandLimited(int enable);
+
+void SignalGen_SetDualChannel(int enable);
+int SignalGen_IsDualChannel(void);
+void SignalGen_SetPhaseOffset_deg(uint32_t degrees);
+void SignalGen_SetChannel2Multiplier(uint32_t mult);
+
+int SignalGen_StartSweep(uint32_t start_mhz, uint32_t stop_mhz, uint32_t duration_ms,
+                         SweepMode_t mode, int repeat);
+void SignalGen_StopSweep(void);
+int SignalGen_IsSweeping(void);
+uint32_t SignalGen_GetSweepPosition_permille(void);
+
+void SignalGen_SetNoiseBandwidth_Hz(uint32_t bandwidth_hz);
+
+void SignalGen_SetModulation(ModulationType_t type, uint32_t amount, uint32_t rate_mhz);
+ModulationType_t SignalGen_GetModulation(void);
+
+void SignalGen_SetHarmonics(const Harmonics_t *h);
+int SignalGen_SetArbitrary(const uint16_t *table, uint32_t bits);
+void SignalGen_SetZohCompensation(int enable);
+
+int SignalGen_StartSequence(const Sequencer_t *seq);
+void SignalGen_StopSequence(void);
+int SignalGen_IsSequencing(void);
+void SignalGen_GetSequenceOverhead(uint32_t *overhead_cycles, uint32_t *min_segment_us);
+int SignalGen_StartMultiTone(const MultiTone_t *mt);
+void SignalGen_StopMultiTone(void);
+int SignalGen_IsMultiTone(void);
+const int16_t *SignalGen_MultiToneTable(void);
+uint32_t SignalGen_MultiToneMax(uint32_t cycles[MT_MAX_TONES]);
+
+int SignalGen_SetCalibration(const DacCalPoint_t *pts, uint32_t count, int32_t vref_uv);
+int SignalGen_IsCalibrated(void);
+
+void SignalGen_SetDither(DitherMode_t mode);
+DitherMode_t SignalGen_GetDither(void);
+
+int SignalGen_SavePreset(uint32_t slot, const char *name);
+int SignalGen_RecallPreset(uint32_t slot);
+const PresetStore_t *SignalGen_GetPresets(void);
+
+void SignalGen_SetMarker(MarkerMode_t mode);
+MarkerMode_t SignalGen_GetMarker(void);
+
+void SignalGen_SetHwWaveAuto(int enable);
+int SignalGen_IsHwWave(void);
+int SignalGen_IsPwmOut(void);
+
+uint32_t SignalGen_GetLateRefills(void);
+uint32_t SignalGen_GetFillTimeMax_us(void);
+uint32_t SignalGen_GetFillOverruns(void);
+uint32_t SignalGen_GetRetuneLatency_us(void);
+uint32_t SignalGen_GetRetuneLate(void);
+uint32_t SignalGen_GetRecallLatency_us(void);
+
 #ifdef __cplusplus
 }
 #endif
+
+#endif /* SIGNAL_GEN_H */
@@ -0,0 +1,38 @@
+/*
+ * sine_q15.h
+ *
+ *  Fixed-point sine tables built from one stored quarter wave.
+ *  Full periods of any power-of-two length come out of the quarter by
+ *  symmetry, using only integer multiply and shift - no sinf().
+ *
+ *  Host-only since the flash tables are generated at compile time
+ *  (wave_tables.hpp): not in the firmware sources, kept as the runtime
+ *  reference Tests/ check those tables against and for the bench.
+ */
+#ifndef SINE_Q15_H
+#define SINE_Q15_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+#define SINE_Q15_QUARTER_BITS	10
+#define SINE_Q15_QUARTER_LEN	(1U << SINE_Q15_QUARTER_BITS)	/* + 1 entry for pi/2 */
+#define SINE_Q15_EXACT_BITS		(SINE_Q15_QUARTER_BITS + 2)		/* up to 4096: no interpolation */
+#define SINE_Q15_MIN_BITS		2
+
+/* round(32767 * sin(pi/2 * i / SINE_Q15_QUARTER_LEN)), i = 0..SINE_Q15_QUARTER_LEN */
+extern const int16_t sine_q15_quarter[SINE_Q15_QUARTER_LEN + 1];
+
+int16_t SineQ15_Quarter(uint32_t i, uint32_t bits);
+
+void SineQ15_BuildPeriod(int16_t *dst, uint32_t bits);
+void SineQ15_BuildDac(uint16_t *dst, uint32_t bits, uint32_t max_dac);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SINE_Q15_H */
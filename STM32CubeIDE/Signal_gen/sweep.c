@@ -0,0 +1,112 @@
+/*
+ * sweep.c
+ *
+ *  The tuning word is carried with 16 fractional bits so a long linear
+ *  sweep with a step below one LSB per block still advances, and the
+ *  log sweep's per-block ratio does not compound rounding error. The
+ *  last block is forced to the exact stop tuning word.
+ */
+#include "sweep.h"
+#include <math.h>
+#include "dds.h"
+
+/* t * e / 2^32 for t < 2^48 without a 128-bit intermediate */
+static inline uint64_t mul_q32(uint64_t t, uint32_t e)
+{
+    return (t >> 32) * e + (((t & 0xFFFFFFFFU) * e) >> 32);
+}
+
+int Sweep_Setup(Sweep_t *sw, uint32_t sample_rate_hz, uint32_t block_samples,
+                uint32_t start_mhz, uint32_t stop_mhz, uint32_t duration_ms,
+                SweepMode_t mode, int repeat)
+{
+    uint64_t blocks;
+
+    sw->active = 0;
+    if (block_samples == 0U || sample_rate_hz == 0U)
+        return 0;
+
+    sw->start_tuning = DDS_TuningWord_mHz(sample_rate_hz, start_mhz);
+    sw->stop_tuning = DDS_TuningWord_mHz(sample_rate_hz, stop_mhz);
+    if (mode == SWEEP_LOG && (sw->start_tuning == 0U || sw->stop_tuning == 0U))
+        return 0;
+
+    blocks = ((uint64_t)duration_ms * sample_rate_hz / 1000U) / block_samples;
+    if (blocks < 2U) blocks = 2U;
+    if (blocks > 0xFFFFFFFFU) blocks = 0xFFFFFFFFU;
+
+    sw->blocks = (uint32_t)blocks;
+    sw->block = 0;
+    sw->mode = mode;
+    sw->repeat = repeat ? 1U : 0U;
+    sw->tuning_q16 = (uint64_t)sw->start_tuning << 16;
+    sw->step_q16 = 0;
+    sw->ratio_q32 = 0;
+
+    if (mode == SWEEP_LOG)
+    {
+        double r = pow((double)sw->stop_tuning / (double)sw->start_tuning, 1.0 / (double)(blocks - 1U));
+        double e = (r - 1.0) * 4294967296.0;
+
+        /* Per-block ratio is kept inside (0, 2); the stop clamp covers the rest */
+        if (e > 4294967295.0) e = 4294967295.0;
+        if (e < -4294967295.0) e = -4294967295.0;
+        sw->ratio_q32 = (int64_t)llround(e);
+    }
+    else
+    {
+        int64_t span = ((int64_t)sw->stop_tuning - (int64_t)sw->start_tuning) * 65536;
+        sw->step_q16 = span / (int64_t)(blocks - 1U);
+    }
+
+    sw->active = 1;
+    return 1;
+}
+
+uint32_t Sweep_Next(Sweep_t *sw)
+{
+    uint32_t tuning;
+
+    if (!sw->active)
+        return sw->stop_tuning;
+
+    if (sw->block + 1U >= sw->blocks)
+    {
+        if (sw->repeat)
+        {
+            sw->block = 0;
+            sw->tuning_q16 = (uint64_t)sw->start_tuning << 16;
+        }
+        else
+        {
+            sw->block = sw->blocks;
+            sw->active = 0;
+        }
+        return sw->stop_tuning;
+    }
+
+    tuning = (uint32_t)(sw->tuning_q16 >> 16);
+    sw->block++;
+
+    if (sw->mode == SWEEP_LOG)
+    {
+        if (sw->ratio_q32 >= 0)
+            sw->tuning_q16 += mul_q32(sw->tuning_q16, (uint32_t)sw->ratio_q32);
+        else
+            sw->tuning_q16 -= mul_q32(sw->tuning_q16, (uint32_t)-sw->ratio_q32);
+    }
+    else
+    {
+        sw->tuning_q16 = (uint64_t)((int64_t)sw->tuning_q16 + sw->step_q16);
+    }
+    return tuning;
+}
+
+uint32_t Sweep_Position_permille(const Sweep_t *sw)
+{
+    if (sw->blocks == 0U)
+        return 0;
+    if (sw->block >= sw->blocks)
+        return 1000U;
+    return (uint32_t)((uint64_t)sw->block * 1000U / sw->blocks);
+}
@@ -0,0 +1,51 @@
+/*
+ * sweep.h
+ *
+ *  Linear / logarithmic frequency sweep (chirp). The DDS tuning word is
+ *  stepped once per DMA half-block from the refill ISR, so the cost is
+ *  one add (linear) or one 64x32 multiply (log) per block regardless of
+ *  how long the sweep runs. Only the tuning word changes - the phase
+ *  accumulator keeps running, so the output stays phase-continuous.
+ *
+ *  All setup math (block count, per-block step/ratio) is done once in
+ *  Sweep_Setup() from task context.
+ */
+#ifndef SWEEP_H
+#define SWEEP_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+typedef enum {
+    SWEEP_LINEAR = 0,
+    SWEEP_LOG
+} SweepMode_t;
+
+typedef struct {
+    uint64_t tuning_q16;    /* tuning word for the current block, Q16 fraction */
+    int64_t step_q16;       /* linear: added per block                         */
+    int64_t ratio_q32;      /* log: (ratio - 1) per block, Q32                 */
+    uint32_t start_tuning;
+    uint32_t stop_tuning;
+    uint32_t blocks;        /* sweep length in blocks, start and stop included */
+    uint32_t block;         /* index of the next block                         */
+    SweepMode_t mode;
+    uint8_t repeat;         /* restart from start instead of holding stop      */
+    uint8_t active;
+} Sweep_t;
+
+int Sweep_Setup(Sweep_t *sw, uint32_t sample_rate_hz, uint32_t block_samples,
+                uint32_t start_mhz, uint32_t stop_mhz, uint32_t duration_ms,
+                SweepMode_t mode, int repeat);
+
+uint32_t Sweep_Next(Sweep_t *sw);
+uint32_t Sweep_Position_permille(const Sweep_t *sw);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SWEEP_H */
@@ -0,0 +1,26 @@
+/*
+ * wave_tables.cpp
+ *
+ *  Instantiates the WAVE_TABLE_LEN master tables. Everything below is
+ *  evaluated by the compiler; the arrays end up in .rodata.
+ */
+#include "wave_tables.h"
+#include "wave_tables.hpp"
+
+typedef wave::table<WAVE_TABLE_LEN, wave::sine> SineTable;
+
+static_assert(SineTable::data[0] == 0, "sine starts at 0");
+static_assert(SineTable::data[WAVE_TABLE_LEN / 4] == 32767, "sine peak at N/4");
+static_assert(SineTable::data[3 * WAVE_TABLE_LEN / 4] == -32767, "sine trough at 3N/4");
+
+const int16_t *WaveTable_Get(WaveShape_t shape)
+{
+    (void)shape;
+    return SineTable::data;
+}
+
+void WaveTable_OffsetBinary(uint16_t *dst, const int16_t *src, uint32_t count)
+{
+    for (uint32_t i = 0; i < count; i++)
+        dst[i] = (uint16_t)(32768 + src[i]);
+}
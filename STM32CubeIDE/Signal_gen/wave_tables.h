@@ -0,0 +1,37 @@
+/*
+ * wave_tables.h
+ *
+ *  C view of the flash-resident master tables generated at compile time
+ *  by wave_tables.hpp, plus the offset-binary copy DDS_FillScaled() reads.
+ */
+#ifndef WAVE_TABLES_H
+#define WAVE_TABLES_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+#define WAVE_TABLE_BITS		10
+#define WAVE_TABLE_LEN		(1U << WAVE_TABLE_BITS)
+
+/* Only the sine is instantiated: the other shapes are computed by the
+ * waveform kernels. wave::triangle / wave::saw stay available in
+ * wave_tables.hpp for a table-driven shape */
+typedef enum {
+    WAVE_SINE = 0,
+    WAVE_SHAPE_COUNT
+} WaveShape_t;
+
+/* Normalized Q15 period (-32767..32767), WAVE_TABLE_LEN entries, in flash */
+const int16_t *WaveTable_Get(WaveShape_t shape);
+
+/* dst[i] = 32768 + src[i], the normalized table DDS_FillScaled() reads */
+void WaveTable_OffsetBinary(uint16_t *dst, const int16_t *src, uint32_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WAVE_TABLES_H */
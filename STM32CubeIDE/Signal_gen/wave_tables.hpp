@@ -0,0 +1,123 @@
+/*
+ * wave_tables.hpp
+ *
+ *  Compile-time master waveform tables. wave::table<N, Shape>::data is a
+ *  constexpr int16_t[N] (Q15, -32767..32767, one period starting at phase 0)
+ *  so the compiler emits it straight into .rodata (flash) with no startup
+ *  code. Works for any N; stays within C++11 constexpr rules.
+ *
+ *  C code reaches the instantiated tables through wave_tables.h.
+ */
+#ifndef WAVE_TABLES_HPP
+#define WAVE_TABLES_HPP
+
+#include <stdint.h>
+
+namespace wave
+{
+
+/* ---------- index_list<0..N-1> (std::index_sequence is C++14) ---------- */
+
+template<unsigned... I> struct index_list {};
+
+template<class A, class B> struct concat;
+
+template<unsigned... A, unsigned... B>
+struct concat<index_list<A...>, index_list<B...> >
+{
+    typedef index_list<A..., (sizeof...(A) + B)...> type;
+};
+
+/* Split in halves so instantiation depth is log2(N), not N */
+template<unsigned N> struct make_index_list
+{
+    typedef typename concat<typename make_index_list<N / 2>::type,
+                            typename make_index_list<N - N / 2>::type>::type type;
+};
+template<> struct make_index_list<0> { typedef index_list<> type; };
+template<> struct make_index_list<1> { typedef index_list<0> type; };
+
+/* ---------- constexpr math ---------- */
+
+namespace detail
+{
+
+constexpr double kHalfPi = 1.57079632679489661923;
+
+/* Taylor series, x in [0, pi/2]: 14 terms are well below 1e-16 */
+constexpr double sin_series(double x2, double term, unsigned k)
+{
+    return (k == 14) ? 0.0
+         : term + sin_series(x2, -term * x2 / (double)((2 * k + 2) * (2 * k + 3)), k + 1);
+}
+
+constexpr double sin_first_quadrant(double x)
+{
+    return sin_series(x * x, x, 0);
+}
+
+/* sin(2*pi*i/n): quadrant q = 4i/n, remainder r = 4i mod n, angle pi/2*r/n */
+constexpr double sin_quadrant(unsigned long long q, unsigned long long r, unsigned n)
+{
+    return (q == 0) ?  sin_first_quadrant(kHalfPi * (double)r / (double)n)
+         : (q == 1) ?  sin_first_quadrant(kHalfPi * (double)(n - r) / (double)n)
+         : (q == 2) ? -sin_first_quadrant(kHalfPi * (double)r / (double)n)
+         :            -sin_first_quadrant(kHalfPi * (double)(n - r) / (double)n);
+}
+
+/* Round half away from zero into Q15 */
+constexpr int16_t to_q15(double v)
+{
+    return (v >= 0.0) ? (int16_t)(v * 32767.0 + 0.5) : (int16_t)-(int16_t)(-v * 32767.0 + 0.5);
+}
+
+} /* namespace detail */
+
+/* ---------- shapes: at(i, n) = sample i of an n-sample period ---------- */
+
+struct sine
+{
+    static constexpr int16_t at(unsigned i, unsigned n)
+    {
+        return detail::to_q15(detail::sin_quadrant(4ULL * i / n, 4ULL * i % n, n));
+    }
+};
+
+/* 0 -> +1 at n/4 -> -1 at 3n/4 -> 0, same phase as sine */
+struct triangle
+{
+    static constexpr int16_t at(unsigned i, unsigned n)
+    {
+        return detail::to_q15((4ULL * i < n)     ? 4.0 * i / n
+                            : (4ULL * i < 3ULL * n) ? 2.0 - 4.0 * i / n
+                            :                     4.0 * i / n - 4.0);
+    }
+};
+
+/* 0 -> +1 just before n/2, jumps to -1, back to 0 */
+struct saw
+{
+    static constexpr int16_t at(unsigned i, unsigned n)
+    {
+        return detail::to_q15((2ULL * i < n) ? 2.0 * i / n : 2.0 * i / n - 2.0);
+    }
+};
+
+/* ---------- the table itself ---------- */
+
+template<unsigned N, class Shape, class Indices = typename make_index_list<N>::type>
+struct table;
+
+template<unsigned N, class Shape, unsigned... I>
+struct table<N, Shape, index_list<I...> >
+{
+    static constexpr unsigned size = N;
+    static constexpr int16_t data[N] = { Shape::at(I, N)... };
+};
+
+template<unsigned N, class Shape, unsigned... I>
+constexpr int16_t table<N, Shape, index_list<I...> >::data[N];
+
+} /* namespace wave */
+
+#endif /* WAVE_TABLES_HPP */
@@ -0,0 +1,148 @@
+/*
+ * waveform.c
+ *
+ *  Shaped kernels map a 32-bit unipolar ramp u (0 .. 2^32-1) to
+ *  low + ((u >> 16) * (high - low) + 0.5) >> 16, which reaches both
+ *  end codes exactly and never overflows 32 bits for 12-bit spans.
+ *  The result goes through the DAC correction (dds->cal) on the store.
+ */
+#include "waveform.h"
+#include "blep.h"
+
+#define PHASE_QUARTER   0x40000000U
+#define PHASE_HALF      0x80000000U
+
+static const char *const waveform_names[WAVEFORM_COUNT] =
+{
+    "SIN", "SQR", "PUL", "TRI", "RUP", "RDN", "WHT", "PNK", "HRM", "ARB"
+};
+
+uint32_t Waveform_DutyFromPermille(uint32_t permille)
+{
+    if (permille >= 1000U)
+        return 0xFFFFFFFFU;
+    return (uint32_t)(((uint64_t)permille << 32) / 1000U);
+}
+
+const char *Waveform_Name(Waveform_t form)
+{
+    return (form < WAVEFORM_COUNT) ? waveform_names[form] : "?";
+}
+
+static inline uint16_t scale_ramp(uint32_t u, uint16_t low, uint32_t span)
+{
+    return (uint16_t)(low + (((u >> 16) * span + 32768U) >> 16));
+}
+
+void Waveform_FillPulse(DDS_t *dds, uint32_t duty, uint16_t low, uint16_t high, uint16_t *dst, uint32_t count)
+{
+    const uint32_t step = dds->tuning_word;
+    uint32_t phase = dds->phase;
+
+    /* Two levels only: correct them once per block */
+    low = DDS_Cal(dds->cal, low);
+    high = DDS_Cal(dds->cal, high);
+
+    while (count--)
+    {
+        *dst++ = (phase < duty) ? high : low;
+        phase += step;
+    }
+    dds->phase = phase;
+}
+
+DDS_INLINE void fill_triangle(DDS_t *dds, uint16_t low, uint16_t high, const uint16_t *cal,
+                              uint16_t *dst, uint32_t count)
+{
+    const uint32_t step = dds->tuning_word;
+    const uint32_t span = (uint32_t)(high - low);
+    uint32_t phase = dds->phase;
+
+    while (count--)
+    {
+        /* Shift by a quarter so phase 0 sits mid-level on the rising edge */
+        uint32_t p = phase + PHASE_QUARTER;
+        uint32_t u = (p < PHASE_HALF) ? (p << 1) : (~p << 1);
+
+        *dst++ = DDS_Cal(cal, scale_ramp(u, low, span));
+        phase += step;
+    }
+    dds->phase = phase;
+}
+
+void Waveform_FillTriangle(DDS_t *dds, uint16_t low, uint16_t high, uint16_t *dst, uint32_t count)
+{
+    if (dds->cal)
+        fill_triangle(dds, low, high, dds->cal, dst, count);
+    else
+        fill_triangle(dds, low, high, NULL, dst, count);
+}
+
+DDS_INLINE void fill_ramp(DDS_t *dds, uint16_t low, uint16_t high, int down, const uint16_t *cal,
+                          uint16_t *dst, uint32_t count)
+{
+    const uint32_t step = dds->tuning_word;
+    const uint32_t span = (uint32_t)(high - low);
+    const uint32_t flip = down ? 0xFFFFFFFFU : 0U;
+    uint32_t phase = dds->phase;
+
+    while (count--)
+    {
+        uint32_t u = (phase + PHASE_HALF) ^ flip;
+
+        *dst++ = DDS_Cal(cal, scale_ramp(u, low, span));
+        phase += step;
+    }
+    dds->phase = phase;
+}
+
+void Waveform_FillRamp(DDS_t *dds, uint16_t low, uint16_t high, int down, uint16_t *dst, uint32_t count)
+{
+    if (dds->cal)
+        fill_ramp(dds, low, high, down, dds->cal, dst, count);
+    else
+        fill_ramp(dds, low, high, down, NULL, dst, count);
+}
+
+void Waveform_Fill(DDS_t *dds, const WaveParams_t *p, uint16_t *dst, uint32_t count)
+{
+    switch (p->form)
+    {
+    case WAVEFORM_SQUARE:
+        if (p->band_limited)
+            Blep_FillPulse(dds, PHASE_HALF, p->low, p->high, dst, count);
+        else
+            Waveform_FillPulse(dds, PHASE_HALF, p->low, p->high, dst, count);
+        break;
+    case WAVEFORM_PULSE:
+        if (p->band_limited)
+            Blep_FillPulse(dds, p->duty, p->low, p->high, dst, count);
+        else
+            Waveform_FillPulse(dds, p->duty, p->low, p->high, dst, count);
+        break;
+    case WAVEFORM_TRIANGLE:
+        Waveform_FillTriangle(dds, p->low, p->high, dst, count);
+        break;
+    case WAVEFORM_RAMP_UP:
+    case WAVEFORM_RAMP_DOWN:
+        if (p->band_limited)
+            Blep_FillRamp(dds, p->low, p->high, p->form == WAVEFORM_RAMP_DOWN, dst, count);
+        else
+            Waveform_FillRamp(dds, p->low, p->high, p->form == WAVEFORM_RAMP_DOWN, dst, count);
+        break;
+    case WAVEFORM_NOISE_WHITE:
+    case WAVEFORM_NOISE_PINK:
+        /* Noise carries generator state the caller owns (Noise_Fill*);
+         * without it, hold mid-level and keep the phase moving */
+        for (uint32_t i = 0; i < count; i++)
+            dst[i] = DDS_Cal(dds->cal, (p->low + p->high + 1U) / 2U);
+        dds->phase += dds->tuning_word * count;
+        break;
+    case WAVEFORM_SINE:
+    case WAVEFORM_HARMONIC:
+    case WAVEFORM_ARBITRARY:
+    default:
+        DDS_FillScaled(dds, p->low, p->high, dst, count);
+        break;
+    }
+}
@@ -0,0 +1,57 @@
+/*
+ * waveform.h
+ *
+ *  Per-waveform block kernels. All of them are driven by the DDS phase
+ *  accumulator and write DAC codes straight into the DMA half-buffer with
+ *  integer math only, so changing shape, duty or level costs nothing up
+ *  front - the next block simply renders with the new parameters.
+ *
+ *  Phase 0 is aligned the same way for every shape: mid-level, rising
+ *  (square/pulse start high).
+ */
+#ifndef WAVEFORM_H
+#define WAVEFORM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include "dds.h"
+
+typedef enum {
+    WAVEFORM_SINE = 0,  /* normalized master table, scaled per sample */
+    WAVEFORM_SQUARE,    /* 50 % duty                           */
+    WAVEFORM_PULSE,     /* duty from WaveParams_t.duty         */
+    WAVEFORM_TRIANGLE,
+    WAVEFORM_RAMP_UP,
+    WAVEFORM_RAMP_DOWN,
+    WAVEFORM_NOISE_WHITE, /* stateful, rendered by noise.c       */
+    WAVEFORM_NOISE_PINK,
+    WAVEFORM_HARMONIC,  /* additive table behind the DDS, as sine */
+    WAVEFORM_ARBITRARY, /* user/preset table behind the DDS, as sine */
+    WAVEFORM_COUNT
+} Waveform_t;
+
+typedef struct {
+    Waveform_t form;
+    uint32_t duty;      /* high while phase < duty, 2^32 = 100 % */
+    uint16_t low;       /* DAC code at the bottom of the swing   */
+    uint16_t high;      /* DAC code at the top of the swing      */
+    uint8_t band_limited; /* PolyBLEP edges for square/pulse/ramps */
+} WaveParams_t;
+
+uint32_t Waveform_DutyFromPermille(uint32_t permille);
+const char *Waveform_Name(Waveform_t form);
+
+void Waveform_Fill(DDS_t *dds, const WaveParams_t *p, uint16_t *dst, uint32_t count);
+
+void Waveform_FillPulse(DDS_t *dds, uint32_t duty, uint16_t low, uint16_t high, uint16_t *dst, uint32_t count);
+void Waveform_FillTriangle(DDS_t *dds, uint16_t low, uint16_t high, uint16_t *dst, uint32_t count);
+void Waveform_FillRamp(DDS_t *dds, uint16_t low, uint16_t high, int down, uint16_t *dst, uint32_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WAVEFORM_H */
@@ -0,0 +1,67 @@
+/*
+ * zoh.c
+ *
+ *  1 / sinc(x) with x = pi * i / 128, i = 0 .. 64 (DC .. Nyquist), Q16.
+ *  Linear interpolation between entries stays within 0.01 %.
+ */
+#include "zoh.h"
+
+#define ZOH_NYQUIST     0x80000000U
+
+static const uint32_t inv_sinc_q16[65] =
+{
+    65536, 65543, 65562, 65595, 65641, 65701, 65773, 65860,
+    65959, 66072, 66199, 66339, 66493, 66661, 66844, 67040,
+    67251, 67477, 67717, 67973, 68244, 68530, 68832, 69151,
+    69485, 69836, 70205, 70590, 70994, 71415, 71855, 72314,
+    72792, 73290, 73809, 74348, 74910, 75493, 76098, 76728,
+    77381, 78059, 78762, 79492, 80250, 81035, 81849, 82694,
+    83569, 84477, 85418, 86394, 87405, 88454, 89542, 90670,
+    91840, 93054, 94314, 95620, 96977, 98385, 99847, 101366,
+    102944
+};
+
+uint32_t Zoh_Gain_q16(uint32_t tuning_word)
+{
+    uint32_t idx, frac;
+
+    if (tuning_word >= ZOH_NYQUIST)
+        return inv_sinc_q16[64];
+
+    idx = tuning_word >> 25;
+    frac = (tuning_word >> 9) & 0xFFFFU;
+    return inv_sinc_q16[idx] + (((inv_sinc_q16[idx + 1U] - inv_sinc_q16[idx]) * frac) >> 16);
+}
+
+/* Widen [low, high] around its middle, then clip to 0 .. max_code */
+void Zoh_ScaleSwing(uint16_t *low, uint16_t *high, uint32_t gain_q16, uint16_t max_code)
+{
+    int32_t sum = (int32_t)*low + *high;
+    int32_t span = (int32_t)((((uint32_t)(*high - *low)) * gain_q16 + 0x8000U) >> 16);
+    int32_t lo = (sum - span + 1) >> 1;
+    int32_t hi = lo + span;
+
+    if (lo < 0) lo = 0;
+    if (hi > (int32_t)max_code) hi = max_code;
+    *low = (uint16_t)lo;
+    *high = (uint16_t)hi;
+}
+
+/* Relative to the fundamental, which the swing already carries */
+void Zoh_Harmonics(const Harmonics_t *in, Harmonics_t *out, uint32_t tuning_word)
+{
+    const uint64_t g1 = Zoh_Gain_q16(tuning_word);
+
+    *out = *in;
+    for (uint32_t k = 2; k <= in->count; k++)
+    {
+        uint64_t tw = (uint64_t)tuning_word * k;
+        uint32_t gk = Zoh_Gain_q16((tw >= ZOH_NYQUIST) ? ZOH_NYQUIST : (uint32_t)tw);
+        int64_t num = (int64_t)in->amp_q15[k - 1U] * gk;
+        int32_t a = (int32_t)((num + ((num < 0) ? -(int64_t)(g1 / 2U) : (int64_t)(g1 / 2U))) / (int64_t)g1);
+
+        if (a > 32767) a = 32767;
+        if (a < -32767) a = -32767;
+        out->amp_q15[k - 1U] = (int16_t)a;
+    }
+}
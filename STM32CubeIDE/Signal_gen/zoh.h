@@ -0,0 +1,38 @@
+/*
+ * zoh.h
+ *
+ *  Zero-order-hold droop compensation. The DAC holds every sample for a
+ *  whole TIM7 period, which weights a tone at f by
+ *
+ *      sinc(f / fs) = sin(pi f / fs) / (pi f / fs)
+ *
+ *  (-0.14 dB at fs/10, -3.9 dB at Nyquist). f / fs is just the DDS
+ *  tuning word / 2^32, so the inverse gain is a 65-entry table lookup
+ *  per block: cheap enough to follow a sweep. Compensation is analytic:
+ *
+ *    sine          swing widened by 1 / sinc(f / fs) around its middle
+ *    harmonic      each harmonic k gets sinc(f / fs) / sinc(k f / fs)
+ *                  on top, so the whole spectrum lands as programmed
+ *
+ *  The swing is clamped to the DAC range, so a full-scale sine cannot
+ *  be lifted past the rails.
+ */
+#ifndef ZOH_H
+#define ZOH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include "harmonics.h"
+
+uint32_t Zoh_Gain_q16(uint32_t tuning_word);
+void Zoh_ScaleSwing(uint16_t *low, uint16_t *high, uint32_t gain_q16, uint16_t max_code);
+void Zoh_Harmonics(const Harmonics_t *in, Harmonics_t *out, uint32_t tuning_word);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZOH_H */
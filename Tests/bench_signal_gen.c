@@ -0,0 +1,685 @@
+/**
+ * @file bench_signal_gen.c
+ * @brief Host throughput benchmarks for the signal generator kernels
+ *
+ * Every kernel is driven the same way the DMA refill ISR drives it on the
+ * target: repeated SG half-buffer sized blocks (512 samples).
+ *
+ * Build (host):
+ *   gcc -O2 -I../STM32CubeIDE/Signal_gen bench_signal_gen.c \
+ *       ../STM32CubeIDE/Signal_gen/dds.c ../STM32CubeIDE/Signal_gen/sine_q15.c \
+ *       ../STM32CubeIDE/Signal_gen/waveform.c ../STM32CubeIDE/Signal_gen/blep.c \
+ *       ../STM32CubeIDE/Signal_gen/dual_dac.c ../STM32CubeIDE/Signal_gen/modulation.c \
+ *       ../STM32CubeIDE/Signal_gen/noise.c ../STM32CubeIDE/Signal_gen/freq_plan.c \
+ *       ../STM32CubeIDE/Signal_gen/dsp_kernels.c ../STM32CubeIDE/Signal_gen/harmonics.c \
+ *       ../STM32CubeIDE/Signal_gen/sequencer.c ../STM32CubeIDE/Signal_gen/dac_cal.c \
+ *       ../STM32CubeIDE/Signal_gen/dither.c ../STM32CubeIDE/Signal_gen/ramp.c \
+ *       ../STM32CubeIDE/Signal_gen/multitone.c \
+ *       -lm -o bench_signal_gen
+ *   ./bench_signal_gen > ../bench_output.txt
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <time.h>
+#include <math.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+#include "dds.h"
+#include "sine_q15.h"
+#include "waveform.h"
+#include "dual_dac.h"
+#include "modulation.h"
+#include "noise.h"
+#include "freq_plan.h"
+#include "dsp_kernels.h"
+#include "harmonics.h"
+#include "sequencer.h"
+#include "dac_cal.h"
+#include "dither.h"
+#include "ramp.h"
+#include "multitone.h"
+
+#define BENCH_BLOCK         512U
+#define BENCH_BLOCKS        20000U
+#define BENCH_SAMPLE_RATE   1000000U    /* TIM7 TRGO on target */
+
+static uint16_t block[BENCH_BLOCK];
+static volatile uint32_t sink;
+
+/* ========== Timing helpers ========== */
+
+static double now_sec(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static uint64_t now_cycles(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+static void consume_block(void)
+{
+    sink += block[0] + block[BENCH_BLOCK / 2] + block[BENCH_BLOCK - 1];
+}
+
+static void bench_report(const char *name, uint64_t samples, double sec, uint64_t cycles)
+{
+    double msps = (double)samples / sec / 1e6;
+
+    printf("%-32s %9.1f Msamples/s  %7.2f ns/sample  %6.2f cyc/sample  x%.0f realtime\n",
+           name, msps, sec * 1e9 / (double)samples, (double)cycles / (double)samples,
+           msps * 1e6 / BENCH_SAMPLE_RATE);
+}
+
+/* Time BENCH_BLOCKS calls of a block kernel */
+static void run_block_bench(const char *name, void (*fill)(uint16_t *dst, uint32_t count))
+{
+    double t0 = now_sec();
+    uint64_t c0 = now_cycles();
+    for (uint32_t i = 0; i < BENCH_BLOCKS; i++) {
+        fill(block, BENCH_BLOCK);
+        consume_block();
+    }
+    uint64_t c1 = now_cycles();
+    double t1 = now_sec();
+
+    bench_report(name, (uint64_t)BENCH_BLOCK * BENCH_BLOCKS, t1 - t0, c1 - c0);
+}
+
+/* ========== DDS ========== */
+
+static uint16_t dds_table[1U << 12];
+static uint16_t cal_lut[DAC_CAL_CODES];
+static DDS_t bench_dds_state;
+static Dither_t bench_dither;
+static Ramp_t bench_ramp;
+
+static void fill_dds(uint16_t *dst, uint32_t count)
+{
+    DDS_Fill(&bench_dds_state, dst, count);
+}
+
+static void fill_dds_scaled(uint16_t *dst, uint32_t count)
+{
+    DDS_FillScaled(&bench_dds_state, 100, 4000, dst, count);
+}
+
+static void fill_dds_scaled_ref(uint16_t *dst, uint32_t count)
+{
+    DDS_FillScaled_Ref(&bench_dds_state, 100, 4000, dst, count);
+}
+
+static void fill_dds_dither(uint16_t *dst, uint32_t count)
+{
+    Dither_FillScaled(&bench_dither, &bench_dds_state, 100, 4000, dst, count);
+}
+
+/* Block fill while a gate ramp runs: one kernel call per RAMP_CHUNK */
+static void fill_dds_ramp(uint16_t *dst, uint32_t count)
+{
+    while (count) {
+        uint16_t lo, hi;
+        uint32_t g, n;
+
+        if (!Ramp_Active(&bench_ramp))
+            Ramp_To(&bench_ramp, 100, 4000, bench_ramp.to_gate ? 0U : RAMP_UNITY);
+        n = Ramp_Next(&bench_ramp, count, &lo, &hi, &g);
+        DDS_FillScaled(&bench_dds_state, (uint16_t)((lo * g) >> 16), (uint16_t)((hi * g) >> 16), dst, n);
+        dst += n;
+        count -= n;
+    }
+}
+
+static void bench_dds(void)
+{
+    for (uint32_t i = 0; i < (1U << 12); i++)
+        dds_table[i] = (uint16_t)(i & 0x0FFF);
+
+    DDS_Init(&bench_dds_state, dds_table, 12, BENCH_SAMPLE_RATE);
+    DDS_SetFrequency_mHz(&bench_dds_state, 1234567U);
+
+    run_block_bench("DDS_Fill (4096 table)", fill_dds);
+    /* Packed gain pass runs on the C models here, see the DSP section */
+    run_block_bench("DDS_FillScaled, reference", fill_dds_scaled_ref);
+    run_block_bench("DDS_FillScaled (4096 table)", fill_dds_scaled);
+
+    DacCal_Identity(cal_lut);
+    bench_dds_state.cal = cal_lut;
+    run_block_bench("DDS_FillScaled + DAC cal", fill_dds_scaled);
+    bench_dds_state.cal = NULL;
+
+    Dither_Init(&bench_dither, 1U);
+    Dither_SetMode(&bench_dither, DITHER_TPDF);
+    run_block_bench("DDS_FillScaled + TPDF dither", fill_dds_dither);
+    Dither_SetMode(&bench_dither, DITHER_SHAPED);
+    run_block_bench("DDS_FillScaled + noise shaping", fill_dds_dither);
+
+    Ramp_Init(&bench_ramp, 100, 4000, 0, 2000U);
+    run_block_bench("DDS_FillScaled + gate ramp", fill_dds_ramp);
+}
+
+/* ========== Waveform kernels ========== */
+
+static WaveParams_t bench_wave;
+
+static void fill_waveform(uint16_t *dst, uint32_t count)
+{
+    Waveform_Fill(&bench_dds_state, &bench_wave, dst, count);
+}
+
+static void bench_waveforms(void)
+{
+    static const char *const names[WAVEFORM_COUNT] = {
+        "Waveform sine", "Waveform square", "Waveform pulse",
+        "Waveform triangle", "Waveform ramp up", "Waveform ramp down"
+    };
+
+    static const char *const blep_names[WAVEFORM_COUNT] = {
+        NULL, "PolyBLEP square", "PolyBLEP pulse",
+        NULL, "PolyBLEP ramp up", "PolyBLEP ramp down"
+    };
+
+    bench_wave.duty = Waveform_DutyFromPermille(250);
+    bench_wave.low = 100;
+    bench_wave.high = 4000;
+    bench_wave.band_limited = 0;
+    for (int f = 0; f < WAVEFORM_COUNT; f++) {
+        if (names[f] == NULL)
+            continue;
+        bench_wave.form = (Waveform_t)f;
+        run_block_bench(names[f], fill_waveform);
+    }
+
+    bench_wave.band_limited = 1;
+    for (int f = 0; f < WAVEFORM_COUNT; f++) {
+        if (blep_names[f] == NULL)
+            continue;
+        bench_wave.form = (Waveform_t)f;
+        run_block_bench(blep_names[f], fill_waveform);
+    }
+    bench_wave.band_limited = 0;
+}
+
+/* ========== Dual channel (DHR12RD words) ========== */
+
+static uint32_t dual_block[BENCH_BLOCK];
+
+static void fill_dual(uint16_t *dst, uint32_t count)
+{
+    DualDac_Fill(&bench_dds_state, &bench_wave, DUAL_DAC_PHASE_90, 1, dual_block, count);
+    dst[0] = (uint16_t)dual_block[0];
+}
+
+static void bench_dual(void)
+{
+    bench_wave.form = WAVEFORM_SINE;
+    run_block_bench("Dual sine I/Q (per frame)", fill_dual);
+    bench_wave.form = WAVEFORM_TRIANGLE;
+    run_block_bench("Dual triangle I/Q (per frame)", fill_dual);
+}
+
+/* ========== AM / FM / PM ========== */
+
+static int16_t mod_sine[1U << 10];
+static Modulation_t bench_mod;
+
+static void fill_modulation(uint16_t *dst, uint32_t count)
+{
+    Modulation_Fill(&bench_mod, &bench_dds_state, 100, 4000, dst, count);
+}
+
+static void bench_modulation(void)
+{
+    SineQ15_BuildPeriod(mod_sine, 10);
+    Modulation_Init(&bench_mod, mod_sine, 10, BENCH_SAMPLE_RATE);
+    Modulation_SetRate_mHz(&bench_mod, 100000U);
+
+    Modulation_SetAM(&bench_mod, 800);
+    run_block_bench("Modulation AM", fill_modulation);
+    Modulation_SetFM(&bench_mod, 5000000U);
+    run_block_bench("Modulation FM", fill_modulation);
+    Modulation_SetPM(&bench_mod, 1571);
+    run_block_bench("Modulation PM", fill_modulation);
+}
+
+/* ========== Noise ========== */
+
+static Noise_t bench_noise;
+
+static void fill_white(uint16_t *dst, uint32_t count)
+{
+    Noise_FillWhite(&bench_noise, 100, 4000, dst, count);
+}
+
+static void fill_pink(uint16_t *dst, uint32_t count)
+{
+    Noise_FillPink(&bench_noise, 100, 4000, dst, count);
+}
+
+static void bench_noise_sources(void)
+{
+    Noise_Init(&bench_noise, 1);
+    run_block_bench("Noise white", fill_white);
+    run_block_bench("Noise pink", fill_pink);
+
+    Noise_SetBandwidth_Hz(&bench_noise, BENCH_SAMPLE_RATE, 20000U);
+    run_block_bench("Noise white, 20 kHz band", fill_white);
+    run_block_bench("Noise pink, 20 kHz band", fill_pink);
+}
+
+/* ========== Exact-period frequency planner ========== */
+
+static const FreqPlanLimits_t plan_limits = { 108000000U, 108U, 16U, 2048U, 10U };
+static uint16_t plan_table[2048];
+static uint32_t plan_n, plan_index;
+
+static void fill_period(uint16_t *dst, uint32_t count)
+{
+    FreqPlan_FillPeriod(plan_table, plan_n, &plan_index, dst, count);
+}
+
+/* Plan every target, report time per plan, hit rate and worst error */
+static void plan_sweep(const char *name, const uint32_t *targets, uint32_t count)
+{
+    uint32_t hits = 0;
+    double worst_ppm = 0.0;
+    FreqPlan_t plan;
+
+    double t0 = now_sec();
+    for (uint32_t i = 0; i < count; i++) {
+        if (FreqPlan_Search(&plan_limits, targets[i], &plan)) {
+            double f = (double)plan_limits.timer_clk_hz / (double)plan.k;
+            double ppm = fabs(f * 1e3 / (double)targets[i] - 1.0) * 1e6;
+            if (ppm > worst_ppm) worst_ppm = ppm;
+            hits++;
+        }
+    }
+    double t1 = now_sec();
+
+    printf("%-32s %9.2f us/plan  %5.1f%% exact-capable  worst %.2f ppm\n",
+           name, (t1 - t0) * 1e6 / (double)count, 100.0 * hits / (double)count, worst_ppm);
+}
+
+static void bench_freq_plan(void)
+{
+    static uint32_t targets[10000];
+    uint32_t count = 0, x = 12345U;
+
+    /* GUI slider: 100 Hz .. 10 kHz in 100 Hz steps */
+    for (uint32_t f = 100U; f <= 10000U; f += 100U)
+        targets[count++] = f * 1000U;
+    plan_sweep("Plan, slider 100 Hz..10 kHz", targets, count);
+
+    /* Arbitrary mHz targets, 1 Hz .. 100 kHz */
+    for (count = 0; count < 10000U; count++) {
+        x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+        targets[count] = 1000U + x % 100000000U;
+    }
+    plan_sweep("Plan, random 1 Hz..100 kHz", targets, count);
+
+    plan_n = 1000U;
+    for (uint32_t i = 0; i < plan_n; i++)
+        plan_table[i] = (uint16_t)(i * 4095U / plan_n);
+    plan_index = 0;
+    run_block_bench("Exact period copy, N=1000", fill_period);
+}
+
+/* ========== DSP kernels: packed vs scalar reference ========== */
+
+/*
+ * On the host the packed kernels run on C models of the M7 instructions,
+ * so only the reference rows say anything about host speed; the packed
+ * rows are there to compare against the same loop on the target.
+ */
+static int16_t dsp_a[BENCH_BLOCK], dsp_b[BENCH_BLOCK], dsp_out[BENCH_BLOCK];
+static int16_t dsp_table[1U << 10];
+static uint32_t dsp_phase;
+
+static void fill_gain(uint16_t *dst, uint32_t count)     { Dsp_GainOffset(dsp_a, 2047, 2048, dst, count); }
+static void fill_gain_ref(uint16_t *dst, uint32_t count) { Dsp_GainOffset_Ref(dsp_a, 2047, 2048, dst, count); }
+static void fill_sat(uint16_t *dst, uint32_t count)      { Dsp_Saturate12(dsp_a, dst, count); }
+static void fill_sat_ref(uint16_t *dst, uint32_t count)  { Dsp_Saturate12_Ref(dsp_a, dst, count); }
+
+static void fill_interp(uint16_t *dst, uint32_t count)
+{
+    Dsp_InterpFill(dsp_table, 10, &dsp_phase, 0x0123456U, dsp_out, count);
+    dst[0] = (uint16_t)dsp_out[count - 1];
+}
+
+static void fill_interp_ref(uint16_t *dst, uint32_t count)
+{
+    Dsp_InterpFill_Ref(dsp_table, 10, &dsp_phase, 0x0123456U, dsp_out, count);
+    dst[0] = (uint16_t)dsp_out[count - 1];
+}
+
+static void fill_mix(uint16_t *dst, uint32_t count)
+{
+    Dsp_Mix2(dsp_a, 16384, dsp_b, 16384, dsp_out, count);
+    dst[0] = (uint16_t)dsp_out[count - 1];
+}
+
+static void fill_mix_ref(uint16_t *dst, uint32_t count)
+{
+    Dsp_Mix2_Ref(dsp_a, 16384, dsp_b, 16384, dsp_out, count);
+    dst[0] = (uint16_t)dsp_out[count - 1];
+}
+
+static void bench_dsp_kernels(void)
+{
+    for (uint32_t i = 0; i < BENCH_BLOCK; i++) {
+        dsp_a[i] = (int16_t)(i * 977U);
+        dsp_b[i] = (int16_t)(i * 1531U);
+    }
+    for (uint32_t i = 0; i < (1U << 10); i++)
+        dsp_table[i] = (int16_t)(32767.0 * sin(2.0 * M_PI * i / 1024.0));
+
+    run_block_bench("Gain/offset, reference", fill_gain_ref);
+    run_block_bench("Gain/offset, packed", fill_gain);
+    run_block_bench("Saturate 12-bit, reference", fill_sat_ref);
+    run_block_bench("Saturate 12-bit, packed", fill_sat);
+    run_block_bench("Interp lookup, reference", fill_interp_ref);
+    run_block_bench("Interp lookup, packed", fill_interp);
+    run_block_bench("Mix 2 sources, reference", fill_mix_ref);
+    run_block_bench("Mix 2 sources, packed", fill_mix);
+}
+
+/* ========== Additive synthesis: table build ========== */
+
+#define HARM_REPS   200U
+
+static int32_t harm_work[1U << 10];
+static int16_t harm_out[1U << 10];
+static float harm_float[1U << 10];
+
+/* The straightforward N x K sinf() build, for comparison */
+static void harm_build_sinf(const Harmonics_t *h)
+{
+    float peak = 0.0f;
+
+    for (uint32_t i = 0; i < (1U << 10); i++) {
+        float v = 0.0f;
+        for (uint32_t k = 1; k <= h->count; k++)
+            v += h->amp_q15[k - 1] * sinf(6.2831853f * ((float)(k * i) / 1024.0f
+                                                        + (float)h->phase[k - 1] / 4294967296.0f));
+        harm_float[i] = v;
+        if (fabsf(v) > peak) peak = fabsf(v);
+    }
+    for (uint32_t i = 0; i < (1U << 10); i++)
+        harm_out[i] = (int16_t)lrintf(harm_float[i] * 32767.0f / peak);
+}
+
+static void bench_harmonics(void)
+{
+    Harmonics_t h;
+    double t0, t1;
+    uint64_t c0, c1;
+
+    SineQ15_BuildPeriod(dsp_table, 10);
+    Harmonics_Clear(&h);
+    for (uint32_t k = 1; k <= HARMONICS_MAX; k++)
+        Harmonics_Set(&h, k, (int16_t)(32767 / k), k * 0x05000000U);
+
+    t0 = now_sec();
+    c0 = now_cycles();
+    for (uint32_t r = 0; r < HARM_REPS; r++) {
+        Harmonics_Build(&h, dsp_table, 10, harm_work, harm_out, 10);
+        sink += (uint32_t)harm_out[r & 1023U];
+    }
+    c1 = now_cycles();
+    t1 = now_sec();
+    printf("%-32s %9.1f us/table  %6.2f cyc/sample/harmonic\n", "Harmonics 32 x 1024, oscillators",
+           (t1 - t0) * 1e6 / HARM_REPS, (double)(c1 - c0) / HARM_REPS / 1024.0 / HARMONICS_MAX);
+
+    t0 = now_sec();
+    c0 = now_cycles();
+    for (uint32_t r = 0; r < HARM_REPS; r++) {
+        harm_build_sinf(&h);
+        sink += (uint32_t)harm_out[r & 1023U];
+    }
+    c1 = now_cycles();
+    t1 = now_sec();
+    printf("%-32s %9.1f us/table  %6.2f cyc/sample/harmonic\n", "Harmonics 32 x 1024, sinf()",
+           (t1 - t0) * 1e6 / HARM_REPS, (double)(c1 - c0) / HARM_REPS / 1024.0 / HARMONICS_MAX);
+}
+
+/* ========== Segment sequencer ========== */
+
+/*
+ * Sine / square / DC segments of equal length L: the shorter L, the more
+ * pieces per block. The fitted intercept is the cost of one segment
+ * switch; the block cost at each L shows where it starts to dominate.
+ */
+static Sequencer_t bench_seq;
+
+static uint32_t seq_cycles(void)
+{
+    return (uint32_t)now_cycles();
+}
+
+static void fill_sequence(uint16_t *dst, uint32_t count)
+{
+    Seq_Fill(&bench_seq, &bench_dds_state, dst, count);
+}
+
+static void bench_sequencer(void)
+{
+    static const uint32_t lengths_us[] = { 10000U, 500U, 100U, 30U, 10U };
+    WaveParams_t sine = { WAVEFORM_SINE, 0, 100, 4000, 1 };
+    WaveParams_t square = { WAVEFORM_SQUARE, 0, 100, 4000, 1 };
+    char name[48];
+
+    DDS_Init(&bench_dds_state, dds_table, 12, BENCH_SAMPLE_RATE);
+    for (unsigned l = 0; l < sizeof(lengths_us) / sizeof(lengths_us[0]); l++) {
+        uint32_t overhead = 0, slope_q8 = 0;
+
+        Seq_Init(&bench_seq, BENCH_SAMPLE_RATE, seq_cycles);
+        Seq_Add(&bench_seq, &sine, 1000000U, lengths_us[l]);
+        Seq_Add(&bench_seq, &square, 5000000U, lengths_us[l]);
+        Seq_AddDC(&bench_seq, 2048, lengths_us[l]);
+        Seq_SetLoop(&bench_seq, 1);
+        Seq_Rewind(&bench_seq, &bench_dds_state);
+
+        snprintf(name, sizeof(name), "Sequencer, %u us segments", (unsigned)lengths_us[l]);
+        run_block_bench(name, fill_sequence);
+        Seq_Overhead(&bench_seq.stats, &overhead, &slope_q8);
+        printf("%-32s %9u cyc/segment  %6.2f cyc/sample fit  %u switches\n", "",
+               (unsigned)overhead, slope_q8 / 256.0, (unsigned)bench_seq.stats.switches);
+    }
+}
+
+/* ========== Multi-tone mixing ========== */
+
+/*
+ * N full-scale tones mixed into the block; the cost grows by one table
+ * read and one MAC per tone per sample on top of a fixed scaling pass.
+ * On target SignalGen_MultiToneMax() times the same fills with DWT and
+ * hands back cycles per block for each tone count.
+ */
+static MultiTone_t bench_mt;
+
+static void fill_multitone(uint16_t *dst, uint32_t count)
+{
+    MultiTone_Fill(&bench_mt, 100, 4000, NULL, dst, count);
+}
+
+static void bench_multitone(void)
+{
+    static const uint32_t counts[] = { 1, 2, 4, 8 };
+    char name[48];
+
+    SineQ15_BuildPeriod(mod_sine, 10);
+    for (unsigned c = 0; c < sizeof(counts) / sizeof(counts[0]); c++) {
+        MultiTone_Init(&bench_mt, mod_sine, 10, BENCH_SAMPLE_RATE);
+        for (uint32_t k = 0; k < counts[c]; k++)
+            MultiTone_Add(&bench_mt, 1000U * (697U + 150U * k), 1000U, 0);
+
+        snprintf(name, sizeof(name), "Multi-tone x%u", (unsigned)counts[c]);
+        run_block_bench(name, fill_multitone);
+    }
+}
+
+/* ========== Alias rejection: naive vs PolyBLEP ========== */
+
+/*
+ * Coherent capture: tuning = k0 << 16 puts exactly k0 periods in
+ * SFDR_N samples, so every harmonic lands on a single bin. Harmonics
+ * below Nyquist belong to the waveform; anything else (except DC) is an
+ * alias, and the worst of them sets the alias-limited SFDR.
+ */
+#define SFDR_BITS   16U
+#define SFDR_N      (1U << SFDR_BITS)
+
+static uint16_t sfdr_samples[SFDR_N];
+static double sfdr_re[SFDR_N];
+static double sfdr_im[SFDR_N];
+
+static void fft(double *re, double *im, uint32_t n)
+{
+    for (uint32_t i = 1, j = 0; i < n; i++) {
+        uint32_t bit = n >> 1;
+        for (; j & bit; bit >>= 1)
+            j ^= bit;
+        j |= bit;
+        if (i < j) {
+            double t = re[i]; re[i] = re[j]; re[j] = t;
+            t = im[i]; im[i] = im[j]; im[j] = t;
+        }
+    }
+    for (uint32_t len = 2; len <= n; len <<= 1) {
+        double a = -2.0 * 3.14159265358979323846 / (double)len;
+        double wr = cos(a), wi = sin(a);
+        for (uint32_t i = 0; i < n; i += len) {
+            double cr = 1.0, ci = 0.0;
+            for (uint32_t k = 0; k < len / 2; k++) {
+                uint32_t u = i + k, v = i + k + len / 2;
+                double xr = re[v] * cr - im[v] * ci;
+                double xi = re[v] * ci + im[v] * cr;
+                re[v] = re[u] - xr; im[v] = im[u] - xi;
+                re[u] += xr;        im[u] += xi;
+                double t = cr * wr - ci * wi;
+                ci = cr * wi + ci * wr;
+                cr = t;
+            }
+        }
+    }
+}
+
+static double alias_sfdr_db(Waveform_t form, int band_limited, uint32_t k0)
+{
+    DDS_t dds;
+    WaveParams_t p = { form, 0x80000000U, 0, 4095, (uint8_t)band_limited };
+    uint8_t harmonic[SFDR_N / 2 + 1] = { 0 };
+    double fund, spur = 0.0;
+
+    DDS_Init(&dds, dds_table, 12, BENCH_SAMPLE_RATE);
+    dds.tuning_word = k0 << 16;
+    for (uint32_t i = 0; i < SFDR_N; i += BENCH_BLOCK)
+        Waveform_Fill(&dds, &p, sfdr_samples + i, BENCH_BLOCK);
+
+    for (uint32_t i = 0; i < SFDR_N; i++) {
+        sfdr_re[i] = (double)sfdr_samples[i];
+        sfdr_im[i] = 0.0;
+    }
+    fft(sfdr_re, sfdr_im, SFDR_N);
+
+    for (uint32_t h = k0; h <= SFDR_N / 2; h += k0)
+        harmonic[h] = 1;
+
+    fund = hypot(sfdr_re[k0], sfdr_im[k0]);
+    for (uint32_t b = 1; b <= SFDR_N / 2; b++) {
+        double m = hypot(sfdr_re[b], sfdr_im[b]);
+        if (!harmonic[b] && m > spur)
+            spur = m;
+    }
+    return 20.0 * log10(fund / spur);
+}
+
+static void bench_alias(void)
+{
+    static const uint32_t k0s[] = { 1229, 4099, 6553 };     /* ~18.8, 62.5, 100 kHz */
+    static const Waveform_t forms[] = { WAVEFORM_SQUARE, WAVEFORM_RAMP_UP };
+
+    printf("\nAlias-limited SFDR, %u-point FFT (dBc, higher is better)\n", SFDR_N);
+    for (unsigned f = 0; f < sizeof(forms) / sizeof(forms[0]); f++) {
+        for (unsigned k = 0; k < sizeof(k0s) / sizeof(k0s[0]); k++) {
+            double hz = (double)k0s[k] * BENCH_SAMPLE_RATE / SFDR_N;
+            printf("%-8s %7.1f Hz   naive %6.1f dBc   PolyBLEP %6.1f dBc\n",
+                   Waveform_Name(forms[f]), hz,
+                   alias_sfdr_db(forms[f], 0, k0s[k]),
+                   alias_sfdr_db(forms[f], 1, k0s[k]));
+        }
+    }
+}
+
+/* ========== Table generation: float sinf() vs Q15 quarter wave ========== */
+
+#define BENCH_TABLE_BITS    10U
+#define BENCH_TABLE_LEN     (1U << BENCH_TABLE_BITS)
+#define BENCH_TABLE_REPS    2000U
+
+static uint16_t table_out[BENCH_TABLE_LEN];
+
+/* The pre-Q15 Generete_SineTable() body */
+static void build_float_table(int touch_value)
+{
+    float max_dac_val = (touch_value * 4095.0f) / 33.0f;
+
+    for (uint32_t i = 0; i < BENCH_TABLE_LEN; i++) {
+        float value = (sinf((2.0f * 3.14159265358979323846f * i) / BENCH_TABLE_LEN) + 1.0f) * max_dac_val / 2.0f;
+        if (value < 0.0f) value = 0.0f;
+        if (value > max_dac_val) value = max_dac_val;
+        table_out[i] = (uint16_t)value;
+    }
+}
+
+static void bench_sine_tables(void)
+{
+    double t0 = now_sec();
+    uint64_t c0 = now_cycles();
+    for (uint32_t r = 0; r < BENCH_TABLE_REPS; r++) {
+        build_float_table((int)(r % 34U));
+        sink += table_out[r & (BENCH_TABLE_LEN - 1)];
+    }
+    uint64_t c1 = now_cycles();
+    double t1 = now_sec();
+    bench_report("Sine table, float sinf()", (uint64_t)BENCH_TABLE_LEN * BENCH_TABLE_REPS, t1 - t0, c1 - c0);
+
+    t0 = now_sec();
+    c0 = now_cycles();
+    for (uint32_t r = 0; r < BENCH_TABLE_REPS; r++) {
+        SineQ15_BuildDac(table_out, BENCH_TABLE_BITS, ((r % 34U) * 4095U + 16U) / 33U);
+        sink += table_out[r & (BENCH_TABLE_LEN - 1)];
+    }
+    c1 = now_cycles();
+    t1 = now_sec();
+    bench_report("Sine table, Q15 quarter wave", (uint64_t)BENCH_TABLE_LEN * BENCH_TABLE_REPS, t1 - t0, c1 - c0);
+}
+
+int main(void)
+{
+    printf("Signal generator host benchmarks (%u-sample blocks)\n\n", BENCH_BLOCK);
+
+    bench_dds();
+    bench_sine_tables();
+    bench_waveforms();
+    bench_dual();
+    bench_modulation();
+    bench_noise_sources();
+    bench_freq_plan();
+    bench_dsp_kernels();
+    bench_harmonics();
+    bench_sequencer();
+    bench_multitone();
+    bench_alias();
+
+    return 0;
+}
@@ -0,0 +1,147 @@
+/**
+ * @file test_blep.c
+ * @brief Unit tests for the PolyBLEP band-limited kernels
+ *
+ * Build (host):
+ *   gcc -O2 -I../STM32CubeIDE/Signal_gen test_blep.c ../STM32CubeIDE/Signal_gen/blep.c \
+ *       ../STM32CubeIDE/Signal_gen/waveform.c ../STM32CubeIDE/Signal_gen/dds.c -o test_blep
+ */
+
+#include <stdint.h>
+#include "test_common.h"
+#include "blep.h"
+#include "waveform.h"
+
+#define N       1024U           /* samples per period in these tests */
+#define FS_HZ   1000000U
+
+static uint16_t naive[N];
+static uint16_t out[N];
+static uint16_t dummy_table[4];
+
+static void setup(DDS_t *dds, uint32_t tuning)
+{
+    DDS_Init(dds, dummy_table, 2, FS_HZ);
+    dds->tuning_word = tuning;
+}
+
+static void fill(uint16_t *dst, Waveform_t form, int band_limited, uint32_t tuning)
+{
+    DDS_t dds;
+    WaveParams_t p = { form, Waveform_DutyFromPermille(300), 0, 4095, (uint8_t)band_limited };
+
+    setup(&dds, tuning);
+    Waveform_Fill(&dds, &p, dst, N);
+}
+
+/**
+ * Test: residual is -1/2 right after the edge, +1/2 right before it, 0 outside
+ */
+int test_residual_shape(void)
+{
+    const uint32_t dt = 0x01000000U;
+    const uint64_t inv = Blep_InvDt(dt);
+
+    TEST_ASSERT_EQUAL(-32768, Blep_Residual(0, dt, inv), "Full step at the edge");
+    TEST_ASSERT_NEAR(-8192, Blep_Residual(dt / 2, dt, inv), 1, "Quarter step half a sample after");
+    TEST_ASSERT_NEAR(8192, Blep_Residual(0U - dt / 2, dt, inv), 1, "Quarter step half a sample before");
+    TEST_ASSERT_EQUAL(0, Blep_Residual(dt, dt, inv), "Zero one sample after");
+    TEST_ASSERT_EQUAL(0, Blep_Residual(0U - dt, dt, inv), "Zero one sample before");
+    TEST_ASSERT_EQUAL(0, Blep_Residual(0x80000000U, dt, inv), "Zero far from the edge");
+    return 1;
+}
+
+/**
+ * Test: only the samples next to a discontinuity differ from the naive kernel
+ */
+int test_matches_naive_away_from_edges(void)
+{
+    static const Waveform_t forms[] = { WAVEFORM_SQUARE, WAVEFORM_PULSE, WAVEFORM_RAMP_UP, WAVEFORM_RAMP_DOWN };
+    const uint32_t tuning = 0xFFFFFFFFU / N + 1U;
+
+    for (unsigned f = 0; f < sizeof(forms) / sizeof(forms[0]); f++) {
+        uint32_t differ = 0;
+
+        fill(naive, forms[f], 0, tuning);
+        fill(out, forms[f], 1, tuning);
+        for (uint32_t i = 0; i < N; i++) {
+            if (out[i] != naive[i]) {
+                differ++;
+                TEST_ASSERT_NEAR(naive[i], out[i], 2048, "Correction bounded by half a step");
+            }
+        }
+        /* Two edges per period, at most two corrected samples each */
+        TEST_ASSERT(differ <= 4, "Corrections limited to edge samples");
+    }
+    return 1;
+}
+
+/**
+ * Test: an edge landing exactly on a sample lands at mid-level
+ */
+int test_square_edge_midpoint(void)
+{
+    fill(out, WAVEFORM_SQUARE, 1, 0xFFFFFFFFU / N + 1U);
+
+    TEST_ASSERT_NEAR(2048, out[0], 1, "Rising edge sample mid-level");
+    TEST_ASSERT_NEAR(2048, out[N / 2], 1, "Falling edge sample mid-level");
+    TEST_ASSERT_EQUAL(4095, out[N / 4], "High plateau untouched");
+    TEST_ASSERT_EQUAL(0, out[3 * N / 4], "Low plateau untouched");
+    return 1;
+}
+
+/**
+ * Test: output stays inside the swing at high fundamentals
+ */
+int test_levels_respected(void)
+{
+    static const uint32_t tunings[] = { 0x00100000U, 0x0A3D70A4U, 0x33333333U, 0x7FFFFFFFU, 0xC0000000U };
+    static const Waveform_t forms[] = { WAVEFORM_SQUARE, WAVEFORM_PULSE, WAVEFORM_RAMP_UP, WAVEFORM_RAMP_DOWN };
+
+    for (unsigned t = 0; t < sizeof(tunings) / sizeof(tunings[0]); t++) {
+        for (unsigned f = 0; f < sizeof(forms) / sizeof(forms[0]); f++) {
+            fill(out, forms[f], 1, tunings[t]);
+            for (uint32_t i = 0; i < N; i++)
+                TEST_ASSERT(out[i] <= 4095, "Sample inside swing");
+        }
+    }
+    return 1;
+}
+
+/**
+ * Test: phase carries across blocks, so a split render equals a whole one
+ */
+int test_block_continuity(void)
+{
+    static const Waveform_t forms[] = { WAVEFORM_SQUARE, WAVEFORM_PULSE, WAVEFORM_RAMP_UP, WAVEFORM_RAMP_DOWN };
+    DDS_t a, b;
+
+    for (unsigned f = 0; f < sizeof(forms) / sizeof(forms[0]); f++) {
+        WaveParams_t p = { forms[f], Waveform_DutyFromPermille(300), 0, 4095, 1 };
+
+        setup(&a, 0x0A3D70A4U);     /* 40 kHz, edges off the sample grid */
+        setup(&b, 0x0A3D70A4U);
+        Waveform_Fill(&a, &p, naive, N);
+        Waveform_Fill(&b, &p, out, 333);
+        Waveform_Fill(&b, &p, out + 333, N - 333);
+        for (uint32_t i = 0; i < N; i++)
+            TEST_ASSERT_EQUAL(naive[i], out[i], "Split block equals whole block");
+    }
+    return 1;
+}
+
+int main(void)
+{
+    printf("========================================\n");
+    printf("PolyBLEP Kernel Unit Tests\n");
+    printf("========================================\n\n");
+
+    RUN_TEST(test_residual_shape);
+    RUN_TEST(test_matches_naive_away_from_edges);
+    RUN_TEST(test_square_edge_midpoint);
+    RUN_TEST(test_levels_respected);
+    RUN_TEST(test_block_continuity);
+
+    TEST_SUMMARY();
+    return (tests_passed == tests_run) ? 0 : 1;
+}
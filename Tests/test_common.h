@@ -0,0 +1,56 @@
+/**
+ * @file test_common.h
+ * @brief Minimal assertion/runner macros shared by the host unit tests
+ *
+ * Same conventions as test_signal_gen.c: each test returns 1 on pass,
+ * 0 on the first failed assertion.
+ */
+
+#ifndef TEST_COMMON_H
+#define TEST_COMMON_H
+
+#include <stdio.h>
+#include <stdlib.h>
+
+static int tests_run = 0;
+static int tests_passed = 0;
+
+#define TEST_ASSERT(condition, message) do { \
+    if (!(condition)) { \
+        printf("  [FAIL] %s\n", message); \
+        return 0; \
+    } \
+} while(0)
+
+#define TEST_ASSERT_EQUAL(expected, actual, message) do { \
+    if ((expected) != (actual)) { \
+        printf("  [FAIL] %s: expected %ld, got %ld\n", message, (long)(expected), (long)(actual)); \
+        return 0; \
+    } \
+} while(0)
+
+#define TEST_ASSERT_NEAR(expected, actual, tolerance, message) do { \
+    long diff = labs((long)(expected) - (long)(actual)); \
+    if (diff > (long)(tolerance)) { \
+        printf("  [FAIL] %s: expected %ld, got %ld (diff=%ld, tolerance=%ld)\n", \
+               message, (long)(expected), (long)(actual), diff, (long)(tolerance)); \
+        return 0; \
+    } \
+} while(0)
+
+#define RUN_TEST(test_func) do { \
+    tests_run++; \
+    printf("Running: %s\n", #test_func); \
+    if (test_func()) { \
+        tests_passed++; \
+        printf("  [PASS]\n"); \
+    } \
+} while(0)
+
+#define TEST_SUMMARY() do { \
+    printf("\n========================================\n"); \
+    printf("Test Results: %d/%d passed\n", tests_passed, tests_run); \
+    printf("========================================\n"); \
+} while(0)
+
+#endif /* TEST_COMMON_H */
@@ -0,0 +1,182 @@
+/**
+ * @file test_dac_cal.c
+ * @brief Unit tests for the DAC calibration table and its use in the kernels
+ *
+ * Build (host):
+ *   gcc -O2 -I../STM32CubeIDE/Signal_gen test_dac_cal.c ../STM32CubeIDE/Signal_gen/dac_cal.c \
+ *       ../STM32CubeIDE/Signal_gen/waveform.c ../STM32CubeIDE/Signal_gen/dds.c \
+ *       ../STM32CubeIDE/Signal_gen/blep.c -lm -o test_dac_cal
+ */
+
+#include <stdint.h>
+#include <math.h>
+#include "test_common.h"
+#include "dac_cal.h"
+#include "waveform.h"
+
+#define VREF_UV     3300000
+
+static uint16_t lut[DAC_CAL_CODES];
+
+/* Ideal output of a code, uV */
+static double ideal_uv(double code)
+{
+    return code * VREF_UV / 4095.0;
+}
+
+/* Simulated DAC: gain error, offset and a parabolic INL bow (peak at mid-scale) */
+static double dac_uv(double code)
+{
+    double x = code / 4095.0;
+
+    return 2500.0 + ideal_uv(code) * 0.995 + 4.0 * 1600.0 * x * (1.0 - x);
+}
+
+static void measure(DacCalPoint_t *pts, uint32_t count)
+{
+    for (uint32_t i = 0; i < count; i++) {
+        pts[i].code = DacCal_ProbeCode(i, count);
+        pts[i].out_uv = (int32_t)lround(dac_uv(pts[i].code));
+    }
+}
+
+/**
+ * Test: probe codes span the full scale evenly
+ */
+int test_probe_codes(void)
+{
+    TEST_ASSERT_EQUAL(0, DacCal_ProbeCode(0, 33), "First");
+    TEST_ASSERT_EQUAL(128, DacCal_ProbeCode(1, 33), "Second");
+    TEST_ASSERT_EQUAL(2048, DacCal_ProbeCode(16, 33), "Middle");
+    TEST_ASSERT_EQUAL(4095, DacCal_ProbeCode(32, 33), "Last");
+    TEST_ASSERT_EQUAL(4095, DacCal_ProbeCode(1, 2), "Two points: end");
+    return 1;
+}
+
+/**
+ * Test: ideal measurements give the identity table
+ */
+int test_ideal_is_identity(void)
+{
+    DacCalPoint_t pts[DAC_CAL_MAX_POINTS];
+
+    for (uint32_t i = 0; i < DAC_CAL_MAX_POINTS; i++) {
+        pts[i].code = DacCal_ProbeCode(i, DAC_CAL_MAX_POINTS);
+        pts[i].out_uv = (int32_t)lround(ideal_uv(pts[i].code));
+    }
+    TEST_ASSERT(DacCal_Build(pts, DAC_CAL_MAX_POINTS, VREF_UV, lut), "Build");
+    for (uint32_t c = 0; c < DAC_CAL_CODES; c++)
+        TEST_ASSERT_EQUAL(c, lut[c], "Identity");
+    return 1;
+}
+
+/**
+ * Test: 33 points correct gain, offset and INL to within one code
+ */
+int test_corrects_inl(void)
+{
+    DacCalPoint_t pts[DAC_CAL_MAX_POINTS];
+    const double lsb = VREF_UV / 4095.0;
+    double worst_raw = 0.0, worst_cal = 0.0;
+
+    measure(pts, DAC_CAL_MAX_POINTS);
+    TEST_ASSERT(DacCal_Build(pts, DAC_CAL_MAX_POINTS, VREF_UV, lut), "Build");
+
+    /* Codes the DAC can reach: the offset takes away the bottom ~3 codes */
+    for (uint32_t c = 8; c < 4070U; c++) {
+        double raw = fabs(dac_uv(c) - ideal_uv(c)) / lsb;
+        double cal = fabs(dac_uv(lut[c]) - ideal_uv(c)) / lsb;
+
+        if (raw > worst_raw) worst_raw = raw;
+        if (cal > worst_cal) worst_cal = cal;
+    }
+    TEST_ASSERT(worst_raw > 5.0, "Uncorrected DAC is off by several codes");
+    TEST_ASSERT(worst_cal <= 1.0, "Corrected within one code");
+    TEST_ASSERT_EQUAL(0, lut[0], "Clamped at zero");
+    return 1;
+}
+
+/**
+ * Test: two points correct gain and offset only
+ */
+int test_two_point(void)
+{
+    DacCalPoint_t pts[2] = { { 0, 10000 }, { 4095, VREF_UV - 10000 } };
+
+    TEST_ASSERT(DacCal_Build(pts, 2, VREF_UV, lut), "Build");
+    TEST_ASSERT_EQUAL(0, lut[0], "Below offset clamps");
+    TEST_ASSERT_EQUAL(2048, lut[2048], "Mid-scale symmetric");
+    TEST_ASSERT_EQUAL(4095, lut[4095], "Above range clamps");
+    /* 1000 codes: 805860 uV wanted, slope 3280000 / 4095 */
+    TEST_ASSERT_EQUAL(994, lut[1000], "Scaled");
+    return 1;
+}
+
+/**
+ * Test: malformed point sets are refused
+ */
+int test_rejects_bad_points(void)
+{
+    DacCalPoint_t flat[2] = { { 0, 0 }, { 4095, 0 } };
+    DacCalPoint_t order[3] = { { 0, 0 }, { 2000, 2000000 }, { 1000, 3000000 } };
+    DacCalPoint_t range[2] = { { 0, 0 }, { 5000, 3300000 } };
+
+    TEST_ASSERT(!DacCal_Build(flat, 2, VREF_UV, lut), "Output not rising");
+    TEST_ASSERT(!DacCal_Build(order, 3, VREF_UV, lut), "Codes not rising");
+    TEST_ASSERT(!DacCal_Build(range, 2, VREF_UV, lut), "Code out of range");
+    TEST_ASSERT(!DacCal_Build(flat, 1, VREF_UV, lut), "One point");
+    return 1;
+}
+
+/**
+ * Test: kernels store through the table; without it they are unchanged
+ */
+int test_kernels_apply_table(void)
+{
+    static uint16_t table[256], plain[300], corrected[300];
+    static const Waveform_t forms[] = { WAVEFORM_SINE, WAVEFORM_SQUARE, WAVEFORM_PULSE,
+                                        WAVEFORM_TRIANGLE, WAVEFORM_RAMP_UP, WAVEFORM_RAMP_DOWN };
+    WaveParams_t p = { WAVEFORM_SINE, 0x40000000U, 300, 3800, 1 };
+    DDS_t dds;
+
+    for (uint32_t i = 0; i < 256U; i++)
+        table[i] = (uint16_t)(32768.0 + 32767.0 * sin(2.0 * 3.14159265358979 * i / 256.0));
+    for (uint32_t c = 0; c < DAC_CAL_CODES; c++)
+        lut[c] = (uint16_t)(4095U - c);
+
+    for (unsigned f = 0; f < sizeof(forms) / sizeof(forms[0]); f++) {
+        p.form = forms[f];
+        for (int bl = 0; bl < 2; bl++) {
+            p.band_limited = (uint8_t)bl;
+            DDS_Init(&dds, table, 8, 1000000U);
+            DDS_SetFrequency_mHz(&dds, 37000000U);
+            Waveform_Fill(&dds, &p, plain, 300);
+
+            DDS_Init(&dds, table, 8, 1000000U);
+            DDS_SetFrequency_mHz(&dds, 37000000U);
+            dds.cal = lut;
+            Waveform_Fill(&dds, &p, corrected, 300);
+
+            for (uint32_t i = 0; i < 300U; i++)
+                TEST_ASSERT_EQUAL(lut[plain[i]], corrected[i], "Corrected sample");
+        }
+    }
+    return 1;
+}
+
+int main(void)
+{
+    printf("========================================\n");
+    printf("DAC Calibration Unit Tests\n");
+    printf("========================================\n\n");
+
+    RUN_TEST(test_probe_codes);
+    RUN_TEST(test_ideal_is_identity);
+    RUN_TEST(test_corrects_inl);
+    RUN_TEST(test_two_point);
+    RUN_TEST(test_rejects_bad_points);
+    RUN_TEST(test_kernels_apply_table);
+
+    TEST_SUMMARY();
+    return (tests_passed == tests_run) ? 0 : 1;
+}
@@ -0,0 +1,131 @@
+/**
+ * @file test_dac_wave.c
+ * @brief Unit tests for the DAC built-in triangle/noise planner
+ *
+ * Build (host):
+ *   gcc -O2 -I../STM32CubeIDE/Signal_gen test_dac_wave.c \
+ *       ../STM32CubeIDE/Signal_gen/dac_wave.c ../STM32CubeIDE/Signal_gen/freq_plan.c -o test_dac_wave
+ */
+
+#include <stdint.h>
+#include "test_common.h"
+#include "dac_wave.h"
+
+#define TIM_CLK_HZ  108000000U
+
+static const FreqPlanLimits_t lim = { TIM_CLK_HZ, 108U, 0U, 0U, 1000U };
+
+/* |f_plan / f_target - 1| in ppm */
+static uint64_t error_ppm(const DacWave_t *w, uint32_t freq_mhz)
+{
+    uint64_t ideal = (uint64_t)freq_mhz * w->timer.k;
+    uint64_t clk = (uint64_t)TIM_CLK_HZ * 1000U;
+    uint64_t diff = (clk > ideal) ? clk - ideal : ideal - clk;
+
+    return diff * 1000000U / ideal;
+}
+
+/**
+ * Test: only 2^n - 1 swings map onto MAMP
+ */
+int test_amplitude_bits(void)
+{
+    TEST_ASSERT_EQUAL(12, DacWave_AmplitudeBits(0, 4095), "Full scale");
+    TEST_ASSERT_EQUAL(10, DacWave_AmplitudeBits(100, 1123), "Offset swing");
+    TEST_ASSERT_EQUAL(1, DacWave_AmplitudeBits(0, 1), "One LSB");
+    TEST_ASSERT_EQUAL(0, DacWave_AmplitudeBits(0, 4094), "Not 2^n - 1");
+    TEST_ASSERT_EQUAL(0, DacWave_AmplitudeBits(5, 5), "Zero swing");
+    TEST_ASSERT_EQUAL(0, DacWave_AmplitudeBits(10, 5), "Inverted swing");
+    return 1;
+}
+
+/**
+ * Test: full-scale triangle pins N to 8190 and moves only the timer
+ */
+int test_triangle_full_scale(void)
+{
+    DacWave_t w;
+
+    TEST_ASSERT(DacWave_PlanTriangle(&lim, 0, 4095, 10000U, &w), "10 Hz has a plan");
+    TEST_ASSERT_EQUAL(DACWAVE_TRIANGLE, w.kind, "Triangle");
+    TEST_ASSERT_EQUAL(12, w.bits, "MAMP for 4095");
+    TEST_ASSERT_EQUAL(0, w.base, "Base at low");
+    TEST_ASSERT_EQUAL(8190, w.timer.n, "Counter period");
+    TEST_ASSERT((w.timer.psc + 1U) * (w.timer.arr + 1U) >= 108U, "Within DAC rate");
+    TEST_ASSERT(error_ppm(&w, 10000U) <= 1000U, "Error within tolerance");
+    TEST_ASSERT_NEAR(10000, DacWave_Frequency_mHz(&lim, &w), 10, "Reported frequency");
+    return 1;
+}
+
+/**
+ * Test: the counter period caps the triangle frequency at the DAC rate
+ */
+int test_triangle_limits(void)
+{
+    DacWave_t w;
+
+    /* 1 MS/s / 8190 = 122 Hz */
+    TEST_ASSERT(DacWave_PlanTriangle(&lim, 0, 4095, 122000U, &w), "122 Hz fits");
+    TEST_ASSERT(!DacWave_PlanTriangle(&lim, 0, 4095, 200000U, &w), "200 Hz too fast");
+    TEST_ASSERT(!DacWave_PlanTriangle(&lim, 0, 4000, 10000U, &w), "Swing not 2^n - 1");
+
+    /* 255-step swing: period 510 triggers, 108e6 / (200 * 510) Hz exactly */
+    TEST_ASSERT(DacWave_PlanTriangle(&lim, 1000, 1255, 1058824U, &w), "Small swing, higher f");
+    TEST_ASSERT_EQUAL(510, w.timer.n, "Counter period");
+    TEST_ASSERT_EQUAL(200, (w.timer.psc + 1U) * (w.timer.arr + 1U), "Timer divider");
+    TEST_ASSERT_EQUAL(1000, w.base, "Base at low");
+    return 1;
+}
+
+/**
+ * Test: every accepted triangle plan stays within tolerance
+ */
+int test_triangle_tolerance(void)
+{
+    for (uint32_t f = 100U; f <= 122000U; f += 100U) {
+        DacWave_t w;
+
+        if (!DacWave_PlanTriangle(&lim, 0, 4095, f, &w)) {
+            /* Divider >= 500 (f <= 26 Hz) is always within 0.1 % */
+            TEST_ASSERT(f > 26000U, "Low frequencies always covered");
+            continue;
+        }
+        TEST_ASSERT(error_ppm(&w, f) <= 1000U, "Error within tolerance");
+        TEST_ASSERT(w.timer.psc <= 0xFFFFU && w.timer.arr <= 0xFFFFU, "16-bit timer fields");
+    }
+    return 1;
+}
+
+/**
+ * Test: LFSR noise runs at the full DAC rate, swing rule as for triangle
+ */
+int test_noise(void)
+{
+    DacWave_t w;
+
+    TEST_ASSERT(DacWave_PlanNoise(&lim, 0, 4095, &w), "Full-scale noise");
+    TEST_ASSERT_EQUAL(DACWAVE_NOISE, w.kind, "Noise");
+    TEST_ASSERT_EQUAL(12, w.bits, "Unmask 12 bits");
+    TEST_ASSERT_EQUAL(0, w.timer.psc, "No prescaler");
+    TEST_ASSERT_EQUAL(107, w.timer.arr, "1 MS/s");
+    TEST_ASSERT(DacWave_PlanNoise(&lim, 2048, 2048 + 511, &w), "Offset noise");
+    TEST_ASSERT_EQUAL(9, w.bits, "Unmask 9 bits");
+    TEST_ASSERT(!DacWave_PlanNoise(&lim, 0, 3000, &w), "Swing not 2^n - 1");
+    return 1;
+}
+
+int main(void)
+{
+    printf("========================================\n");
+    printf("DAC Wave Generator Unit Tests\n");
+    printf("========================================\n\n");
+
+    RUN_TEST(test_amplitude_bits);
+    RUN_TEST(test_triangle_full_scale);
+    RUN_TEST(test_triangle_limits);
+    RUN_TEST(test_triangle_tolerance);
+    RUN_TEST(test_noise);
+
+    TEST_SUMMARY();
+    return (tests_passed == tests_run) ? 0 : 1;
+}
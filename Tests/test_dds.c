@@ -0,0 +1,264 @@
+/**
+ * @file test_dds.c
+ * @brief Unit tests for the DDS phase-accumulator core
+ *
+ * Build (host):
+ *   gcc -O2 -I../STM32CubeIDE/Signal_gen test_dds.c ../STM32CubeIDE/Signal_gen/dds.c -o test_dds
+ */
+
+#include <stdint.h>
+#include "test_common.h"
+#include "dds.h"
+
+#define TABLE_BITS  10
+#define TABLE_SIZE  (1U << TABLE_BITS)
+#define FS_HZ       1000000U
+
+static uint16_t ramp_table[TABLE_SIZE];
+
+static void fill_ramp_table(void)
+{
+    for (uint32_t i = 0; i < TABLE_SIZE; i++)
+        ramp_table[i] = (uint16_t)i;
+}
+
+/**
+ * Test: 1 kHz at 1 MS/s -> tuning word = 2^32 / 1000
+ */
+int test_tuning_word_1khz(void)
+{
+    uint32_t tw = DDS_TuningWord_mHz(FS_HZ, 1000U * 1000U);
+
+    TEST_ASSERT_EQUAL(4294967UL, tw, "Tuning word for 1 kHz");
+    return 1;
+}
+
+/**
+ * Test: sub-Hz steps produce distinct tuning words
+ */
+int test_sub_hz_resolution(void)
+{
+    uint32_t a = DDS_TuningWord_mHz(FS_HZ, 1000000U);
+    uint32_t b = DDS_TuningWord_mHz(FS_HZ, 1000001U);   /* +1 mHz */
+
+    TEST_ASSERT(b > a, "1 mHz step must change the tuning word");
+    return 1;
+}
+
+/**
+ * Test: frequency round trip stays within one tuning-word LSB
+ */
+int test_frequency_round_trip(void)
+{
+    static const uint32_t freqs[] = { 1, 500, 1000000, 7812500, 123456789, 499999000 };
+    DDS_t dds;
+
+    fill_ramp_table();
+    DDS_Init(&dds, ramp_table, TABLE_BITS, FS_HZ);
+
+    for (unsigned i = 0; i < sizeof(freqs) / sizeof(freqs[0]); i++) {
+        DDS_SetFrequency_mHz(&dds, freqs[i]);
+        TEST_ASSERT_NEAR(freqs[i], DDS_GetFrequency_mHz(&dds), 1, "Round trip frequency");
+    }
+    return 1;
+}
+
+/**
+ * Test: requests at or above Nyquist clamp to f_s / 2
+ */
+int test_nyquist_clamp(void)
+{
+    TEST_ASSERT_EQUAL(0x80000000UL, DDS_TuningWord_mHz(FS_HZ, 500000000U), "Nyquist clamps");
+    TEST_ASSERT_EQUAL(0x80000000UL, DDS_TuningWord_mHz(FS_HZ, 0xFFFFFFFFU), "Above Nyquist clamps");
+    return 1;
+}
+
+/**
+ * Test: output index equals the top table_bits of the phase
+ */
+int test_fill_matches_reference(void)
+{
+    uint16_t out[1000];
+    DDS_t dds;
+
+    fill_ramp_table();
+    DDS_Init(&dds, ramp_table, TABLE_BITS, FS_HZ);
+    DDS_SetFrequency_mHz(&dds, 7812500U);
+
+    DDS_Fill(&dds, out, 1000);
+
+    uint32_t phase = 0;
+    for (int i = 0; i < 1000; i++) {
+        TEST_ASSERT_EQUAL(phase >> (32 - TABLE_BITS), out[i], "Sample index");
+        phase += dds.tuning_word;
+    }
+    TEST_ASSERT_EQUAL(phase, dds.phase, "Phase carried to next block");
+    return 1;
+}
+
+/**
+ * Test: splitting into odd-sized blocks gives the same stream
+ */
+int test_fill_block_continuity(void)
+{
+    uint16_t whole[999];
+    uint16_t parts[999];
+    DDS_t a, b;
+
+    fill_ramp_table();
+    DDS_Init(&a, ramp_table, TABLE_BITS, FS_HZ);
+    DDS_Init(&b, ramp_table, TABLE_BITS, FS_HZ);
+    DDS_SetFrequency_mHz(&a, 3333333U);
+    DDS_SetFrequency_mHz(&b, 3333333U);
+
+    DDS_Fill(&a, whole, 999);
+    DDS_Fill(&b, parts, 1);
+    DDS_Fill(&b, parts + 1, 7);
+    DDS_Fill(&b, parts + 8, 991);
+
+    for (int i = 0; i < 999; i++)
+        TEST_ASSERT_EQUAL(whole[i], parts[i], "Block split must not change output");
+    return 1;
+}
+
+/**
+ * Test: zero frequency holds the current sample
+ */
+int test_zero_frequency_is_dc(void)
+{
+    uint16_t out[64];
+    DDS_t dds;
+
+    fill_ramp_table();
+    DDS_Init(&dds, ramp_table, TABLE_BITS, FS_HZ);
+    dds.phase = 0x40000000U;
+    DDS_SetFrequency_mHz(&dds, 0);
+    DDS_Fill(&dds, out, 64);
+
+    for (int i = 0; i < 64; i++)
+        TEST_ASSERT_EQUAL(TABLE_SIZE / 4, out[i], "DC at quarter phase");
+    return 1;
+}
+
+/**
+ * Test: gain pass over a normalized table matches a pre-scaled table within 1 LSB
+ */
+int test_fill_scaled_matches_scaled_table(void)
+{
+    static int16_t q15[TABLE_SIZE];
+    static uint16_t norm[TABLE_SIZE];
+    static uint16_t scaled[TABLE_SIZE];
+    uint16_t ref[777], out[777];
+
+    /* Full-scale Q15 ramp -32767..32767, offset binary for the gain pass */
+    for (uint32_t i = 0; i < TABLE_SIZE; i++) {
+        q15[i] = (int16_t)((int32_t)(i * 65534U / (TABLE_SIZE - 1U)) - 32767);
+        norm[i] = (uint16_t)(32768 + q15[i]);
+    }
+
+    for (uint32_t max_dac = 0; max_dac <= 4095U; max_dac += 15U) {
+        DDS_t a, b;
+
+        /* Reference: the table scaled up front, as Generete_SineTable did */
+        for (uint32_t i = 0; i < TABLE_SIZE; i++)
+            scaled[i] = (uint16_t)(((uint32_t)(32768 + q15[i]) * max_dac + 32768U) >> 16);
+
+        DDS_Init(&a, scaled, TABLE_BITS, FS_HZ);
+        DDS_Init(&b, norm, TABLE_BITS, FS_HZ);
+        DDS_SetFrequency_mHz(&a, 1234567U);
+        DDS_SetFrequency_mHz(&b, 1234567U);
+        DDS_Fill(&a, ref, 777);
+        DDS_FillScaled(&b, 0, (uint16_t)max_dac, out, 777);
+
+        for (int i = 0; i < 777; i++)
+            TEST_ASSERT_NEAR(ref[i], out[i], 1, "Gain pass within 1 LSB");
+        TEST_ASSERT_EQUAL(a.phase, b.phase, "Same phase advance");
+    }
+    return 1;
+}
+
+/**
+ * Test: offset shifts the swing, extremes land on low and high
+ */
+int test_fill_scaled_offset(void)
+{
+    static uint16_t norm[TABLE_SIZE];
+    uint16_t out[TABLE_SIZE];
+    DDS_t dds;
+
+    for (uint32_t i = 0; i < TABLE_SIZE; i++)
+        norm[i] = (uint16_t)(i * 65535U / (TABLE_SIZE - 1U));
+
+    DDS_Init(&dds, norm, TABLE_BITS, FS_HZ);
+    dds.tuning_word = 1U << (32 - TABLE_BITS);      /* one entry per sample */
+    DDS_FillScaled(&dds, 1000, 3000, out, TABLE_SIZE);
+
+    TEST_ASSERT_EQUAL(1000, out[0], "Bottom at low");
+    TEST_ASSERT_EQUAL(3000, out[TABLE_SIZE - 1], "Top at high");
+    for (uint32_t i = 1; i < TABLE_SIZE; i++)
+        TEST_ASSERT(out[i] >= out[i - 1], "Monotonic");
+    return 1;
+}
+
+/**
+ * Test: packed gain pass is bit-exact with the scalar reference
+ */
+int test_fill_scaled_packed_bit_exact(void)
+{
+    static const uint16_t lows[]  = { 0, 0, 0, 1000, 2048, 0, 100, 40000 };
+    static const uint16_t highs[] = { 0, 1, 4095, 3000, 2048, 0x7FFF, 0x807F, 65535 };
+    static uint16_t norm[TABLE_SIZE];
+    static uint16_t cal[4096];
+    uint16_t ref[1001], out[1002];
+
+    for (uint32_t i = 0; i < TABLE_SIZE; i++)
+        norm[i] = (uint16_t)(i * 64109U + 12345U);      /* every bit pattern mix */
+    for (uint32_t i = 0; i < 4096U; i++)
+        cal[i] = (uint16_t)(4095U - i);
+
+    for (unsigned k = 0; k < sizeof(lows) / sizeof(lows[0]); k++) {
+        for (uint32_t use_cal = 0; use_cal < 2U; use_cal++) {
+            DDS_t a, b;
+
+            /* cal only indexes DAC codes, so only in-range swings use it */
+            if (use_cal && (lows[k] > 4095U || highs[k] > 4095U))
+                continue;
+
+            DDS_Init(&a, norm, TABLE_BITS, FS_HZ);
+            DDS_Init(&b, norm, TABLE_BITS, FS_HZ);
+            a.cal = b.cal = use_cal ? cal : NULL;
+            DDS_SetFrequency_mHz(&a, 3333333U);
+            DDS_SetFrequency_mHz(&b, 3333333U);
+
+            /* Odd count into an odd address: the pair store is unaligned */
+            DDS_FillScaled_Ref(&a, lows[k], highs[k], ref, 1001);
+            DDS_FillScaled(&b, lows[k], highs[k], out + 1, 1001);
+
+            for (int i = 0; i < 1001; i++)
+                TEST_ASSERT_EQUAL(ref[i], out[i + 1], "Packed matches reference");
+            TEST_ASSERT_EQUAL(a.phase, b.phase, "Same phase advance");
+        }
+    }
+    return 1;
+}
+
+int main(void)
+{
+    printf("========================================\n");
+    printf("DDS Core Unit Tests\n");
+    printf("========================================\n\n");
+
+    RUN_TEST(test_tuning_word_1khz);
+    RUN_TEST(test_sub_hz_resolution);
+    RUN_TEST(test_frequency_round_trip);
+    RUN_TEST(test_nyquist_clamp);
+    RUN_TEST(test_fill_matches_reference);
+    RUN_TEST(test_fill_block_continuity);
+    RUN_TEST(test_zero_frequency_is_dc);
+    RUN_TEST(test_fill_scaled_matches_scaled_table);
+    RUN_TEST(test_fill_scaled_offset);
+    RUN_TEST(test_fill_scaled_packed_bit_exact);
+
+    TEST_SUMMARY();
+    return (tests_passed == tests_run) ? 0 : 1;
+}
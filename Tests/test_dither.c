@@ -0,0 +1,182 @@
+/**
+ * @file test_dither.c
+ * @brief Unit tests for the TPDF dither / noise-shaping output stage
+ *
+ * Build (host):
+ *   gcc -O2 -I../STM32CubeIDE/Signal_gen test_dither.c ../STM32CubeIDE/Signal_gen/dither.c \
+ *       ../STM32CubeIDE/Signal_gen/dds.c -lm -o test_dither
+ */
+
+#include <stdint.h>
+#include <math.h>
+#include "test_common.h"
+#include "dither.h"
+
+#define FS          1000000U
+#define BITS        12U
+#define N           16384U
+#define PI          3.14159265358979323846
+#define BAND_HZ     16000U
+
+static uint16_t table[1U << BITS];
+static uint16_t out[N];
+static double err[N];
+
+static void build_table(void)
+{
+    for (uint32_t i = 0; i < (1U << BITS); i++)
+        table[i] = (uint16_t)lround(32767.5 + 32767.5 * sin(2.0 * PI * i / (1U << BITS)));
+}
+
+/* Exact level the kernels aim at for sample i, in codes */
+static double wanted(uint32_t phase, uint16_t low, uint16_t high)
+{
+    return low + table[phase >> (32U - BITS)] * (double)(high - low) / 65536.0;
+}
+
+/* Error power below BAND_HZ (DFT of the error, bins 1 .. band), dB */
+static double inband_db(void)
+{
+    const uint32_t kmax = (uint32_t)((uint64_t)BAND_HZ * N / FS);
+    double p = 0.0;
+
+    for (uint32_t k = 1; k <= kmax; k++) {
+        double re = 0.0, im = 0.0;
+        for (uint32_t i = 0; i < N; i++) {
+            re += err[i] * cos(2.0 * PI * k * i / N);
+            im -= err[i] * sin(2.0 * PI * k * i / N);
+        }
+        p += re * re + im * im;
+    }
+    return 10.0 * log10(p / ((double)N * N) + 1e-30);
+}
+
+/* Render N samples of a small sine (3 codes peak-peak) and keep the error */
+static double run(DitherMode_t mode)
+{
+    Dither_t d;
+    DDS_t dds;
+    const uint16_t low = 2000, high = 2003;
+
+    DDS_Init(&dds, table, BITS, FS);
+    DDS_SetFrequency_mHz(&dds, 1953125U);      /* 32 periods in N samples */
+    Dither_Init(&d, 12345U);
+    Dither_SetMode(&d, mode);
+
+    for (uint32_t i = 0; i < N; i += 512U) {
+        uint32_t phase = dds.phase;
+
+        Dither_FillScaled(&d, &dds, low, high, &out[i], 512U);
+        for (uint32_t j = 0; j < 512U; j++) {
+            err[i + j] = out[i + j] - wanted(phase, low, high);
+            phase += dds.tuning_word;
+        }
+    }
+    return inband_db();
+}
+
+/**
+ * Test: off is bit-exact DDS_FillScaled
+ */
+int test_off_is_plain(void)
+{
+    static uint16_t ref[1000];
+    Dither_t d;
+    DDS_t a, b;
+
+    build_table();
+    DDS_Init(&a, table, BITS, FS);
+    DDS_SetFrequency_mHz(&a, 12345678U);
+    b = a;
+    Dither_Init(&d, 1);
+    Dither_FillScaled(&d, &a, 100, 4000, out, 1000);
+    DDS_FillScaled(&b, 100, 4000, ref, 1000);
+    for (uint32_t i = 0; i < 1000U; i++)
+        TEST_ASSERT_EQUAL(ref[i], out[i], "Plain sample");
+    TEST_ASSERT_EQUAL(b.phase, a.phase, "Phase advance");
+    return 1;
+}
+
+/**
+ * Test: a half-code DC level averages out correctly; shaping widens the spread
+ */
+int test_dc_mean(void)
+{
+    static const DitherMode_t modes[] = { DITHER_TPDF, DITHER_SHAPED };
+    static const int32_t spread[] = { 2, 5 };      /* TPDF +-1 LSB; NTF gain up to 4 */
+    uint16_t flat[16];
+    Dither_t d;
+    DDS_t dds;
+
+    for (uint32_t i = 0; i < 16U; i++)
+        flat[i] = 0x8000;           /* 100 + 0.5 * 1 = 100.5 codes */
+
+    for (unsigned m = 0; m < 2U; m++) {
+        double sum = 0.0;
+
+        DDS_Init(&dds, flat, 4, FS);
+        Dither_Init(&d, 777U);
+        Dither_SetMode(&d, modes[m]);
+        for (uint32_t i = 0; i < N; i += 512U)
+            Dither_FillScaled(&d, &dds, 100, 101, &out[i], 512U);
+        for (uint32_t i = 0; i < N; i++) {
+            TEST_ASSERT(out[i] >= 101 - spread[m] && out[i] <= 100 + spread[m], "Dither range");
+            sum += out[i];
+        }
+        TEST_ASSERT_NEAR(100500, (int32_t)lround(sum / N * 1000.0), 20, "Mean level");
+    }
+    return 1;
+}
+
+/**
+ * Test: shaping moves the error out of the audio band
+ */
+int test_shaping_lowers_inband_noise(void)
+{
+    double plain, tpdf, shaped;
+
+    build_table();
+    plain = run(DITHER_OFF);
+    tpdf = run(DITHER_TPDF);
+    shaped = run(DITHER_SHAPED);
+    printf("    in-band error: plain %.1f dB, TPDF %.1f dB, shaped %.1f dB\n", plain, tpdf, shaped);
+
+    TEST_ASSERT(shaped < plain - 20.0, "Shaped well below rounding");
+    TEST_ASSERT(shaped < tpdf - 20.0, "Shaped well below flat dither");
+    return 1;
+}
+
+/**
+ * Test: rails clamp and the feedback does not wind up
+ */
+int test_rails(void)
+{
+    Dither_t d;
+    DDS_t dds;
+
+    build_table();
+    DDS_Init(&dds, table, BITS, FS);
+    DDS_SetFrequency_mHz(&dds, 1000000U);
+    Dither_Init(&d, 99U);
+    Dither_SetMode(&d, DITHER_SHAPED);
+    Dither_FillScaled(&d, &dds, 0, 4095, out, N);
+    for (uint32_t i = 0; i < N; i++)
+        TEST_ASSERT(out[i] <= 4095, "Inside 12 bits");
+    TEST_ASSERT(d.e1 <= 512 && d.e1 >= -512, "Error bounded");
+    return 1;
+}
+
+int main(void)
+{
+    printf("========================================\n");
+    printf("Dither / Noise Shaping Unit Tests\n");
+    printf("========================================\n\n");
+
+    RUN_TEST(test_off_is_plain);
+    RUN_TEST(test_dc_mean);
+    RUN_TEST(test_shaping_lowers_inband_noise);
+    RUN_TEST(test_rails);
+
+    TEST_SUMMARY();
+    return (tests_passed == tests_run) ? 0 : 1;
+}
@@ -0,0 +1,173 @@
+/**
+ * @file test_dsp_kernels.c
+ * @brief Bit-exact tests of the packed DSP kernels against the scalar reference
+ *
+ * On the host the packed kernels run on the plain-C instruction models,
+ * so these cover the lane packing, rounding and saturation logic.
+ *
+ * Build (host):
+ *   gcc -O2 -I../STM32CubeIDE/Signal_gen test_dsp_kernels.c \
+ *       ../STM32CubeIDE/Signal_gen/dsp_kernels.c -o test_dsp_kernels
+ */
+
+#include <stdint.h>
+#include "test_common.h"
+#include "dsp_kernels.h"
+
+#define N   1001U                   /* odd: paired kernels finish on a scalar step */
+
+static int16_t in_a[N], in_b[N];
+static int16_t out_s[N], ref_s[N];
+static uint16_t out_u[N], ref_u[N];
+static uint32_t rng = 0x12345678U;
+
+static uint32_t next_rand(void)
+{
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng;
+}
+
+/* Random samples with the extremes forced in */
+static void fill_inputs(void)
+{
+    for (uint32_t i = 0; i < N; i++) {
+        in_a[i] = (int16_t)next_rand();
+        in_b[i] = (int16_t)next_rand();
+    }
+    in_a[0] = -32768; in_a[1] = 32767; in_a[2] = 0; in_a[3] = -1;
+    in_b[0] = 32767;  in_b[1] = -32768; in_b[2] = -1; in_b[3] = 0;
+}
+
+/**
+ * Test: gain/offset matches the reference for gains and offsets across range
+ */
+int test_gain_offset_bit_exact(void)
+{
+    static const int16_t gains[] = { 32767, -32767, 16384, 1, 0, -12345, 4096 };
+    static const int16_t offsets[] = { 0, 2048, 4095, -100, 32767, -32768 };
+
+    fill_inputs();
+    for (unsigned g = 0; g < sizeof(gains) / sizeof(gains[0]); g++) {
+        for (unsigned o = 0; o < sizeof(offsets) / sizeof(offsets[0]); o++) {
+            Dsp_GainOffset(in_a, gains[g], offsets[o], out_u, N);
+            Dsp_GainOffset_Ref(in_a, gains[g], offsets[o], ref_u, N);
+            for (uint32_t i = 0; i < N; i++)
+                TEST_ASSERT_EQUAL(ref_u[i], out_u[i], "Gain/offset sample");
+        }
+    }
+    return 1;
+}
+
+/**
+ * Test: gain/offset lands in 12 bits and scales as expected
+ */
+int test_gain_offset_levels(void)
+{
+    int16_t x[4] = { 32767, -32767, 0, 16384 };
+    uint16_t y[4];
+
+    /* Q15 full scale -> +-2047 codes around mid-scale */
+    Dsp_GainOffset(x, 2047, 2048, y, 4);
+    TEST_ASSERT_EQUAL(4095, y[0], "Peak");
+    TEST_ASSERT_EQUAL(1, y[1], "Trough");
+    TEST_ASSERT_EQUAL(2048, y[2], "Mid-scale");
+    TEST_ASSERT_EQUAL(2048 + 1024, y[3], "Half amplitude");
+    return 1;
+}
+
+/**
+ * Test: 12-bit saturation clamps both lanes
+ */
+int test_saturate12(void)
+{
+    fill_inputs();
+    Dsp_Saturate12(in_a, out_u, N);
+    Dsp_Saturate12_Ref(in_a, ref_u, N);
+    for (uint32_t i = 0; i < N; i++) {
+        TEST_ASSERT_EQUAL(ref_u[i], out_u[i], "Saturated sample");
+        TEST_ASSERT(out_u[i] <= 4095, "Inside 12 bits");
+    }
+    TEST_ASSERT_EQUAL(0, out_u[0], "Negative clamps to 0");
+    TEST_ASSERT_EQUAL(4095, out_u[1], "Positive clamps to 4095");
+    return 1;
+}
+
+/**
+ * Test: interpolated lookup matches the reference, including the wrap
+ */
+int test_interp_bit_exact(void)
+{
+    static const uint32_t steps[] = { 0x00012345U, 0x01000000U, 0x0ABCDEF1U, 0x7FFFFFFFU, 0xFFFFFFFFU };
+    uint32_t pa, pb;
+
+    fill_inputs();
+    for (unsigned s = 0; s < sizeof(steps) / sizeof(steps[0]); s++) {
+        pa = pb = 0xF0000000U;
+        Dsp_InterpFill(in_b, 8, &pa, steps[s], out_s, N);
+        Dsp_InterpFill_Ref(in_b, 8, &pb, steps[s], ref_s, N);
+        for (uint32_t i = 0; i < N; i++)
+            TEST_ASSERT_EQUAL(ref_s[i], out_s[i], "Interpolated sample");
+        TEST_ASSERT_EQUAL(pb, pa, "Phase advance");
+    }
+    return 1;
+}
+
+/**
+ * Test: halfway between two entries is their rounded mean
+ */
+int test_interp_midpoint(void)
+{
+    static const int16_t table[4] = { 0, 1000, -1000, 32767 };
+    uint32_t phase = 0x20000000U;       /* entry 0 + 1/2 */
+    int16_t y[4];
+
+    Dsp_InterpFill(table, 2, &phase, 0x40000000U, y, 4);
+    TEST_ASSERT_EQUAL(500, y[0], "0 .. 1000");
+    TEST_ASSERT_EQUAL(0, y[1], "1000 .. -1000");
+    TEST_ASSERT_EQUAL(15884, y[2], "-1000 .. 32767");
+    TEST_ASSERT_EQUAL(16384, y[3], "Wraps to entry 0");
+    return 1;
+}
+
+/**
+ * Test: two-source mix matches the reference, saturating at the rails
+ */
+int test_mix2_bit_exact(void)
+{
+    static const int16_t gains[][2] = {
+        { 16384, 16384 }, { 32767, 32767 }, { -32767, 32767 }, { 0, 32767 }, { 12345, -23456 }
+    };
+
+    fill_inputs();
+    for (unsigned g = 0; g < sizeof(gains) / sizeof(gains[0]); g++) {
+        Dsp_Mix2(in_a, gains[g][0], in_b, gains[g][1], out_s, N);
+        Dsp_Mix2_Ref(in_a, gains[g][0], in_b, gains[g][1], ref_s, N);
+        for (uint32_t i = 0; i < N; i++)
+            TEST_ASSERT_EQUAL(ref_s[i], out_s[i], "Mixed sample");
+    }
+
+    /* Full gain on both: 32767 + 32767 saturates */
+    in_a[0] = 32767; in_b[0] = 32767;
+    Dsp_Mix2(in_a, 32767, in_b, 32767, out_s, 2);
+    TEST_ASSERT_EQUAL(32767, out_s[0], "Saturates high");
+    return 1;
+}
+
+int main(void)
+{
+    printf("========================================\n");
+    printf("DSP Kernel Unit Tests\n");
+    printf("========================================\n\n");
+
+    RUN_TEST(test_gain_offset_bit_exact);
+    RUN_TEST(test_gain_offset_levels);
+    RUN_TEST(test_saturate12);
+    RUN_TEST(test_interp_bit_exact);
+    RUN_TEST(test_interp_midpoint);
+    RUN_TEST(test_mix2_bit_exact);
+
+    TEST_SUMMARY();
+    return (tests_passed == tests_run) ? 0 : 1;
+}
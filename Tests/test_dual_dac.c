@@ -0,0 +1,127 @@
+/**
+ * @file test_dual_dac.c
+ * @brief Unit tests for dual-channel (DHR12RD) rendering
+ *
+ * Build (host):
+ *   gcc -O2 -I../STM32CubeIDE/Signal_gen test_dual_dac.c ../STM32CubeIDE/Signal_gen/dual_dac.c \
+ *       ../STM32CubeIDE/Signal_gen/waveform.c ../STM32CubeIDE/Signal_gen/blep.c \
+ *       ../STM32CubeIDE/Signal_gen/dds.c -o test_dual_dac
+ */
+
+#include <stdint.h>
+#include "test_common.h"
+#include "dual_dac.h"
+
+#define N       1024U           /* samples per period in these tests */
+#define FS_HZ   1000000U
+
+static uint32_t frames[2 * N];
+static uint16_t single[2 * N];
+static uint16_t dummy_table[4];
+
+static const WaveParams_t ramp = { WAVEFORM_RAMP_UP, 0, 0, 4095, 0 };
+
+static void setup(DDS_t *dds)
+{
+    DDS_Init(dds, dummy_table, 2, FS_HZ);
+    dds->tuning_word = 0xFFFFFFFFU / N + 1U;    /* exactly N samples per period */
+}
+
+static uint16_t ch1(uint32_t w) { return (uint16_t)(w & 0x0FFFU); }
+static uint16_t ch2(uint32_t w) { return (uint16_t)((w >> 16) & 0x0FFFU); }
+
+/**
+ * Test: channel 1 in bits 11:0, channel 2 in bits 27:16
+ */
+int test_pack_layout(void)
+{
+    TEST_ASSERT_EQUAL(0x0FFF0123UL, DualDac_Pack(0x123, 0xFFF), "DHR12RD layout");
+    TEST_ASSERT_EQUAL(0x00010000UL, DualDac_Pack(0, 1), "Channel 2 LSB at bit 16");
+    return 1;
+}
+
+/**
+ * Test: degrees map onto the 32-bit phase circle
+ */
+int test_phase_from_degrees(void)
+{
+    TEST_ASSERT_EQUAL(0, DualDac_PhaseFromDegrees(0), "0 deg");
+    TEST_ASSERT_EQUAL(DUAL_DAC_PHASE_90, DualDac_PhaseFromDegrees(90), "90 deg");
+    TEST_ASSERT_EQUAL(0x80000000UL, DualDac_PhaseFromDegrees(180), "180 deg");
+    TEST_ASSERT_EQUAL(0, DualDac_PhaseFromDegrees(360), "360 deg wraps");
+    return 1;
+}
+
+/**
+ * Test: channel 1 equals the single-channel render, channel 2 leads by the offset
+ */
+int test_quadrature(void)
+{
+    DDS_t a, b;
+
+    setup(&a);
+    setup(&b);
+    DualDac_Fill(&a, &ramp, DUAL_DAC_PHASE_90, 1, frames, N);
+    Waveform_Fill(&b, &ramp, single, 2 * N);
+
+    for (uint32_t i = 0; i < N; i++) {
+        TEST_ASSERT_EQUAL(single[i], ch1(frames[i]), "Channel 1 unchanged");
+        TEST_ASSERT_EQUAL(single[i + N / 4], ch2(frames[i]), "Channel 2 a quarter period ahead");
+    }
+    TEST_ASSERT_EQUAL(b.phase, a.phase, "Only channel 1 advances the DDS");
+    return 1;
+}
+
+/**
+ * Test: multiplier locks channel 2 to a harmonic of channel 1
+ */
+int test_multiplier(void)
+{
+    DDS_t a, b;
+
+    setup(&a);
+    setup(&b);
+    DualDac_Fill(&a, &ramp, 0, 3, frames, N);
+    b.tuning_word *= 3U;
+    Waveform_Fill(&b, &ramp, single, N);
+
+    for (uint32_t i = 0; i < N; i++)
+        TEST_ASSERT_EQUAL(single[i], ch2(frames[i]), "Channel 2 at 3x");
+    return 1;
+}
+
+/**
+ * Test: splitting the render into odd-sized blocks keeps both channels in step
+ */
+int test_block_continuity(void)
+{
+    static uint32_t whole[N];
+    DDS_t a, b;
+
+    setup(&a);
+    setup(&b);
+    a.tuning_word = b.tuning_word = 0x0A3D70A4U;
+    DualDac_Fill(&a, &ramp, DUAL_DAC_PHASE_90, 2, whole, N);
+    DualDac_Fill(&b, &ramp, DUAL_DAC_PHASE_90, 2, frames, 333);
+    DualDac_Fill(&b, &ramp, DUAL_DAC_PHASE_90, 2, frames + 333, N - 333);
+
+    for (uint32_t i = 0; i < N; i++)
+        TEST_ASSERT_EQUAL(whole[i], frames[i], "Split block equals whole block");
+    return 1;
+}
+
+int main(void)
+{
+    printf("========================================\n");
+    printf("Dual-Channel DAC Unit Tests\n");
+    printf("========================================\n\n");
+
+    RUN_TEST(test_pack_layout);
+    RUN_TEST(test_phase_from_degrees);
+    RUN_TEST(test_quadrature);
+    RUN_TEST(test_multiplier);
+    RUN_TEST(test_block_continuity);
+
+    TEST_SUMMARY();
+    return (tests_passed == tests_run) ? 0 : 1;
+}
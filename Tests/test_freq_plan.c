@@ -0,0 +1,157 @@
+/**
+ * @file test_freq_plan.c
+ * @brief Unit tests for the exact-period frequency planner
+ *
+ * Build (host):
+ *   gcc -O2 -I../STM32CubeIDE/Signal_gen test_freq_plan.c \
+ *       ../STM32CubeIDE/Signal_gen/freq_plan.c -o test_freq_plan
+ */
+
+#include <stdint.h>
+#include "test_common.h"
+#include "freq_plan.h"
+
+#define TIM_CLK_HZ  108000000U
+
+static const FreqPlanLimits_t lim = { TIM_CLK_HZ, 108U, 16U, 2048U, 10U };
+
+/* Plan fits the hardware: 16-bit timer fields, DAC rate, RAM budget */
+static int plan_legal(const FreqPlan_t *p)
+{
+    uint64_t d = (uint64_t)(p->psc + 1U) * (p->arr + 1U);
+
+    return p->psc <= 0xFFFFU && p->arr <= 0xFFFFU
+        && d >= lim.min_divider
+        && p->n >= lim.n_min && p->n <= lim.n_max
+        && d * p->n == p->k;
+}
+
+/* |f_plan / f_target - 1| in parts per billion */
+static uint64_t error_ppb(const FreqPlan_t *p, uint32_t freq_mhz)
+{
+    uint64_t ideal = (uint64_t)freq_mhz * p->k;
+    uint64_t clk = (uint64_t)TIM_CLK_HZ * 1000U;
+    uint64_t diff = (clk > ideal) ? clk - ideal : ideal - clk;
+
+    return diff * 1000000000U / ideal;
+}
+
+/**
+ * Test: 1 kHz divides the clock, so the plan is exact with the longest table
+ */
+int test_exact_target(void)
+{
+    FreqPlan_t p;
+
+    TEST_ASSERT(FreqPlan_Search(&lim, 1000000U, &p), "1 kHz has a plan");
+    TEST_ASSERT(plan_legal(&p), "Plan is legal");
+    TEST_ASSERT_EQUAL(108000, p.k, "K = clock / f");
+    TEST_ASSERT_EQUAL(1000, p.n, "Longest table at the DAC rate limit");
+    TEST_ASSERT_EQUAL(0, p.psc, "No prescaler");
+    TEST_ASSERT_EQUAL(107, p.arr, "1 MS/s update");
+    TEST_ASSERT_EQUAL(1000000, FreqPlan_Frequency_mHz(&lim, &p), "Frequency exact");
+    TEST_ASSERT_EQUAL(1000000, FreqPlan_SampleRate_Hz(&lim, &p), "Sample rate");
+    return 1;
+}
+
+/**
+ * Test: every plan over the slider range is legal and within tolerance
+ */
+int test_slider_range(void)
+{
+    uint32_t hits = 0;
+
+    for (uint32_t f = 100U; f <= 10000U; f += 100U) {
+        FreqPlan_t p;
+
+        if (!FreqPlan_Search(&lim, f * 1000U, &p))
+            continue;
+        hits++;
+        TEST_ASSERT(plan_legal(&p), "Plan is legal");
+        TEST_ASSERT(error_ppb(&p, f * 1000U) <= 10000U, "Error within 10 ppm");
+        TEST_ASSERT(FreqPlan_SampleRate_Hz(&lim, &p) <= 1000000U, "Rate within DAC limit");
+    }
+    /* Divisors of 1.08 MHz at least: 100, 200, 250, 300, ... Hz */
+    TEST_ASSERT(hits >= 30U, "Most slider steps have an exact plan");
+    return 1;
+}
+
+/**
+ * Test: low frequencies need a prescaler split
+ */
+int test_prescaler_split(void)
+{
+    FreqPlan_t p;
+
+    TEST_ASSERT(FreqPlan_Search(&lim, 100U, &p), "0.1 Hz has a plan");
+    TEST_ASSERT(plan_legal(&p), "Plan is legal");
+    TEST_ASSERT(p.psc > 0U, "Prescaler used");
+    TEST_ASSERT_EQUAL(1080000000UL, p.k, "0.1 Hz exact");
+    return 1;
+}
+
+/**
+ * Test: an off-grid target moves K to the nearest factorable value
+ */
+int test_nearest_fallback(void)
+{
+    FreqPlan_t p;
+    const uint32_t target = 12345678U;      /* 12345.678 Hz, K = 8748.0007 */
+
+    TEST_ASSERT(FreqPlan_Search(&lim, target, &p), "Off-grid target has a plan");
+    TEST_ASSERT(plan_legal(&p), "Plan is legal");
+    TEST_ASSERT_EQUAL(8748, p.k, "Nearest K");
+    TEST_ASSERT(error_ppb(&p, target) <= 10000U, "Error within 10 ppm");
+    return 1;
+}
+
+/**
+ * Test: no plan when the K grid is coarser than the tolerance
+ */
+int test_rejects_out_of_tolerance(void)
+{
+    FreqPlan_t p;
+
+    /* 333.333 kHz: K = 324.0003, only N = 3 fits the DAC rate */
+    TEST_ASSERT(!FreqPlan_Search(&lim, 333333333U, &p), "Table too short");
+    /* 77.777 kHz: K = 1388.585, nearest K is 300 ppm away */
+    TEST_ASSERT(!FreqPlan_Search(&lim, 77777000U, &p), "K grid too coarse");
+    TEST_ASSERT(!FreqPlan_Search(&lim, 0U, &p), "Zero frequency");
+    return 1;
+}
+
+/**
+ * Test: the period copy wraps and carries its index across blocks
+ */
+int test_fill_period(void)
+{
+    uint16_t table[37], out[100];
+    uint32_t index = 0;
+
+    for (uint32_t i = 0; i < 37U; i++)
+        table[i] = (uint16_t)(i * 100U);
+
+    FreqPlan_FillPeriod(table, 37U, &index, out, 33U);
+    FreqPlan_FillPeriod(table, 37U, &index, out + 33, 67U);
+    for (uint32_t i = 0; i < 100U; i++)
+        TEST_ASSERT_EQUAL(table[i % 37U], out[i], "Cyclic copy");
+    TEST_ASSERT_EQUAL(100 % 37, index, "Index carried");
+    return 1;
+}
+
+int main(void)
+{
+    printf("========================================\n");
+    printf("Frequency Planner Unit Tests\n");
+    printf("========================================\n\n");
+
+    RUN_TEST(test_exact_target);
+    RUN_TEST(test_slider_range);
+    RUN_TEST(test_prescaler_split);
+    RUN_TEST(test_nearest_fallback);
+    RUN_TEST(test_rejects_out_of_tolerance);
+    RUN_TEST(test_fill_period);
+
+    TEST_SUMMARY();
+    return (tests_passed == tests_run) ? 0 : 1;
+}
@@ -0,0 +1,157 @@
+/**
+ * @file test_harmonics.c
+ * @brief Unit tests for the additive (harmonic) table builder
+ *
+ * Build (host):
+ *   gcc -O2 -I../STM32CubeIDE/Signal_gen test_harmonics.c ../STM32CubeIDE/Signal_gen/harmonics.c \
+ *       ../STM32CubeIDE/Signal_gen/dsp_kernels.c ../STM32CubeIDE/Signal_gen/sine_q15.c -lm -o test_harmonics
+ */
+
+#include <stdint.h>
+#include <math.h>
+#include "test_common.h"
+#include "harmonics.h"
+#include "sine_q15.h"
+
+#define BITS    10U
+#define N       (1U << BITS)
+#define PI      3.14159265358979323846
+
+static int16_t sine[N];
+static int16_t out[N];
+static int32_t work[N];
+static double ref[N];
+
+static uint32_t phase_deg(double deg)
+{
+    return (uint32_t)(int64_t)llround(deg / 360.0 * 4294967296.0);
+}
+
+/* Double-precision sum, normalized the same way (peak -> 32767) */
+static void reference(const Harmonics_t *h)
+{
+    double peak = 0.0;
+
+    for (uint32_t i = 0; i < N; i++) {
+        double v = 0.0;
+        for (uint32_t k = 1; k <= h->count; k++)
+            v += h->amp_q15[k - 1] * sin(2.0 * PI * (k * (double)i / N + h->phase[k - 1] / 4294967296.0));
+        ref[i] = v;
+        if (fabs(v) > peak) peak = fabs(v);
+    }
+    for (uint32_t i = 0; i < N; i++)
+        ref[i] = ref[i] * 32767.0 / peak;
+}
+
+/**
+ * Test: fundamental alone reproduces the sine table
+ */
+int test_fundamental_is_sine(void)
+{
+    Harmonics_t h;
+
+    SineQ15_BuildPeriod(sine, BITS);
+    Harmonics_Clear(&h);
+    Harmonics_Set(&h, 1, 32767, 0);
+
+    TEST_ASSERT(Harmonics_Build(&h, sine, BITS, work, out, BITS) > 0, "Not silent");
+    for (uint32_t i = 0; i < N; i++)
+        TEST_ASSERT_NEAR(sine[i], out[i], 1, "Sine sample");
+    return 1;
+}
+
+/**
+ * Test: a distorted mix matches the double-precision sum within 3 LSB (Q15)
+ */
+int test_matches_reference(void)
+{
+    Harmonics_t h;
+
+    SineQ15_BuildPeriod(sine, BITS);
+    Harmonics_Clear(&h);
+    Harmonics_Set(&h, 1, 32767, 0);
+    Harmonics_Set(&h, 2, 3277, phase_deg(90.0));     /* -20 dB 2nd, 90 deg */
+    Harmonics_Set(&h, 3, -1638, phase_deg(33.75));   /* -26 dB 3rd, inverted */
+    Harmonics_Set(&h, 7, 328, phase_deg(180.0));
+    Harmonics_Set(&h, 32, 100, 0);
+
+    Harmonics_Build(&h, sine, BITS, work, out, BITS);
+    reference(&h);
+    for (uint32_t i = 0; i < N; i++)
+        TEST_ASSERT_NEAR(lround(ref[i]), out[i], 3, "Mixed sample");
+    return 1;
+}
+
+/**
+ * Test: the largest excursion is normalized to full scale
+ */
+int test_normalized_peak(void)
+{
+    Harmonics_t h;
+    int32_t peak = 0;
+
+    SineQ15_BuildPeriod(sine, BITS);
+    Harmonics_Clear(&h);
+    for (uint32_t k = 1; k <= HARMONICS_MAX; k += 2)
+        Harmonics_Set(&h, k, (int16_t)(32767 / k), 0);   /* square-ish, peak > 1 */
+
+    Harmonics_Build(&h, sine, BITS, work, out, BITS);
+    for (uint32_t i = 0; i < N; i++) {
+        int32_t a = (out[i] < 0) ? -out[i] : out[i];
+        if (a > peak) peak = a;
+    }
+    TEST_ASSERT_EQUAL(32767, peak, "Peak at full scale");
+    return 1;
+}
+
+/**
+ * Test: 90 deg phase turns the fundamental into a cosine
+ */
+int test_phase(void)
+{
+    Harmonics_t h;
+
+    SineQ15_BuildPeriod(sine, BITS);
+    Harmonics_Clear(&h);
+    Harmonics_Set(&h, 1, 20000, phase_deg(90.0));
+
+    Harmonics_Build(&h, sine, BITS, work, out, BITS);
+    for (uint32_t i = 0; i < N; i++)
+        TEST_ASSERT_NEAR(sine[(i + N / 4) & (N - 1)], out[i], 1, "Cosine sample");
+    return 1;
+}
+
+/**
+ * Test: no harmonics (or only above Nyquist) gives silence
+ */
+int test_silent(void)
+{
+    Harmonics_t h;
+
+    SineQ15_BuildPeriod(sine, 4);
+    Harmonics_Clear(&h);
+    TEST_ASSERT_EQUAL(0, Harmonics_Build(&h, sine, 4, work, out, 4), "Empty set is silent");
+
+    /* 16-sample table: harmonic 8 is at Nyquist and skipped */
+    Harmonics_Set(&h, 8, 32767, 0);
+    TEST_ASSERT_EQUAL(0, Harmonics_Build(&h, sine, 4, work, out, 4), "Nyquist harmonic skipped");
+    for (uint32_t i = 0; i < 16U; i++)
+        TEST_ASSERT_EQUAL(0, out[i], "Silent sample");
+    return 1;
+}
+
+int main(void)
+{
+    printf("========================================\n");
+    printf("Harmonic Synthesis Unit Tests\n");
+    printf("========================================\n\n");
+
+    RUN_TEST(test_fundamental_is_sine);
+    RUN_TEST(test_matches_reference);
+    RUN_TEST(test_normalized_peak);
+    RUN_TEST(test_phase);
+    RUN_TEST(test_silent);
+
+    TEST_SUMMARY();
+    return (tests_passed == tests_run) ? 0 : 1;
+}
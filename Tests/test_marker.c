@@ -0,0 +1,190 @@
+/**
+ * @file test_marker.c
+ * @brief Unit tests for the sync/marker BSRR stream
+ *
+ * Word i of the marker stream carries the mark of sample i - 1 (see
+ * marker.h), so every check compares word i + 1 against sample i.
+ *
+ * Build (host):
+ *   gcc -O2 -I../STM32CubeIDE/Signal_gen test_marker.c ../STM32CubeIDE/Signal_gen/marker.c \
+ *       ../STM32CubeIDE/Signal_gen/sequencer.c ../STM32CubeIDE/Signal_gen/waveform.c \
+ *       ../STM32CubeIDE/Signal_gen/dds.c ../STM32CubeIDE/Signal_gen/blep.c -lm -o test_marker
+ */
+
+#include <stdint.h>
+#include "test_common.h"
+#include "marker.h"
+
+#define FS      1000000U
+#define BITS    10U
+#define PIN     0x0100U         /* PB8 */
+#define SET     ((uint32_t)PIN)
+#define RESET   ((uint32_t)PIN << 16)
+#define N       4096U
+
+static uint16_t table[1U << BITS];
+static uint16_t out[N];
+static uint32_t mk[N + 1];
+
+static void ramp_table(void)
+{
+    for (uint32_t i = 0; i < (1U << BITS); i++)
+        table[i] = (uint16_t)(i * 64U);
+}
+
+/**
+ * Test: marks land on the sample where the ramp restarts, across any block size
+ */
+int test_phase_marks(void)
+{
+    static const uint32_t blocks[] = { 1, 37, 512 };
+    Marker_t m;
+    DDS_t dds;
+
+    ramp_table();
+    for (unsigned b = 0; b < sizeof(blocks) / sizeof(blocks[0]); b++) {
+        uint32_t marks = 0;
+
+        DDS_Init(&dds, table, BITS, FS);
+        DDS_SetFrequency_mHz(&dds, 7777000U);      /* 128.6 samples per period */
+        dds.phase = 0xF0000000U;
+        Marker_Init(&m, PIN);
+
+        for (uint32_t i = 0; i < N; i += blocks[b]) {
+            uint32_t n = (N - i < blocks[b]) ? N - i : blocks[b];
+
+            Marker_FillPhase(&m, dds.phase, dds.tuning_word, &mk[i], n);
+            DDS_Fill(&dds, &out[i], n);
+        }
+        Marker_Clear(&m, &mk[N], 1);
+
+        for (uint32_t i = 1; i < N; i++) {
+            int restart = out[i] < out[i - 1];
+            TEST_ASSERT_EQUAL(restart ? SET : RESET, mk[i + 1], "Mark on ramp restart");
+            marks += restart;
+        }
+        TEST_ASSERT_EQUAL(RESET, mk[0], "Nothing carried in");
+        TEST_ASSERT_EQUAL(32, marks, "One mark per period");
+    }
+    return 1;
+}
+
+/**
+ * Test: period table marks every n-th sample from the current index
+ */
+int test_period_marks(void)
+{
+    Marker_t m;
+    uint32_t index = 37;
+
+    Marker_Init(&m, PIN);
+    for (uint32_t i = 0; i < 1000U; i += 64U) {
+        uint32_t n = (1000U - i < 64U) ? 1000U - i : 64U;
+
+        Marker_FillPeriod(&m, index, 100, &mk[i], n);
+        index = (index + n) % 100U;
+    }
+    for (uint32_t i = 0; i < 999U; i++)
+        TEST_ASSERT_EQUAL(((37U + i) % 100U == 0U) ? SET : RESET, mk[i + 1], "Table wrap");
+    return 1;
+}
+
+/**
+ * Test: sequence marks match the segment switches Seq_Fill makes
+ */
+int test_segment_marks(void)
+{
+    static const uint32_t blocks[] = { 1, 5, 13, 512 };
+    Sequencer_t seq;
+    Marker_t m;
+    DDS_t dds;
+
+    ramp_table();
+    DDS_Init(&dds, table, BITS, FS);
+    Seq_Init(&seq, FS, NULL);
+    Seq_AddDC(&seq, 1000, 7);
+    Seq_AddDC(&seq, 2000, 5);
+    Seq_AddDC(&seq, 3000, 1);
+    Seq_SetLoop(&seq, 1);
+
+    for (unsigned b = 0; b < sizeof(blocks) / sizeof(blocks[0]); b++) {
+        Seq_Rewind(&seq, &dds);
+        Marker_Init(&m, PIN);
+        for (uint32_t i = 0; i < 1024U; i += blocks[b]) {
+            uint32_t n = (1024U - i < blocks[b]) ? 1024U - i : blocks[b];
+
+            Marker_FillSegments(&m, &seq, &mk[i], n);
+            Seq_Fill(&seq, &dds, &out[i], n);
+        }
+        for (uint32_t i = 0; i < 1023U; i++) {
+            uint32_t t = i % 13U;
+            TEST_ASSERT_EQUAL((t == 0U || t == 7U || t == 12U) ? SET : RESET, mk[i + 1], "Segment start");
+        }
+    }
+    return 1;
+}
+
+/**
+ * Test: a one-shot sequence stops marking once it holds
+ */
+int test_one_shot_stops(void)
+{
+    Sequencer_t seq;
+    Marker_t m;
+    DDS_t dds;
+
+    ramp_table();
+    DDS_Init(&dds, table, BITS, FS);
+    Seq_Init(&seq, FS, NULL);
+    Seq_AddDC(&seq, 500, 64);
+    Seq_Rewind(&seq, &dds);
+    Marker_Init(&m, PIN);
+
+    for (uint32_t i = 0; i < 256U; i += 64U) {
+        Marker_FillSegments(&m, &seq, &mk[i], 64);
+        Seq_Fill(&seq, &dds, &out[i], 64);
+    }
+    TEST_ASSERT_EQUAL(SET, mk[1], "Start marked");
+    for (uint32_t i = 2; i < 256U; i++)
+        TEST_ASSERT_EQUAL(RESET, mk[i], "No marks after the end");
+    return 1;
+}
+
+/**
+ * Test: a mark on the last sample of a block opens the next one
+ */
+int test_carry(void)
+{
+    Marker_t m;
+
+    Marker_Init(&m, PIN);
+    Marker_Clear(&m, mk, 8);
+    Marker_Mark(&m, mk, 8, 7);
+    Marker_Mark(&m, mk, 8, 8);          /* outside the block: ignored */
+    for (uint32_t i = 0; i < 8U; i++)
+        TEST_ASSERT_EQUAL(RESET, mk[i], "Block stays low");
+
+    Marker_Clear(&m, &mk[8], 8);
+    TEST_ASSERT_EQUAL(SET, mk[8], "Carried mark");
+    TEST_ASSERT_EQUAL(RESET, mk[9], "One sample wide");
+
+    Marker_Clear(&m, &mk[16], 8);
+    TEST_ASSERT_EQUAL(RESET, mk[16], "Carry used once");
+    return 1;
+}
+
+int main(void)
+{
+    printf("========================================\n");
+    printf("Sync Marker Unit Tests\n");
+    printf("========================================\n\n");
+
+    RUN_TEST(test_phase_marks);
+    RUN_TEST(test_period_marks);
+    RUN_TEST(test_segment_marks);
+    RUN_TEST(test_one_shot_stops);
+    RUN_TEST(test_carry);
+
+    TEST_SUMMARY();
+    return (tests_passed == tests_run) ? 0 : 1;
+}
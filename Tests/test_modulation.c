@@ -0,0 +1,222 @@
+/**
+ * @file test_modulation.c
+ * @brief Unit tests for AM/FM/PM against a floating-point host reference
+ *
+ * Spectral checks use a coherent capture (carrier and modulator land on
+ * exact DFT bins) and compare sideband levels with the textbook values:
+ * d/2 for AM, Bessel J0/J1 for FM and PM.
+ *
+ * Build (host):
+ *   gcc -O2 -I../STM32CubeIDE/Signal_gen test_modulation.c ../STM32CubeIDE/Signal_gen/modulation.c \
+ *       ../STM32CubeIDE/Signal_gen/sine_q15.c ../STM32CubeIDE/Signal_gen/dds.c -lm -o test_modulation
+ */
+
+#include <stdint.h>
+#include <math.h>
+#include "test_common.h"
+#include "modulation.h"
+#include "sine_q15.h"
+
+#define N           4096U
+#define FS_HZ       1000000U
+#define TABLE_BITS  10U
+#define CARRIER_BIN 256U
+#define MOD_BIN     16U
+#define BIN_TUNING  (1U << 20)      /* 2^32 / N */
+
+static const double PI = 3.14159265358979323846;
+
+static int16_t sine[1U << TABLE_BITS];
+static uint16_t out[N];
+
+static void render(Modulation_t *m, uint32_t count)
+{
+    DDS_t carrier;
+
+    DDS_Init(&carrier, NULL, TABLE_BITS, FS_HZ);
+    carrier.tuning_word = CARRIER_BIN * BIN_TUNING;
+    m->tuning_word = MOD_BIN * BIN_TUNING;
+    m->phase = 0;
+    /* Two blocks of uneven size to exercise state carry-over */
+    Modulation_Fill(m, &carrier, 0, 4095, out, 1000);
+    Modulation_Fill(m, &carrier, 0, 4095, out + 1000, count - 1000);
+}
+
+/* Normalized amplitude of one DFT bin, DC removed, full swing = 1.0 */
+static double bin_amplitude(uint32_t bin)
+{
+    double mean = 0.0, re = 0.0, im = 0.0;
+
+    for (uint32_t i = 0; i < N; i++)
+        mean += out[i];
+    mean /= N;
+    for (uint32_t i = 0; i < N; i++) {
+        double a = 2.0 * PI * (double)bin * i / N;
+        re += (out[i] - mean) * cos(a);
+        im -= (out[i] - mean) * sin(a);
+    }
+    return 2.0 * sqrt(re * re + im * im) / N / (4095.0 / 2.0);
+}
+
+static void setup(Modulation_t *m)
+{
+    SineQ15_BuildPeriod(sine, TABLE_BITS);
+    Modulation_Init(m, sine, TABLE_BITS, FS_HZ);
+}
+
+/**
+ * Test: AM sample by sample against the float reference (same table indices)
+ */
+int test_am_reference(void)
+{
+    Modulation_t m;
+    int worst = 0;
+
+    setup(&m);
+    Modulation_SetAM(&m, 700);
+    render(&m, N);
+
+    for (uint32_t i = 0; i < N; i++) {
+        double c = sine[(uint32_t)(i * CARRIER_BIN * BIN_TUNING) >> (32U - TABLE_BITS)] / 32768.0;
+        double mod = sine[(uint32_t)(i * MOD_BIN * BIN_TUNING) >> (32U - TABLE_BITS)] / 32768.0;
+        double y = c * (1.0 + 0.7 * mod) / 2.0;
+        int ref = (int)lround((y + 1.0) / 2.0 * 4095.0);
+        int err = abs(ref - (int)out[i]);
+        if (err > worst) worst = err;
+    }
+    TEST_ASSERT_NEAR(0, worst, 1, "AM within 1 LSB of float reference");
+    return 1;
+}
+
+/**
+ * Test: AM sidebands sit at d/2 of the carrier
+ */
+int test_am_spectrum(void)
+{
+    static const uint32_t depths[] = { 250, 500, 1000 };
+    Modulation_t m;
+
+    for (unsigned k = 0; k < 3; k++) {
+        double c, lo, hi, d = depths[k] / 1000.0;
+
+        setup(&m);
+        Modulation_SetAM(&m, depths[k]);
+        render(&m, N);
+        c = bin_amplitude(CARRIER_BIN);
+        lo = bin_amplitude(CARRIER_BIN - MOD_BIN);
+        hi = bin_amplitude(CARRIER_BIN + MOD_BIN);
+        TEST_ASSERT(fabs(c - 0.5) < 0.005, "AM carrier at half swing");
+        TEST_ASSERT(fabs(lo / c - d / 2.0) < 0.005, "Lower sideband d/2");
+        TEST_ASSERT(fabs(hi / c - d / 2.0) < 0.005, "Upper sideband d/2");
+    }
+    return 1;
+}
+
+/**
+ * Test: FM at beta = 2.405 nulls the carrier, first sidebands at J1
+ */
+int test_fm_spectrum(void)
+{
+    static const double betas[] = { 1.0, 2.405 };
+    Modulation_t m;
+    double c0;
+
+    setup(&m);
+    render(&m, N);
+    c0 = bin_amplitude(CARRIER_BIN);
+    TEST_ASSERT(fabs(c0 - 1.0) < 0.005, "Unmodulated carrier at full swing");
+
+    for (unsigned k = 0; k < 2; k++) {
+        double b = betas[k];
+
+        setup(&m);
+        m.type = MODULATION_FM;
+        m.deviation = (int32_t)lround(b * MOD_BIN * BIN_TUNING);
+        render(&m, N);
+        TEST_ASSERT(fabs(bin_amplitude(CARRIER_BIN) / c0 - fabs(j0(b))) < 0.02, "Carrier at J0(beta)");
+        TEST_ASSERT(fabs(bin_amplitude(CARRIER_BIN + MOD_BIN) / c0 - fabs(j1(b))) < 0.02, "Upper sideband at J1");
+        TEST_ASSERT(fabs(bin_amplitude(CARRIER_BIN - MOD_BIN) / c0 - fabs(j1(b))) < 0.02, "Lower sideband at J1");
+        TEST_ASSERT(fabs(bin_amplitude(CARRIER_BIN + 2 * MOD_BIN) / c0 - fabs(jn(2, b))) < 0.02, "Second sideband at J2");
+    }
+    return 1;
+}
+
+/**
+ * Test: PM with index 1 rad matches the Bessel levels
+ */
+int test_pm_spectrum(void)
+{
+    Modulation_t m;
+
+    setup(&m);
+    Modulation_SetPM(&m, 1000);
+    render(&m, N);
+    TEST_ASSERT(fabs(bin_amplitude(CARRIER_BIN) - j0(1.0)) < 0.02, "Carrier at J0(1)");
+    TEST_ASSERT(fabs(bin_amplitude(CARRIER_BIN + MOD_BIN) - j1(1.0)) < 0.02, "Sideband at J1(1)");
+    TEST_ASSERT(fabs(bin_amplitude(CARRIER_BIN - MOD_BIN) - j1(1.0)) < 0.02, "Sideband at J1(1)");
+    return 1;
+}
+
+/**
+ * Test: FM deviation in mHz maps to the tuning word; PM index clamps at 2 pi
+ */
+int test_setters(void)
+{
+    Modulation_t m, limit;
+
+    setup(&m);
+    setup(&limit);
+    Modulation_SetFM(&m, 5000000U);
+    TEST_ASSERT_EQUAL(MODULATION_FM, m.type, "FM selected");
+    TEST_ASSERT_EQUAL((int32_t)DDS_TuningWord_mHz(FS_HZ, 5000000U), m.deviation, "5 kHz deviation");
+    Modulation_SetPM(&m, 1571U);
+    TEST_ASSERT_NEAR(0x40000000UL, m.pm_gain, 683566, "pi/2 is a quarter turn (1 mrad)");
+    Modulation_SetPM(&m, 100000U);
+    Modulation_SetPM(&limit, 6283U);
+    TEST_ASSERT_EQUAL(limit.pm_gain, m.pm_gain, "PM index clamped to 2 pi");
+    Modulation_SetAM(&m, 2000U);
+    TEST_ASSERT_EQUAL(32768, m.depth_q15, "AM depth clamped to 100 %");
+    return 1;
+}
+
+/**
+ * Test: carrier + deviation is capped below Nyquist by the fill
+ */
+int test_fm_nyquist_cap(void)
+{
+    static uint16_t ref[N];
+    Modulation_t m, capped;
+    DDS_t a, b;
+
+    setup(&m);
+    Modulation_SetFM(&m, 300000000U);          /* 300 kHz */
+    capped = m;
+    DDS_Init(&a, NULL, TABLE_BITS, FS_HZ);
+    DDS_SetFrequency_mHz(&a, 400000000U);      /* 400 + 300 kHz would alias */
+    b = a;
+    capped.deviation = (int32_t)(0x7FFFFFFFU - a.tuning_word);
+
+    Modulation_Fill(&m, &a, 0, 4095, out, N);
+    Modulation_Fill(&capped, &b, 0, 4095, ref, N);
+    for (uint32_t i = 0; i < N; i++)
+        TEST_ASSERT_EQUAL(ref[i], out[i], "Capped sample");
+    TEST_ASSERT_EQUAL(b.phase, a.phase, "Capped phase");
+    return 1;
+}
+
+int main(void)
+{
+    printf("========================================\n");
+    printf("Modulation Unit Tests\n");
+    printf("========================================\n\n");
+
+    RUN_TEST(test_am_reference);
+    RUN_TEST(test_am_spectrum);
+    RUN_TEST(test_fm_spectrum);
+    RUN_TEST(test_pm_spectrum);
+    RUN_TEST(test_setters);
+    RUN_TEST(test_fm_nyquist_cap);
+
+    TEST_SUMMARY();
+    return (tests_passed == tests_run) ? 0 : 1;
+}
@@ -0,0 +1,193 @@
+/**
+ * @file test_multitone.c
+ * @brief Unit tests for the multi-tone mixer
+ *
+ * Build (host):
+ *   gcc -O2 -I../STM32CubeIDE/Signal_gen test_multitone.c ../STM32CubeIDE/Signal_gen/multitone.c \
+ *       ../STM32CubeIDE/Signal_gen/sine_q15.c ../STM32CubeIDE/Signal_gen/dds.c -lm -o test_multitone
+ */
+
+#include <stdint.h>
+#include <math.h>
+#include "test_common.h"
+#include "multitone.h"
+#include "sine_q15.h"
+#include "dds.h"
+
+#define FS      1000000U
+#define BITS    10U
+#define N       4096U
+#define PI      3.14159265358979323846
+
+static int16_t sine[1U << BITS];
+static uint16_t out[N], ref[N];
+
+static void setup(MultiTone_t *mt)
+{
+    SineQ15_BuildPeriod(sine, BITS);
+    MultiTone_Init(mt, sine, BITS, FS);
+}
+
+/* Amplitude of bin k, in codes */
+static double tone_amplitude(uint32_t k)
+{
+    double re = 0.0, im = 0.0;
+
+    for (uint32_t i = 0; i < N; i++) {
+        re += out[i] * cos(2.0 * PI * k * i / N);
+        im -= out[i] * sin(2.0 * PI * k * i / N);
+    }
+    return 2.0 * sqrt(re * re + im * im) / N;
+}
+
+/* Frequency of bin k, mHz */
+static uint32_t bin_mhz(uint32_t k)
+{
+    return (uint32_t)((uint64_t)k * FS * 1000U / N);
+}
+
+/**
+ * Test: one full tone is the plain sine within a code
+ */
+int test_single_tone(void)
+{
+    static uint16_t table[1U << BITS];
+    MultiTone_t mt;
+    DDS_t dds;
+
+    setup(&mt);
+    for (uint32_t i = 0; i < (1U << BITS); i++)
+        table[i] = (uint16_t)(sine[i] + 32768);
+    DDS_Init(&dds, table, BITS, FS);
+    DDS_SetFrequency_mHz(&dds, 12345678U);
+
+    TEST_ASSERT(MultiTone_Add(&mt, 12345678U, 1000, 0), "Add");
+    TEST_ASSERT_EQUAL(32767, mt.tone[0].amp_q15, "Full amplitude");
+    MultiTone_Fill(&mt, 100, 4000, NULL, out, 1000);
+    DDS_FillScaled(&dds, 100, 4000, ref, 1000);
+    for (uint32_t i = 0; i < 1000U; i++)
+        TEST_ASSERT_NEAR(ref[i], out[i], 1, "Sample");
+    TEST_ASSERT_EQUAL(dds.phase, mt.tone[0].phase, "Phase advance");
+    return 1;
+}
+
+/**
+ * Test: two tones keep their programmed amplitudes (DTMF '1')
+ */
+int test_two_tones(void)
+{
+    MultiTone_t mt;
+
+    setup(&mt);
+    MultiTone_Add(&mt, bin_mhz(3), 500, 0);     /* coherent stand-ins for 697 / 1209 Hz */
+    MultiTone_Add(&mt, bin_mhz(5), 300, 90);
+    MultiTone_Fill(&mt, 0, 4000, NULL, out, N);
+
+    TEST_ASSERT_NEAR(1000, (int32_t)lround(tone_amplitude(3)), 2, "Low tone: 0.5 of half swing");
+    TEST_ASSERT_NEAR(600, (int32_t)lround(tone_amplitude(5)), 2, "High tone: 0.3 of half swing");
+    TEST_ASSERT(tone_amplitude(4) < 1.0, "Nothing between");
+    TEST_ASSERT_NEAR(2000 + 600, out[0], 1, "Start phases");     /* sin 0 and sin 90 */
+    return 1;
+}
+
+/**
+ * Test: eight full tones are scaled to the swing and never clip
+ */
+int test_headroom(void)
+{
+    MultiTone_t mt;
+    uint16_t lo = 0xFFFF, hi = 0;
+
+    setup(&mt);
+    for (uint32_t k = 0; k < MT_MAX_TONES; k++)
+        TEST_ASSERT(MultiTone_Add(&mt, 0, 1000, 90), "Tone fits");
+    for (uint32_t k = 0; k < MT_MAX_TONES; k++)
+        TEST_ASSERT_EQUAL(4095, mt.tone[k].amp_q15, "Scaled by 1 / 8");
+
+    /* All at their peak at once: the worst crest lands on high */
+    MultiTone_Fill(&mt, 500, 3500, NULL, out, 16);
+    TEST_ASSERT_NEAR(3500, out[0], 1, "Crest on high");
+
+    setup(&mt);
+    for (uint32_t k = 0; k < MT_MAX_TONES; k++)
+        MultiTone_Add(&mt, 1000U * (697U + 150U * k), 1000, 45U * k);
+    MultiTone_Fill(&mt, 500, 3500, NULL, out, N);
+    for (uint32_t i = 0; i < N; i++) {
+        if (out[i] < lo) lo = out[i];
+        if (out[i] > hi) hi = out[i];
+    }
+    TEST_ASSERT(lo >= 500 && hi <= 3500, "Inside the swing");
+    return 1;
+}
+
+/**
+ * Test: any block split gives the same samples
+ */
+int test_block_split(void)
+{
+    static const uint32_t blocks[] = { 1, 7, 64, 65, 512 };
+    MultiTone_t a, b;
+
+    setup(&a);
+    MultiTone_Add(&a, 1209000000U, 400, 0);
+    MultiTone_Add(&a, 697000000U, 400, 0);
+    MultiTone_Add(&a, 123456789U, 200, 30);
+    b = a;
+    MultiTone_Fill(&a, 0, 4095, NULL, ref, N);
+
+    for (unsigned s = 0; s < sizeof(blocks) / sizeof(blocks[0]); s++) {
+        MultiTone_t m = b;
+
+        for (uint32_t i = 0; i < N; i += blocks[s])
+            MultiTone_Fill(&m, 0, 4095, NULL, &out[i], (N - i < blocks[s]) ? N - i : blocks[s]);
+        for (uint32_t i = 0; i < N; i++)
+            TEST_ASSERT_EQUAL(ref[i], out[i], "Split sample");
+    }
+    return 1;
+}
+
+/**
+ * Test: limits, empty set and the DAC correction
+ */
+int test_limits(void)
+{
+    static uint16_t lut[4096];
+    MultiTone_t mt;
+
+    setup(&mt);
+    MultiTone_Fill(&mt, 1000, 3000, NULL, out, 8);
+    TEST_ASSERT_EQUAL(2000, out[7], "Empty set is mid-level");
+    TEST_ASSERT(!MultiTone_Add(&mt, 1000000U, 1001, 0), "Amplitude over 1000");
+
+    for (uint32_t k = 0; k < MT_MAX_TONES; k++)
+        MultiTone_Add(&mt, 1000000U, 100, 0);
+    TEST_ASSERT(!MultiTone_Add(&mt, 1000000U, 100, 0), "Set full");
+    TEST_ASSERT_EQUAL(3276, mt.tone[0].amp_q15, "Sum under 1000 is not scaled");
+
+    for (uint32_t c = 0; c < 4096U; c++)
+        lut[c] = (uint16_t)(4095U - c);
+    setup(&mt);
+    MultiTone_Add(&mt, 3000000U, 700, 0);
+    MultiTone_Fill(&mt, 200, 3900, NULL, ref, 300);
+    mt.tone[0].phase = 0;
+    MultiTone_Fill(&mt, 200, 3900, lut, out, 300);
+    for (uint32_t i = 0; i < 300U; i++)
+        TEST_ASSERT_EQUAL(lut[ref[i]], out[i], "Corrected sample");
+    return 1;
+}
+
+int main(void)
+{
+    printf("========================================\n");
+    printf("Multi-Tone Mixer Unit Tests\n");
+    printf("========================================\n\n");
+
+    RUN_TEST(test_single_tone);
+    RUN_TEST(test_two_tones);
+    RUN_TEST(test_headroom);
+    RUN_TEST(test_block_split);
+    RUN_TEST(test_limits);
+
+    TEST_SUMMARY();
+    return (tests_passed == tests_run) ? 0 : 1;
+}
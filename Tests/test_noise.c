@@ -0,0 +1,220 @@
+/**
+ * @file test_noise.c
+ * @brief Unit tests for the white/pink noise sources
+ *
+ * Spectra are Welch estimates (averaged 1024-point periodograms, Hann
+ * window) of 64k samples rendered in 512-sample blocks like the DMA
+ * refill does.
+ *
+ * Build (host):
+ *   gcc -O2 -I../STM32CubeIDE/Signal_gen test_noise.c ../STM32CubeIDE/Signal_gen/noise.c \
+ *       -lm -o test_noise
+ */
+
+#include <stdint.h>
+#include <math.h>
+#include "test_common.h"
+#include "noise.h"
+
+#define FS_HZ       1000000U
+#define BLOCK       512U
+#define TOTAL       65536U
+#define SEG         1024U
+
+static const double PI = 3.14159265358979323846;
+
+static uint16_t samples[TOTAL];
+static double psd[SEG / 2 + 1];
+
+typedef void (*fill_fn)(Noise_t *n, uint16_t low, uint16_t high, uint16_t *dst, uint32_t count);
+
+static void render(fill_fn fill, uint32_t bandwidth_hz)
+{
+    Noise_t n;
+
+    Noise_Init(&n, 12345U);
+    Noise_SetBandwidth_Hz(&n, FS_HZ, bandwidth_hz);
+    for (uint32_t i = 0; i < TOTAL; i += BLOCK)
+        fill(&n, 0, 4095, samples + i, BLOCK);
+}
+
+static void fft(double *re, double *im, uint32_t n)
+{
+    for (uint32_t i = 1, j = 0; i < n; i++) {
+        uint32_t bit = n >> 1;
+        for (; j & bit; bit >>= 1)
+            j ^= bit;
+        j |= bit;
+        if (i < j) {
+            double t = re[i]; re[i] = re[j]; re[j] = t;
+            t = im[i]; im[i] = im[j]; im[j] = t;
+        }
+    }
+    for (uint32_t len = 2; len <= n; len <<= 1) {
+        double a = -2.0 * PI / (double)len;
+        for (uint32_t i = 0; i < n; i += len) {
+            for (uint32_t k = 0; k < len / 2; k++) {
+                double cr = cos(a * k), ci = sin(a * k);
+                uint32_t u = i + k, v = i + k + len / 2;
+                double xr = re[v] * cr - im[v] * ci;
+                double xi = re[v] * ci + im[v] * cr;
+                re[v] = re[u] - xr; im[v] = im[u] - xi;
+                re[u] += xr;        im[u] += xi;
+            }
+        }
+    }
+}
+
+static void welch(void)
+{
+    static double re[SEG], im[SEG];
+    double mean = 0.0;
+
+    for (uint32_t i = 0; i < TOTAL; i++)
+        mean += samples[i];
+    mean /= TOTAL;
+
+    for (uint32_t b = 0; b <= SEG / 2; b++)
+        psd[b] = 0.0;
+    for (uint32_t s = 0; s + SEG <= TOTAL; s += SEG) {
+        for (uint32_t i = 0; i < SEG; i++) {
+            double w = 0.5 - 0.5 * cos(2.0 * PI * i / SEG);
+            re[i] = (samples[s + i] - mean) * w;
+            im[i] = 0.0;
+        }
+        fft(re, im, SEG);
+        for (uint32_t b = 0; b <= SEG / 2; b++)
+            psd[b] += re[b] * re[b] + im[b] * im[b];
+    }
+}
+
+/* Geometric over arithmetic mean of the PSD between two bins: 1.0 = flat */
+static double flatness(uint32_t from, uint32_t to)
+{
+    double lg = 0.0, ar = 0.0;
+
+    for (uint32_t b = from; b < to; b++) {
+        lg += log(psd[b]);
+        ar += psd[b];
+    }
+    return exp(lg / (to - from)) / (ar / (to - from));
+}
+
+static double band_power(uint32_t from, uint32_t to)
+{
+    double p = 0.0;
+
+    for (uint32_t b = from; b < to; b++)
+        p += psd[b];
+    return p / (to - from);
+}
+
+/**
+ * Test: white noise covers the whole swing with a flat mean
+ */
+int test_white_levels(void)
+{
+    uint32_t hist[16] = { 0 };
+    double mean = 0.0;
+
+    render(Noise_FillWhite, 0);
+    for (uint32_t i = 0; i < TOTAL; i++) {
+        TEST_ASSERT(samples[i] <= 4095, "Inside swing");
+        hist[samples[i] >> 8]++;
+        mean += samples[i];
+    }
+    TEST_ASSERT_NEAR(2048, (long)(mean / TOTAL), 20, "Mean at mid-level");
+    for (int k = 0; k < 16; k++)
+        TEST_ASSERT_NEAR(TOTAL / 16, hist[k], TOTAL / 16 / 10, "Uniform histogram");
+    return 1;
+}
+
+/**
+ * Test: full-band white noise is spectrally flat
+ */
+int test_white_flatness(void)
+{
+    render(Noise_FillWhite, 0);
+    welch();
+    TEST_ASSERT(flatness(2, SEG / 2) > 0.95, "White spectral flatness > 0.95");
+    return 1;
+}
+
+/**
+ * Test: pink noise falls at ~3 dB/octave (slope -1 in log power vs log f)
+ */
+int test_pink_slope(void)
+{
+    double sx = 0, sy = 0, sxx = 0, sxy = 0, slope;
+    int n = 0;
+
+    render(Noise_FillPink, 0);
+    welch();
+    TEST_ASSERT(flatness(2, SEG / 2) < 0.5, "Pink is not flat");
+
+    /* Octave bands 2..4, 4..8, ..., 128..256 bins (2 kHz .. 250 kHz) */
+    for (uint32_t b = 2; b < 256; b <<= 1, n++) {
+        double x = log10((double)b * 1.5);
+        double y = log10(band_power(b, 2 * b));
+        sx += x; sy += y; sxx += x * x; sxy += x * y;
+    }
+    slope = (n * sxy - sx * sy) / (n * sxx - sx * sx);
+    TEST_ASSERT(slope < -0.8 && slope > -1.2, "Pink slope near -1");
+    return 1;
+}
+
+/**
+ * Test: the bandwidth setting rolls the spectrum off above the corner
+ */
+int test_bandwidth(void)
+{
+    render(Noise_FillWhite, 10000U);
+    welch();
+    /* bins are ~977 Hz: 2..6 is well inside, 200..500 is a decade above */
+    TEST_ASSERT(10.0 * log10(band_power(2, 6) / band_power(200, 500)) > 20.0,
+                "White rolls off > 20 dB a decade above 10 kHz");
+
+    render(Noise_FillPink, 10000U);
+    for (uint32_t i = 0; i < TOTAL; i++)
+        TEST_ASSERT(samples[i] <= 4095, "Filtered pink inside swing");
+    return 1;
+}
+
+/**
+ * Test: block splits of even length reproduce the same stream
+ */
+int test_block_continuity(void)
+{
+    static uint16_t whole[1024];
+    static uint16_t split[1024];
+    static const fill_fn fills[] = { Noise_FillWhite, Noise_FillPink };
+
+    for (int f = 0; f < 2; f++) {
+        Noise_t a, b;
+
+        Noise_Init(&a, 7);
+        Noise_Init(&b, 7);
+        fills[f](&a, 0, 4095, whole, 1024);
+        fills[f](&b, 0, 4095, split, 334);
+        fills[f](&b, 0, 4095, split + 334, 1024 - 334);
+        for (uint32_t i = 0; i < 1024; i++)
+            TEST_ASSERT_EQUAL(whole[i], split[i], "Split block equals whole block");
+    }
+    return 1;
+}
+
+int main(void)
+{
+    printf("========================================\n");
+    printf("Noise Source Unit Tests\n");
+    printf("========================================\n\n");
+
+    RUN_TEST(test_white_levels);
+    RUN_TEST(test_white_flatness);
+    RUN_TEST(test_pink_slope);
+    RUN_TEST(test_bandwidth);
+    RUN_TEST(test_block_continuity);
+
+    TEST_SUMMARY();
+    return (tests_passed == tests_run) ? 0 : 1;
+}
@@ -0,0 +1,233 @@
+/**
+ * @file test_preset.c
+ * @brief Unit tests for the QSPI preset store
+ *
+ * The flash is a RAM array with NOR rules: erase sets a sector to 0xFF,
+ * programming can only clear bits. Reads go straight to the array, as
+ * they do through the memory-mapped window on the target.
+ *
+ * Build (host):
+ *   gcc -O2 -I../STM32CubeIDE/Signal_gen test_preset.c ../STM32CubeIDE/Signal_gen/preset.c \
+ *       -o test_preset
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "test_common.h"
+#include "preset.h"
+
+#define OFFSET  0x00F80000U
+
+static uint8_t nor[PRESET_REGION_BYTES];
+static uint16_t wave[PRESET_MAX_SAMPLES + 1U];
+static int mapped = 1;
+static int fail_program_after = -1;     /* programs left before a "power cut" */
+static uint32_t erases;
+
+static int fake_erase(uint32_t addr)
+{
+    TEST_ASSERT(!mapped, "Erase while unmapped");
+    TEST_ASSERT(addr % PRESET_SECTOR_BYTES == 0U, "Sector aligned");
+    memset(&nor[addr - OFFSET], 0xFF, PRESET_SECTOR_BYTES);
+    erases++;
+    return 1;
+}
+
+static int fake_program(uint32_t addr, const void *data, uint32_t len)
+{
+    const uint8_t *p = (const uint8_t *)data;
+
+    TEST_ASSERT(!mapped, "Program while unmapped");
+    if (fail_program_after == 0)
+        return 0;
+    if (fail_program_after > 0)
+        fail_program_after--;
+    for (uint32_t i = 0; i < len; i++)
+        nor[addr - OFFSET + i] &= p[i];
+    return 1;
+}
+
+static void fake_begin(void) { mapped = 0; }
+static void fake_end(void)   { mapped = 1; }
+
+static const PresetFlash_t flash = { nor, OFFSET, fake_erase, fake_program, fake_begin, fake_end };
+
+static void blank(PresetStore_t *ps)
+{
+    memset(nor, 0xFF, sizeof(nor));
+    fail_program_after = -1;
+    Preset_Init(ps, &flash);
+}
+
+static PresetHeader_t dds_params(uint32_t samples)
+{
+    PresetHeader_t h;
+
+    memset(&h, 0, sizeof(h));
+    h.kind = PRESET_DDS;
+    h.form = 9;
+    h.low = 100;
+    h.high = 4000;
+    h.freq_mhz = 1234567U;
+    h.samples = samples;
+    return h;
+}
+
+/**
+ * Test: check value of the CRC and a blank region
+ */
+int test_empty(void)
+{
+    PresetStore_t ps;
+
+    TEST_ASSERT_EQUAL(0xCBF43926U, Preset_Crc32("123456789", 9), "CRC-32 check value");
+    blank(&ps);
+    TEST_ASSERT_EQUAL(0, ps.valid, "No presets");
+    TEST_ASSERT_EQUAL(0, Preset_FreeSlot(&ps), "First slot free");
+    TEST_ASSERT(Preset_Header(&ps, 0) == NULL, "No header");
+    TEST_ASSERT_EQUAL(-1, Preset_Find(&ps, "SINE"), "Nothing to find");
+    return 1;
+}
+
+/**
+ * Test: a 4096-sample table and its parameters come back in place
+ */
+int test_round_trip(void)
+{
+    PresetStore_t ps;
+    PresetHeader_t h = dds_params(PRESET_MAX_SAMPLES);
+    const PresetHeader_t *got;
+    const uint16_t *t;
+
+    blank(&ps);
+    for (uint32_t i = 0; i < PRESET_MAX_SAMPLES; i++)
+        wave[i] = (uint16_t)(i * 16U + (i >> 3));
+    erases = 0;
+    TEST_ASSERT(Preset_Save(&ps, 5, "ARB-1", &h, wave), "Save");
+    TEST_ASSERT(mapped, "Mapped again");
+    TEST_ASSERT_EQUAL(3, erases, "Only sectors with data erased");
+
+    got = Preset_Header(&ps, 5);
+    TEST_ASSERT(got != NULL, "Listed");
+    TEST_ASSERT((const uint8_t *)got == nor + 5U * PRESET_SLOT_BYTES, "Read in place");
+    TEST_ASSERT_EQUAL(PRESET_DDS, got->kind, "Kind");
+    TEST_ASSERT_EQUAL(1234567U, got->freq_mhz, "Frequency");
+    TEST_ASSERT_EQUAL(4000, got->high, "Level");
+    TEST_ASSERT(strcmp(got->name, "ARB-1") == 0, "Name");
+
+    t = Preset_Table(&ps, 5);
+    TEST_ASSERT(t != NULL, "Table");
+    TEST_ASSERT(memcmp(t, wave, PRESET_MAX_SAMPLES * 2U) == 0, "Table contents");
+
+    Preset_Init(&ps, &flash);
+    TEST_ASSERT_EQUAL(1U << 5, ps.valid, "Found again by a scan");
+    TEST_ASSERT_EQUAL(5, Preset_Find(&ps, "ARB-1"), "Find by name");
+    TEST_ASSERT_EQUAL(0, Preset_FreeSlot(&ps), "Others free");
+    return 1;
+}
+
+/**
+ * Test: parameter-only presets and overwriting a slot
+ */
+int test_overwrite(void)
+{
+    PresetStore_t ps;
+    PresetHeader_t h = dds_params(PRESET_MAX_SAMPLES);
+
+    blank(&ps);
+    TEST_ASSERT(Preset_Save(&ps, 0, "LONG", &h, wave), "Table preset");
+    h = dds_params(0);
+    h.kind = PRESET_EXACT;
+    h.psc = 0;
+    h.arr = 107;
+    erases = 0;
+    TEST_ASSERT(Preset_Save(&ps, 0, "SQUARE-12345", &h, NULL), "Parameter preset over it");
+    TEST_ASSERT_EQUAL(1, erases, "Header sector only");
+    TEST_ASSERT(Preset_Table(&ps, 0) == NULL, "No table");
+    TEST_ASSERT_EQUAL(107, Preset_Header(&ps, 0)->arr, "New parameters");
+    TEST_ASSERT_EQUAL(0, Preset_Find(&ps, "SQUARE-12345"), "Full-length name matches");
+
+    TEST_ASSERT(Preset_Erase(&ps, 0), "Erase");
+    Preset_Scan(&ps);
+    TEST_ASSERT_EQUAL(0, ps.valid, "Gone after a rescan");
+    return 1;
+}
+
+/**
+ * Test: a flipped bit in the table or header drops the slot from the index
+ */
+int test_corruption(void)
+{
+    PresetStore_t ps;
+    PresetHeader_t h = dds_params(1024);
+
+    blank(&ps);
+    TEST_ASSERT(Preset_Save(&ps, 1, "A", &h, wave), "Save A");
+    TEST_ASSERT(Preset_Save(&ps, 2, "B", &h, wave), "Save B");
+
+    nor[1U * PRESET_SLOT_BYTES + PRESET_TABLE_OFFSET + 700U] ^= 0x04;
+    nor[2U * PRESET_SLOT_BYTES + offsetof(PresetHeader_t, freq_mhz)] ^= 0x01;
+    TEST_ASSERT_EQUAL(0, Preset_Scan(&ps), "Both rejected");
+    TEST_ASSERT(Preset_Header(&ps, 1) == NULL, "Bad table");
+    TEST_ASSERT(Preset_Header(&ps, 2) == NULL, "Bad header");
+    return 1;
+}
+
+/**
+ * Test: a save cut short leaves the slot empty, not half valid
+ */
+int test_power_cut(void)
+{
+    PresetStore_t ps;
+    PresetHeader_t h = dds_params(2048);
+
+    blank(&ps);
+    TEST_ASSERT(Preset_Save(&ps, 3, "OLD", &h, wave), "Save");
+    fail_program_after = 1;         /* table written, header lost */
+    TEST_ASSERT(!Preset_Save(&ps, 3, "NEW", &h, wave), "Save fails");
+    TEST_ASSERT(mapped, "Mapped again");
+    TEST_ASSERT_EQUAL(0, Preset_Scan(&ps), "Slot empty");
+    TEST_ASSERT_EQUAL(-1, Preset_Find(&ps, "OLD"), "Old preset not resurrected");
+    return 1;
+}
+
+/**
+ * Test: bad slot numbers and oversized tables are refused without erasing
+ */
+int test_limits(void)
+{
+    PresetStore_t ps;
+    PresetHeader_t h = dds_params(PRESET_MAX_SAMPLES + 1U);
+
+    blank(&ps);
+    erases = 0;
+    TEST_ASSERT(!Preset_Save(&ps, 0, "BIG", &h, wave), "Too long");
+    h = dds_params(16);
+    TEST_ASSERT(!Preset_Save(&ps, PRESET_SLOTS, "OUT", &h, wave), "No such slot");
+    TEST_ASSERT(!Preset_Save(&ps, 0, "NULL", &h, NULL), "Table missing");
+    TEST_ASSERT_EQUAL(0, erases, "Nothing erased");
+
+    for (uint32_t s = 0; s < PRESET_SLOTS; s++)
+        TEST_ASSERT(Preset_Save(&ps, s, "X", &h, wave), "Fill");
+    TEST_ASSERT_EQUAL(-1, Preset_FreeSlot(&ps), "Full");
+    TEST_ASSERT_EQUAL(0, Preset_Find(&ps, "X"), "First match");
+    return 1;
+}
+
+int main(void)
+{
+    printf("========================================\n");
+    printf("Preset Store Unit Tests\n");
+    printf("========================================\n\n");
+
+    RUN_TEST(test_empty);
+    RUN_TEST(test_round_trip);
+    RUN_TEST(test_overwrite);
+    RUN_TEST(test_corruption);
+    RUN_TEST(test_power_cut);
+    RUN_TEST(test_limits);
+
+    TEST_SUMMARY();
+    return (tests_passed == tests_run) ? 0 : 1;
+}
@@ -0,0 +1,125 @@
+/**
+ * @file test_pwm_out.c
+ * @brief Unit tests for the timer PWM square/pulse planner
+ *
+ * Build (host):
+ *   gcc -O2 -I../STM32CubeIDE/Signal_gen test_pwm_out.c \
+ *       ../STM32CubeIDE/Signal_gen/pwm_out.c -o test_pwm_out
+ */
+
+#include <stdint.h>
+#include "test_common.h"
+#include "pwm_out.h"
+
+#define TIM_CLK_HZ  216000000U
+#define HALF        0x80000000U
+
+/* |f_plan / f_target - 1| in ppm */
+static uint64_t error_ppm(const PwmPlan_t *p, uint32_t freq_mhz)
+{
+    uint64_t ideal = (uint64_t)freq_mhz * (p->psc + 1U) * (p->arr + 1U);
+    uint64_t clk = (uint64_t)TIM_CLK_HZ * 1000U;
+    uint64_t diff = (clk > ideal) ? clk - ideal : ideal - clk;
+
+    return diff * 1000000U / ideal;
+}
+
+/**
+ * Test: MHz squares divide the clock directly, 50 % duty
+ */
+int test_mhz_square(void)
+{
+    PwmPlan_t p;
+
+    TEST_ASSERT(PwmOut_Plan(TIM_CLK_HZ, 1000000000U, HALF, 10000, &p), "1 MHz");
+    TEST_ASSERT_EQUAL(0, p.psc, "No prescaler");
+    TEST_ASSERT_EQUAL(215, p.arr, "216 counts");
+    TEST_ASSERT_EQUAL(108, p.ccr, "Half");
+    TEST_ASSERT_EQUAL(HALF, PwmOut_Duty(&p), "Duty back");
+
+    TEST_ASSERT(PwmOut_Plan(TIM_CLK_HZ, 4000000000U, HALF, 10000, &p), "4 MHz");
+    TEST_ASSERT_EQUAL(53, p.arr, "54 counts");
+    TEST_ASSERT_EQUAL(4000000000U, PwmOut_Frequency_mHz(TIM_CLK_HZ, &p), "Exact");
+    return 1;
+}
+
+/**
+ * Test: slow periods use the prescaler and keep ARR near 16 bits
+ */
+int test_prescaler(void)
+{
+    PwmPlan_t p;
+
+    TEST_ASSERT(PwmOut_Plan(TIM_CLK_HZ, 1000U, HALF, 10, &p), "1 Hz");
+    TEST_ASSERT_EQUAL(3295, p.psc, "Smallest prescaler");
+    TEST_ASSERT(p.arr > 65000U && p.arr <= 65535U, "ARR in 16 bits");
+    TEST_ASSERT(error_ppm(&p, 1000U) < 1U, "Sub-ppm");
+
+    TEST_ASSERT(PwmOut_Plan(TIM_CLK_HZ, 3296000U, HALF, 10, &p), "Just above one prescaler step");
+    TEST_ASSERT_EQUAL(0, p.psc, "65534 counts need no prescaler");
+    TEST_ASSERT(!PwmOut_Plan(TIM_CLK_HZ, 10U, HALF, 10000, &p), "Period past 32 bits");
+    return 1;
+}
+
+/**
+ * Test: every step of 50 kHz .. 4.25 MHz plans within the tolerance
+ */
+int test_sweep_tolerance(void)
+{
+    PwmPlan_t p;
+
+    for (uint32_t f = 50000000U; f <= 4250000000U; f += 12345678U) {
+        TEST_ASSERT(PwmOut_Plan(TIM_CLK_HZ, f, HALF, 10000, &p), "Planned");
+        TEST_ASSERT(error_ppm(&p, f) <= 10000U, "Within 1 %");
+        TEST_ASSERT(p.ccr >= 1U && p.ccr <= p.arr, "Both edges");
+    }
+    TEST_ASSERT(!PwmOut_Plan(TIM_CLK_HZ, 4200000000U, HALF, 1000, &p), "Off by 0.8 %, refused at 0.1 %");
+    return 1;
+}
+
+/**
+ * Test: pulse duty rounds to the nearest count and never goes DC
+ */
+int test_duty(void)
+{
+    PwmPlan_t p;
+
+    TEST_ASSERT(PwmOut_Plan(TIM_CLK_HZ, 1000000000U, 0x40000000U, 10000, &p), "25 %");
+    TEST_ASSERT_EQUAL(54, p.ccr, "54 of 216");
+    TEST_ASSERT(PwmOut_Plan(TIM_CLK_HZ, 1000000000U, 0, 10000, &p), "0 %");
+    TEST_ASSERT_EQUAL(1, p.ccr, "Clamped to one count");
+    TEST_ASSERT(PwmOut_Plan(TIM_CLK_HZ, 1000000000U, 0xFFFFFFFFU, 10000, &p), "100 %");
+    TEST_ASSERT_EQUAL(215, p.ccr, "Clamped below the period");
+    return 1;
+}
+
+/**
+ * Test: zero and beyond-clock frequencies are refused
+ */
+int test_limits(void)
+{
+    PwmPlan_t p;
+
+    TEST_ASSERT(!PwmOut_Plan(TIM_CLK_HZ, 0, HALF, 10000, &p), "Zero");
+    TEST_ASSERT(!PwmOut_Plan(1000U, 800000U, HALF, 1000000, &p), "Under two counts");
+    TEST_ASSERT(PwmOut_Plan(1000U, 500000U, HALF, 0, &p), "Exactly two counts");
+    TEST_ASSERT_EQUAL(1, p.arr, "ARR");
+    TEST_ASSERT_EQUAL(1, p.ccr, "One high, one low");
+    return 1;
+}
+
+int main(void)
+{
+    printf("========================================\n");
+    printf("Timer PWM Planner Unit Tests\n");
+    printf("========================================\n\n");
+
+    RUN_TEST(test_mhz_square);
+    RUN_TEST(test_prescaler);
+    RUN_TEST(test_sweep_tolerance);
+    RUN_TEST(test_duty);
+    RUN_TEST(test_limits);
+
+    TEST_SUMMARY();
+    return (tests_passed == tests_run) ? 0 : 1;
+}
@@ -0,0 +1,226 @@
+/**
+ * @file test_ramp.c
+ * @brief Unit tests for the level / gate ramps of the block fill
+ *
+ * Build (host):
+ *   gcc -O2 -I../STM32CubeIDE/Signal_gen test_ramp.c ../STM32CubeIDE/Signal_gen/ramp.c \
+ *       ../STM32CubeIDE/Signal_gen/dds.c -lm -o test_ramp
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <math.h>
+#include "test_common.h"
+#include "ramp.h"
+#include "dds.h"
+
+#define FS      1000000U
+#define BITS    10U
+#define N       4096U
+#define PI      3.14159265358979323846
+
+static uint16_t table[1U << BITS];
+static uint16_t out[N];
+
+/* The block fill in signal_gen.c: chunks with their own levels, gate folded in */
+static void render(Ramp_t *r, DDS_t *dds, uint16_t *dst, uint32_t count)
+{
+    while (count) {
+        uint16_t lo, hi;
+        uint32_t g, n = Ramp_Next(r, count, &lo, &hi, &g);
+
+        DDS_FillScaled(dds, (uint16_t)((lo * g) >> 16), (uint16_t)((hi * g) >> 16), dst, n);
+        dst += n;
+        count -= n;
+    }
+}
+
+static void sine_setup(DDS_t *dds)
+{
+    for (uint32_t i = 0; i < (1U << BITS); i++)
+        table[i] = (uint16_t)lround(32767.5 + 32767.5 * sin(2.0 * PI * i / (1U << BITS)));
+    DDS_Init(dds, table, BITS, FS);
+    DDS_SetFrequency_mHz(dds, 1000000U);       /* 1 kHz */
+}
+
+static uint32_t max_jump(uint32_t from, uint32_t to)
+{
+    uint32_t worst = 0;
+
+    for (uint32_t i = from + 1U; i < to; i++) {
+        uint32_t d = (uint32_t)abs((int)out[i] - (int)out[i - 1]);
+        if (d > worst) worst = d;
+    }
+    return worst;
+}
+
+/**
+ * Test: idle ramp hands out the whole block with the target levels
+ */
+int test_idle(void)
+{
+    Ramp_t r;
+    uint16_t lo, hi;
+    uint32_t g;
+
+    Ramp_Init(&r, 100, 4000, RAMP_UNITY, 1000);
+    TEST_ASSERT(!Ramp_Active(&r), "Idle");
+    TEST_ASSERT_EQUAL(512, Ramp_Next(&r, 512, &lo, &hi, &g), "One piece");
+    TEST_ASSERT_EQUAL(100, lo, "Low");
+    TEST_ASSERT_EQUAL(4000, hi, "High");
+    TEST_ASSERT_EQUAL(RAMP_UNITY, g, "Gate");
+    return 1;
+}
+
+/**
+ * Test: targets are met exactly after length samples, whatever the blocks
+ */
+int test_reaches_target(void)
+{
+    static const uint32_t blocks[] = { 1, 7, 16, 100, 512 };
+
+    for (unsigned b = 0; b < sizeof(blocks) / sizeof(blocks[0]); b++) {
+        Ramp_t r;
+        uint32_t done = 0, prev = 0;
+
+        Ramp_Init(&r, 0, 0, 0, 1000);
+        Ramp_To(&r, 1000, 3000, RAMP_UNITY);
+        while (done < 1000U) {
+            uint16_t lo, hi;
+            uint32_t g, want = (1000U - done < blocks[b]) ? 1000U - done : blocks[b];
+
+            while (want) {
+                uint32_t n = Ramp_Next(&r, want, &lo, &hi, &g);
+                TEST_ASSERT(n <= RAMP_CHUNK, "Chunked while running");
+                TEST_ASSERT(g >= prev && g <= RAMP_UNITY, "Gate rises");
+                TEST_ASSERT(hi <= 3000 && lo <= 1000, "No overshoot");
+                prev = g;
+                want -= n;
+                done += n;
+            }
+        }
+        TEST_ASSERT(!Ramp_Active(&r), "Done after length");
+        TEST_ASSERT_EQUAL(1000U << 16, r.low, "Low exact");
+        TEST_ASSERT_EQUAL(3000U << 16, r.high, "High exact");
+        TEST_ASSERT_EQUAL(RAMP_UNITY, r.gate, "Gate exact");
+    }
+    return 1;
+}
+
+/**
+ * Test: a new target mid-ramp continues from where the ramp is
+ */
+int test_retarget(void)
+{
+    Ramp_t r;
+    uint16_t lo, hi;
+    uint32_t g;
+
+    Ramp_Init(&r, 0, 4000, RAMP_UNITY, 400);
+    Ramp_To(&r, 0, 2000, RAMP_UNITY);
+    for (uint32_t i = 0; i < 200U; i += Ramp_Next(&r, 200U - i, &lo, &hi, &g))
+        ;
+    TEST_ASSERT_NEAR(3000, (r.high + 0x8000U) >> 16, 1, "Half way");
+
+    Ramp_To(&r, 0, 4000, RAMP_UNITY);
+    Ramp_Next(&r, 1, &lo, &hi, &g);
+    TEST_ASSERT_NEAR(3000, hi, 3, "No jump on retarget");
+    TEST_ASSERT_EQUAL(399, r.remaining, "Full length again");
+
+    r.length = 0;
+    Ramp_To(&r, 10, 20, 0);
+    TEST_ASSERT(!Ramp_Active(&r), "Length 0 steps at once");
+    TEST_ASSERT_EQUAL(20, r.to_high, "Target");
+    TEST_ASSERT_EQUAL(0, r.gate, "Gate closed");
+    return 1;
+}
+
+/**
+ * Test: gating a full-scale sine on and off has no step larger than the
+ * sine's own slope plus one chunk of ramp
+ */
+int test_click_free_gate(void)
+{
+    const uint32_t sine_slope = 14;             /* 2 pi * 1 kHz / 1 MHz * 2047.5 */
+    const uint32_t chunk_step = 4095U * RAMP_CHUNK / 1000U + 1U;
+    Ramp_t r;
+    DDS_t dds;
+
+    sine_setup(&dds);
+    dds.phase = 0x40000000U;                    /* start at the crest: worst case */
+    Ramp_Init(&r, 0, 4095, 0, 1000);
+    Ramp_To(&r, 0, 4095, RAMP_UNITY);
+    for (uint32_t i = 0; i < N; i += 512U)
+        render(&r, &dds, &out[i], 512U);
+
+    TEST_ASSERT(out[0] <= chunk_step, "Starts from closed");
+    TEST_ASSERT(max_jump(0, N) <= sine_slope + chunk_step, "Gate on: no click");
+
+    Ramp_To(&r, 0, 4095, 0);
+    for (uint32_t i = 0; i < N; i += 333U)
+        render(&r, &dds, &out[i], (N - i < 333U) ? N - i : 333U);
+    TEST_ASSERT(max_jump(0, N) <= sine_slope + chunk_step, "Gate off: no click");
+    for (uint32_t i = 1000; i < N; i++)
+        TEST_ASSERT_EQUAL(0, out[i], "Silent after the ramp");
+    return 1;
+}
+
+/**
+ * Test: pre-rendered codes are scaled by the gate
+ */
+int test_gate_codes(void)
+{
+    uint16_t codes[4] = { 0, 1000, 2048, 4095 };
+
+    Ramp_Gate(RAMP_UNITY, codes, 4);
+    TEST_ASSERT_EQUAL(4095, codes[3], "Unity");
+    Ramp_Gate(RAMP_UNITY / 2U, codes, 4);
+    TEST_ASSERT_EQUAL(0, codes[0], "Zero");
+    TEST_ASSERT_EQUAL(500, codes[1], "Half");
+    TEST_ASSERT_EQUAL(1024, codes[2], "Half");
+    TEST_ASSERT_EQUAL(2048, codes[3], "Half, rounded");
+    Ramp_Gate(0, codes, 4);
+    TEST_ASSERT_EQUAL(0, codes[3], "Closed");
+    return 1;
+}
+
+/**
+ * Test: a table rendered for one swing is moved onto another
+ */
+int test_map_codes(void)
+{
+    uint16_t codes[5] = { 1000, 1500, 2000, 3000, 900 };
+
+    Ramp_Map(1000, 3000, 1000, 3000, 4095, codes, 5);
+    TEST_ASSERT_EQUAL(1500, codes[1], "Same swing unchanged");
+    Ramp_Map(1000, 3000, 0, 1000, 4095, codes, 5);
+    TEST_ASSERT_EQUAL(0, codes[0], "Bottom");
+    TEST_ASSERT_EQUAL(250, codes[1], "Quarter");
+    TEST_ASSERT_EQUAL(1000, codes[3], "Top");
+    TEST_ASSERT_EQUAL(0, codes[4], "Below the swing clamps at 0");
+
+    codes[0] = 10; codes[1] = 4000;
+    Ramp_Map(0, 1, 0, 4095, 4095, codes, 2);
+    TEST_ASSERT_EQUAL(4095, codes[1], "Clamped at max");
+    codes[0] = 2000;
+    Ramp_Map(2000, 2000, 2100, 2100, 4095, codes, 1);
+    TEST_ASSERT_EQUAL(2100, codes[0], "Flat swing shifted");
+    return 1;
+}
+
+int main(void)
+{
+    printf("========================================\n");
+    printf("Level / Gate Ramp Unit Tests\n");
+    printf("========================================\n\n");
+
+    RUN_TEST(test_idle);
+    RUN_TEST(test_reaches_target);
+    RUN_TEST(test_retarget);
+    RUN_TEST(test_click_free_gate);
+    RUN_TEST(test_gate_codes);
+    RUN_TEST(test_map_codes);
+
+    TEST_SUMMARY();
+    return (tests_passed == tests_run) ? 0 : 1;
+}
@@ -0,0 +1,174 @@
+/**
+ * @file test_sequencer.c
+ * @brief Unit tests for the segment sequencer
+ *
+ * Build (host):
+ *   gcc -O2 -I../STM32CubeIDE/Signal_gen test_sequencer.c ../STM32CubeIDE/Signal_gen/sequencer.c \
+ *       ../STM32CubeIDE/Signal_gen/waveform.c ../STM32CubeIDE/Signal_gen/dds.c \
+ *       ../STM32CubeIDE/Signal_gen/blep.c -lm -o test_sequencer
+ */
+
+#include <stdint.h>
+#include "test_common.h"
+#include "sequencer.h"
+
+#define FS      1000000U
+#define BITS    10U
+#define N       (1U << BITS)
+
+static uint16_t table[N];
+static uint16_t out[4096], ref[4096];
+static DDS_t dds;
+
+static void setup(Sequencer_t *seq)
+{
+    for (uint32_t i = 0; i < N; i++)
+        table[i] = (uint16_t)(i * 64U);
+    DDS_Init(&dds, table, BITS, FS);
+    Seq_Init(seq, FS, NULL);
+}
+
+/* Render total samples in blocks of block */
+static void play(Sequencer_t *seq, uint32_t total, uint32_t block)
+{
+    for (uint32_t i = 0; i < total; i += block)
+        Seq_Fill(seq, &dds, &out[i], (total - i < block) ? total - i : block);
+}
+
+/**
+ * Test: DC steps land on the exact sample regardless of block size
+ */
+int test_sample_accurate(void)
+{
+    static const uint32_t blocks[] = { 1, 4, 5, 64, 512 };
+    Sequencer_t seq;
+
+    setup(&seq);
+    TEST_ASSERT(Seq_AddDC(&seq, 1000, 7), "7 us at 1000");
+    TEST_ASSERT(Seq_AddDC(&seq, 2000, 5), "5 us at 2000");
+    TEST_ASSERT(Seq_AddDC(&seq, 3000, 1), "1 us at 3000");
+    Seq_SetLoop(&seq, 1);
+    TEST_ASSERT_EQUAL(13, Seq_Period_samples(&seq), "Period");
+
+    for (unsigned b = 0; b < sizeof(blocks) / sizeof(blocks[0]); b++) {
+        Seq_Rewind(&seq, &dds);
+        play(&seq, 1024, blocks[b]);
+        for (uint32_t i = 0; i < 1024U; i++) {
+            uint32_t t = i % 13U;
+            uint16_t want = (t < 7U) ? 1000 : (t < 12U) ? 2000 : 3000;
+            TEST_ASSERT_EQUAL(want, out[i], "Segment level");
+        }
+        TEST_ASSERT_EQUAL(78 * 3 + 1, seq.stats.switches, "Switch count");   /* 1024 = 78 x 13 + 10 */
+    }
+    return 1;
+}
+
+/**
+ * Test: a segment is the free-running waveform started at phase 0
+ */
+int test_segment_matches_waveform(void)
+{
+    Sequencer_t seq;
+    WaveParams_t square = { WAVEFORM_SQUARE, 0, 100, 4000, 1 };
+    WaveParams_t sine = { WAVEFORM_SINE, 0, 0, 4095, 0 };
+    DDS_t free_run;
+
+    setup(&seq);
+    Seq_Add(&seq, &sine, 1000000U, 1000);
+    Seq_Add(&seq, &square, 5000000U, 300);
+    Seq_Rewind(&seq, &dds);
+    play(&seq, 1300, 512);
+
+    DDS_Init(&free_run, table, BITS, FS);
+    DDS_SetFrequency_mHz(&free_run, 1000000U);
+    Waveform_Fill(&free_run, &sine, ref, 1000);
+    DDS_Init(&free_run, table, BITS, FS);
+    DDS_SetFrequency_mHz(&free_run, 5000000U);
+    Waveform_Fill(&free_run, &square, ref + 1000, 300);
+
+    for (uint32_t i = 0; i < 1300U; i++)
+        TEST_ASSERT_EQUAL(ref[i], out[i], "Segment sample");
+    return 1;
+}
+
+/**
+ * Test: without loop the last sample is held and the sequence stops
+ */
+int test_one_shot_holds(void)
+{
+    Sequencer_t seq;
+    WaveParams_t ramp = { WAVEFORM_RAMP_UP, 0, 0, 4095, 0 };
+
+    setup(&seq);
+    Seq_Add(&seq, &ramp, 10000000U, 50);
+    Seq_Rewind(&seq, &dds);
+    play(&seq, 200, 64);
+
+    TEST_ASSERT(!seq.active, "Stopped");
+    for (uint32_t i = 50; i < 200U; i++)
+        TEST_ASSERT_EQUAL(out[49], out[i], "Held level");
+    return 1;
+}
+
+/**
+ * Test: empty, zero-length and overfull segment lists are refused
+ */
+int test_add_limits(void)
+{
+    Sequencer_t seq;
+
+    setup(&seq);
+    Seq_Rewind(&seq, &dds);
+    TEST_ASSERT(!seq.active, "Empty sequence is idle");
+    TEST_ASSERT(!Seq_AddDC(&seq, 0, 0), "Zero duration");
+
+    for (uint32_t i = 0; i < SEQ_MAX_SEGMENTS; i++)
+        TEST_ASSERT(Seq_AddDC(&seq, (uint16_t)i, 10), "Segment fits");
+    TEST_ASSERT(!Seq_AddDC(&seq, 0, 10), "List full");
+    TEST_ASSERT_EQUAL(SEQ_MAX_SEGMENTS * 10, Seq_Period_samples(&seq), "Period");
+    return 1;
+}
+
+/**
+ * Test: the cost fit recovers overhead and slope, and sizes the shortest segment
+ */
+int test_overhead_fit(void)
+{
+    SeqStats_t st = { 0 };
+    uint32_t overhead = 0, slope_q8 = 0;
+
+    TEST_ASSERT(!Seq_Overhead(&st, &overhead, &slope_q8), "No data");
+
+    /* 100 cycles per piece + 3 per sample */
+    for (uint32_t n = 1; n <= 512U; n += 37U) {
+        st.pieces++;
+        st.sum_n += n;
+        st.sum_c += 100U + 3U * n;
+        st.sum_nn += (uint64_t)n * n;
+        st.sum_nc += (uint64_t)n * (100U + 3U * n);
+    }
+    TEST_ASSERT(Seq_Overhead(&st, &overhead, &slope_q8), "Fit");
+    TEST_ASSERT_EQUAL(100, overhead, "Intercept");
+    TEST_ASSERT_EQUAL(3 * 256, slope_q8, "Slope");
+
+    /* Budget for 5 pieces: segments of ceil(512 / 4) samples */
+    TEST_ASSERT_EQUAL(128, Seq_MinSegment_samples(&st, 512, 512U * 3U + 500U), "Shortest segment");
+    TEST_ASSERT_EQUAL(0, Seq_MinSegment_samples(&st, 512, 512U * 3U + 150U), "No room for a cut");
+    return 1;
+}
+
+int main(void)
+{
+    printf("========================================\n");
+    printf("Segment Sequencer Unit Tests\n");
+    printf("========================================\n\n");
+
+    RUN_TEST(test_sample_accurate);
+    RUN_TEST(test_segment_matches_waveform);
+    RUN_TEST(test_one_shot_holds);
+    RUN_TEST(test_add_limits);
+    RUN_TEST(test_overhead_fit);
+
+    TEST_SUMMARY();
+    return (tests_passed == tests_run) ? 0 : 1;
+}
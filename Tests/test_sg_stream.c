@@ -0,0 +1,218 @@
+/**
+ * @file test_sg_stream.c
+ * @brief Unit tests for the ping-pong DMA streaming layer
+ *
+ * The DMA is simulated by a fake NDTR value the test moves around.
+ *
+ * Build (host):
+ *   gcc -O2 -I../STM32CubeIDE/Signal_gen test_sg_stream.c ../STM32CubeIDE/Signal_gen/sg_stream.c -o test_sg_stream
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include "test_common.h"
+#include "sg_stream.h"
+
+#define HALF    8U
+#define TOTAL   (2U * HALF)
+
+typedef struct {
+    uint16_t value;         /* what the fake renderer writes  */
+    uint16_t pending_value; /* what a commit switches it to   */
+    uint32_t ndtr;          /* fake DMA1_Stream5->NDTR        */
+    uint32_t fills;
+} FakeCtx_t;
+
+static uint16_t buffer[TOTAL];
+
+static void fake_fill(void *ctx, uint16_t *dst, uint32_t count)
+{
+    FakeCtx_t *c = (FakeCtx_t *)ctx;
+    for (uint32_t i = 0; i < count; i++)
+        dst[i] = c->value;
+    c->fills++;
+}
+
+static void fake_commit(void *ctx)
+{
+    FakeCtx_t *c = (FakeCtx_t *)ctx;
+    c->value = c->pending_value;
+}
+
+static uint32_t fake_remaining(void *ctx)
+{
+    return ((FakeCtx_t *)ctx)->ndtr;
+}
+
+static void setup(SG_Stream_t *s, FakeCtx_t *c)
+{
+    memset(c, 0, sizeof(*c));
+    memset(buffer, 0, sizeof(buffer));
+    c->value = 1;
+    SG_Stream_Init(s, buffer, HALF, fake_fill, fake_commit, fake_remaining, c);
+}
+
+/**
+ * Test: priming fills both halves before the DMA starts
+ */
+int test_prime_fills_both_halves(void)
+{
+    SG_Stream_t s;
+    FakeCtx_t c;
+
+    setup(&s, &c);
+    SG_Stream_Prime(&s);
+
+    TEST_ASSERT_EQUAL(2, c.fills, "Two halves rendered");
+    for (uint32_t i = 0; i < TOTAL; i++)
+        TEST_ASSERT_EQUAL(1, buffer[i], "Whole buffer primed");
+    return 1;
+}
+
+/**
+ * Test: half-transfer refills half 0 only, complete refills half 1 only
+ */
+int test_half_callbacks_touch_own_half(void)
+{
+    SG_Stream_t s;
+    FakeCtx_t c;
+
+    setup(&s, &c);
+    SG_Stream_Prime(&s);
+    c.value = 2;
+
+    c.ndtr = HALF;                  /* DMA at start of half 1 */
+    SG_Stream_OnHalfDone(&s, 0);
+    TEST_ASSERT_EQUAL(2, buffer[0], "Half 0 refilled");
+    TEST_ASSERT_EQUAL(1, buffer[HALF], "Half 1 untouched while playing");
+
+    c.value = 3;
+    c.ndtr = TOTAL;                 /* DMA wrapped to half 0 */
+    SG_Stream_OnHalfDone(&s, 1);
+    TEST_ASSERT_EQUAL(2, buffer[0], "Half 0 untouched while playing");
+    TEST_ASSERT_EQUAL(3, buffer[HALF], "Half 1 refilled");
+    TEST_ASSERT_EQUAL(0, s.late_refills, "No late refills");
+    return 1;
+}
+
+/**
+ * Test: an update is applied only at the next boundary, never mid-block
+ */
+int test_commit_only_at_boundary(void)
+{
+    SG_Stream_t s;
+    FakeCtx_t c;
+
+    setup(&s, &c);
+    SG_Stream_Prime(&s);
+
+    SG_Stream_BeginUpdate(&s);
+    c.pending_value = 7;
+    /* Boundary while the update is still being written: must not commit */
+    c.ndtr = HALF;
+    SG_Stream_OnHalfDone(&s, 0);
+    TEST_ASSERT_EQUAL(0, s.commits, "No commit during BeginUpdate");
+    TEST_ASSERT_EQUAL(1, buffer[0], "Old data while update in progress");
+
+    SG_Stream_EndUpdate(&s);
+    TEST_ASSERT_EQUAL(1, buffer[HALF], "Nothing applied outside the ISR");
+
+    c.ndtr = TOTAL;
+    SG_Stream_OnHalfDone(&s, 1);
+    TEST_ASSERT_EQUAL(1, s.commits, "Committed at the boundary");
+    for (uint32_t i = HALF; i < TOTAL; i++)
+        TEST_ASSERT_EQUAL(7, buffer[i], "Whole block uses the new data");
+    TEST_ASSERT_EQUAL(1, buffer[0], "Playing half never rewritten");
+    return 1;
+}
+
+/**
+ * Test: finishing after the DMA entered the refilled half counts as late
+ */
+int test_late_refill_by_position(void)
+{
+    SG_Stream_t s;
+    FakeCtx_t c;
+
+    setup(&s, &c);
+    SG_Stream_Prime(&s);
+
+    c.ndtr = TOTAL - 1;             /* DMA already back in half 0 */
+    SG_Stream_OnHalfDone(&s, 0);
+    TEST_ASSERT_EQUAL(1, s.late_refills, "Late refill detected");
+
+    c.ndtr = 1;                     /* DMA still in half 1 while refilling 1 */
+    SG_Stream_OnHalfDone(&s, 1);
+    TEST_ASSERT_EQUAL(2, s.late_refills, "Late refill detected on half 1");
+    return 1;
+}
+
+/**
+ * Test: a skipped callback counts as late
+ */
+int test_late_refill_by_missed_callback(void)
+{
+    SG_Stream_t s;
+    FakeCtx_t c;
+
+    setup(&s, &c);
+    SG_Stream_Prime(&s);
+
+    c.ndtr = HALF;
+    SG_Stream_OnHalfDone(&s, 0);
+    c.ndtr = HALF;
+    SG_Stream_OnHalfDone(&s, 0);    /* transfer-complete was missed */
+    TEST_ASSERT_EQUAL(1, s.late_refills, "Missed callback detected");
+    TEST_ASSERT_EQUAL(2, s.blocks, "Blocks counted");
+    return 1;
+}
+
+/**
+ * Test: rendered-ahead run follows the DMA and the pending callback
+ */
+int test_ahead_of_dma(void)
+{
+    SG_Stream_t s;
+    FakeCtx_t c;
+    uint32_t index = 99;
+
+    setup(&s, &c);
+    SG_Stream_Prime(&s);
+
+    c.ndtr = TOTAL;                 /* both halves primed, DMA at 0 */
+    TEST_ASSERT_EQUAL(0, SG_Stream_Position(&s), "Position at start");
+    TEST_ASSERT_EQUAL(TOTAL - 2, SG_Stream_Ahead(&s, 2, &index), "All but the guard");
+    TEST_ASSERT_EQUAL(2, index, "After the guard");
+
+    c.ndtr = 5;                     /* DMA at 11, half-0 callback pending */
+    TEST_ASSERT_EQUAL(3, SG_Stream_Ahead(&s, 2, &index), "Only the tail of half 1");
+    TEST_ASSERT_EQUAL(13, index, "Index in half 1");
+
+    SG_Stream_OnHalfDone(&s, 0);
+    TEST_ASSERT_EQUAL(3 + HALF, SG_Stream_Ahead(&s, 2, &index), "Refilled half 0 counts");
+    TEST_ASSERT_EQUAL(13, index, "Run wraps through half 0");
+
+    c.ndtr = 1;                     /* DMA at 15: 1 + HALF samples left */
+    TEST_ASSERT_EQUAL(0, SG_Stream_Ahead(&s, 1 + HALF, &index), "Nothing beyond the guard");
+
+    s.remaining = NULL;
+    TEST_ASSERT_EQUAL(0, SG_Stream_Ahead(&s, 0, &index), "No position callback");
+    return 1;
+}
+
+int main(void)
+{
+    printf("========================================\n");
+    printf("Ping-pong Stream Unit Tests\n");
+    printf("========================================\n\n");
+
+    RUN_TEST(test_prime_fills_both_halves);
+    RUN_TEST(test_half_callbacks_touch_own_half);
+    RUN_TEST(test_commit_only_at_boundary);
+    RUN_TEST(test_late_refill_by_position);
+    RUN_TEST(test_late_refill_by_missed_callback);
+    RUN_TEST(test_ahead_of_dma);
+
+    TEST_SUMMARY();
+    return (tests_passed == tests_run) ? 0 : 1;
+}
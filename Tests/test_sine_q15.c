@@ -0,0 +1,125 @@
+/**
+ * @file test_sine_q15.c
+ * @brief Unit tests for the quarter-wave Q15 sine table generator
+ *
+ * Build (host):
+ *   gcc -O2 -I../STM32CubeIDE/Signal_gen test_sine_q15.c ../STM32CubeIDE/Signal_gen/sine_q15.c -lm -o test_sine_q15
+ */
+
+#include <stdint.h>
+#include <math.h>
+#include "test_common.h"
+#include "sine_q15.h"
+
+#define MAX_BITS 14
+
+static int16_t period[1U << MAX_BITS];
+static uint16_t dac[1U << MAX_BITS];
+
+/* Reference: round half away from zero of 32767 * sin(2*pi*i/N) in double */
+static int16_t ref_q15(uint32_t i, uint32_t n)
+{
+    return (int16_t)lround(32767.0 * sin(2.0 * 3.14159265358979323846 * (double)i / (double)n));
+}
+
+/* The float path Generete_SineTable() used before the Q15 generator */
+static uint16_t ref_float_dac(uint32_t i, uint32_t n, int touch_value)
+{
+    float max_dac_val = (touch_value * 4095.0f) / 33.0f;
+    float value = (sinf((2.0f * 3.14159265358979323846f * i) / n) + 1.0f) * max_dac_val / 2.0f;
+
+    if (value < 0.0f) value = 0.0f;
+    if (value > max_dac_val) value = max_dac_val;
+    return (uint16_t)value;
+}
+
+/**
+ * Test: stored quarter wave has the expected end points
+ */
+int test_quarter_endpoints(void)
+{
+    TEST_ASSERT_EQUAL(0, sine_q15_quarter[0], "sin(0)");
+    TEST_ASSERT_EQUAL(32767, sine_q15_quarter[SINE_Q15_QUARTER_LEN], "sin(pi/2)");
+    TEST_ASSERT_EQUAL(23170, sine_q15_quarter[SINE_Q15_QUARTER_LEN / 2], "sin(pi/4)");
+    return 1;
+}
+
+/**
+ * Test: every power-of-two length up to 4096 is bit-exact with the reference
+ */
+int test_period_bit_exact(void)
+{
+    for (uint32_t bits = SINE_Q15_MIN_BITS; bits <= SINE_Q15_EXACT_BITS; bits++) {
+        uint32_t n = 1U << bits;
+
+        SineQ15_BuildPeriod(period, bits);
+        for (uint32_t i = 0; i < n; i++) {
+            if (period[i] != ref_q15(i, n)) {
+                printf("  N=%u i=%u: %d != %d\n", n, i, period[i], ref_q15(i, n));
+                TEST_ASSERT(0, "Bit-exact period");
+            }
+        }
+    }
+    return 1;
+}
+
+/**
+ * Test: interpolated lengths stay within 1 LSB
+ */
+int test_period_interpolated(void)
+{
+    for (uint32_t bits = SINE_Q15_EXACT_BITS + 1; bits <= MAX_BITS; bits++) {
+        uint32_t n = 1U << bits;
+
+        SineQ15_BuildPeriod(period, bits);
+        for (uint32_t i = 0; i < n; i++)
+            TEST_ASSERT_NEAR(ref_q15(i, n), period[i], 1, "Interpolated period");
+    }
+    return 1;
+}
+
+/**
+ * Test: DAC table matches the old float path within 1 LSB for every slider step
+ */
+int test_dac_matches_float_path(void)
+{
+    const uint32_t bits = 10, n = 1U << bits;
+
+    for (int touch = 0; touch <= 33; touch++) {
+        uint32_t max_dac = ((uint32_t)touch * 4095U + 16U) / 33U;
+
+        SineQ15_BuildDac(dac, bits, max_dac);
+        for (uint32_t i = 0; i < n; i++)
+            TEST_ASSERT_NEAR(ref_float_dac(i, n, touch), dac[i], 1, "Q15 vs float path");
+    }
+    return 1;
+}
+
+/**
+ * Test: full scale hits exactly 0 and 4095
+ */
+int test_dac_full_scale(void)
+{
+    SineQ15_BuildDac(dac, 12, 4095);
+
+    TEST_ASSERT_EQUAL(4095, dac[1024], "Peak");
+    TEST_ASSERT_EQUAL(0, dac[3072], "Trough");
+    TEST_ASSERT_EQUAL(dac[0], dac[2048], "Zero crossings equal");
+    return 1;
+}
+
+int main(void)
+{
+    printf("========================================\n");
+    printf("Q15 Sine Table Unit Tests\n");
+    printf("========================================\n\n");
+
+    RUN_TEST(test_quarter_endpoints);
+    RUN_TEST(test_period_bit_exact);
+    RUN_TEST(test_period_interpolated);
+    RUN_TEST(test_dac_matches_float_path);
+    RUN_TEST(test_dac_full_scale);
+
+    TEST_SUMMARY();
+    return (tests_passed == tests_run) ? 0 : 1;
+}
@@ -0,0 +1,167 @@
+/**
+ * @file test_sweep.c
+ * @brief Unit tests for the linear/log frequency sweep
+ *
+ * Build (host):
+ *   gcc -O2 -I../STM32CubeIDE/Signal_gen test_sweep.c ../STM32CubeIDE/Signal_gen/sweep.c \
+ *       ../STM32CubeIDE/Signal_gen/waveform.c ../STM32CubeIDE/Signal_gen/blep.c \
+ *       ../STM32CubeIDE/Signal_gen/dds.c -lm -o test_sweep
+ */
+
+#include <stdint.h>
+#include <math.h>
+#include "test_common.h"
+#include "sweep.h"
+#include "waveform.h"
+
+#define FS_HZ   1000000U
+#define BLOCK   512U
+
+/**
+ * Test: linear sweep hits start and stop exactly with equal steps
+ */
+int test_linear_endpoints(void)
+{
+    Sweep_t sw;
+    uint32_t prev = 0, first, t = 0;
+    int64_t step = 0;
+
+    TEST_ASSERT(Sweep_Setup(&sw, FS_HZ, BLOCK, 100000U, 10000000U, 1024U, SWEEP_LINEAR, 0), "Setup");
+    TEST_ASSERT_EQUAL(2000, sw.blocks, "1.024 s of 512 us blocks");
+
+    first = Sweep_Next(&sw);
+    TEST_ASSERT_EQUAL(DDS_TuningWord_mHz(FS_HZ, 100000U), first, "First block at start");
+    prev = first;
+    for (uint32_t k = 1; k < sw.blocks; k++) {
+        t = Sweep_Next(&sw);
+        if (k == 1) step = (int64_t)t - prev;
+        TEST_ASSERT(t > prev, "Strictly rising");
+        if (k + 1U < sw.blocks)
+            TEST_ASSERT_NEAR(step, (int64_t)t - prev, 1, "Equal steps");
+        prev = t;
+    }
+    TEST_ASSERT_EQUAL(DDS_TuningWord_mHz(FS_HZ, 10000000U), t, "Last block at stop");
+    TEST_ASSERT(!sw.active, "One-shot sweep ends");
+    TEST_ASSERT_EQUAL(t, Sweep_Next(&sw), "Holds stop afterwards");
+    TEST_ASSERT_EQUAL(1000, Sweep_Position_permille(&sw), "Position at the end");
+    return 1;
+}
+
+/**
+ * Test: log sweep keeps a constant ratio per block, both directions
+ */
+int test_log_ratio(void)
+{
+    static const uint32_t ends[2][2] = { { 20000U, 20000000U }, { 20000000U, 20000U } };
+
+    for (int d = 0; d < 2; d++) {
+        Sweep_t sw;
+        uint32_t prev, t = 0;
+        double ideal;
+
+        TEST_ASSERT(Sweep_Setup(&sw, FS_HZ, BLOCK, ends[d][0], ends[d][1], 2000U, SWEEP_LOG, 0), "Setup");
+        ideal = pow((double)sw.stop_tuning / sw.start_tuning, 1.0 / (sw.blocks - 1U));
+        prev = Sweep_Next(&sw);
+        for (uint32_t k = 1; k < sw.blocks; k++) {
+            t = Sweep_Next(&sw);
+            /* Tuning words are truncated to integers: one LSB on each end.
+             * The last block is snapped to stop, which absorbs the drift. */
+            if (k + 1U < sw.blocks)
+                TEST_ASSERT(fabs((double)t / prev - ideal) <= 2.0 / (double)(prev < t ? prev : t), "Constant ratio");
+            else
+                TEST_ASSERT(fabs((double)t / prev - ideal) <= 1e-6, "Drift before the stop snap");
+            prev = t;
+        }
+        TEST_ASSERT_EQUAL(DDS_TuningWord_mHz(FS_HZ, ends[d][1]), t, "Last block at stop");
+    }
+    return 1;
+}
+
+/**
+ * Test: the midpoint of a log sweep is the geometric mean
+ */
+int test_log_midpoint(void)
+{
+    Sweep_t sw;
+    uint32_t mid = 0;
+
+    Sweep_Setup(&sw, FS_HZ, BLOCK, 100000U, 10000000U, 1025U, SWEEP_LOG, 0);   /* 2001 blocks */
+    for (uint32_t k = 0; k <= sw.blocks / 2; k++)
+        mid = Sweep_Next(&sw);
+    TEST_ASSERT_NEAR(DDS_TuningWord_mHz(FS_HZ, 1000000U), mid, 8, "1 kHz halfway from 100 Hz to 10 kHz");
+    return 1;
+}
+
+/**
+ * Test: repeat restarts at start, bad log endpoints are rejected
+ */
+int test_repeat_and_reject(void)
+{
+    Sweep_t sw;
+    uint32_t start = DDS_TuningWord_mHz(FS_HZ, 1000000U);
+
+    Sweep_Setup(&sw, FS_HZ, BLOCK, 1000000U, 2000000U, 10U, SWEEP_LINEAR, 1);
+    for (uint32_t k = 0; k < sw.blocks; k++)
+        Sweep_Next(&sw);
+    TEST_ASSERT(sw.active, "Repeating sweep stays active");
+    TEST_ASSERT_EQUAL(start, Sweep_Next(&sw), "Wraps to start");
+
+    TEST_ASSERT(!Sweep_Setup(&sw, FS_HZ, BLOCK, 0U, 2000000U, 10U, SWEEP_LOG, 0), "Log from 0 Hz rejected");
+    TEST_ASSERT(!sw.active, "Rejected sweep inactive");
+    return 1;
+}
+
+/**
+ * Test: per-block retuning never disturbs the phase accumulator
+ */
+int test_phase_continuity(void)
+{
+    static uint16_t out[BLOCK];
+    static uint16_t dummy_table[4];
+    static const SweepMode_t modes[] = { SWEEP_LINEAR, SWEEP_LOG };
+    WaveParams_t p = { WAVEFORM_RAMP_UP, 0, 0, 65535, 0 };
+
+    for (unsigned m = 0; m < 2; m++) {
+        Sweep_t sw;
+        DDS_t dds;
+        uint32_t expect = 0, prev_tuning = 0;
+        int have_prev = 0;
+        uint16_t last = 0;
+
+        DDS_Init(&dds, dummy_table, 2, FS_HZ);
+        Sweep_Setup(&sw, FS_HZ, BLOCK, 1000000U, 50000000U, 200U, modes[m], 0);
+
+        while (sw.active) {
+            dds.tuning_word = Sweep_Next(&sw);
+            Waveform_Fill(&dds, &p, out, BLOCK);
+            expect += dds.tuning_word * BLOCK;
+            TEST_ASSERT_EQUAL(expect, dds.phase, "Phase is the running sum of increments");
+
+            /* The first sample of a block continues the previous block's ramp */
+            if (have_prev) {
+                uint16_t step = (uint16_t)(out[0] - last);
+                TEST_ASSERT_NEAR(prev_tuning >> 16, step, 2, "No phase jump at block edge");
+            }
+            last = out[BLOCK - 1];
+            prev_tuning = dds.tuning_word;
+            have_prev = 1;
+        }
+    }
+    return 1;
+}
+
+int main(void)
+{
+    printf("========================================\n");
+    printf("Frequency Sweep Unit Tests\n");
+    printf("========================================\n\n");
+
+    RUN_TEST(test_linear_endpoints);
+    RUN_TEST(test_log_ratio);
+    RUN_TEST(test_log_midpoint);
+    RUN_TEST(test_repeat_and_reject);
+    RUN_TEST(test_phase_continuity);
+
+    TEST_SUMMARY();
+    return (tests_passed == tests_run) ? 0 : 1;
+}
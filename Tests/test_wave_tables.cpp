@@ -0,0 +1,131 @@
+/**
+ * @file test_wave_tables.cpp
+ * @brief Unit tests for the compile-time master tables
+ *
+ * Build (host):
+ *   g++ -std=c++11 -O2 -I../STM32CubeIDE/Signal_gen test_wave_tables.cpp \
+ *       ../STM32CubeIDE/Signal_gen/wave_tables.cpp ../STM32CubeIDE/Signal_gen/sine_q15.c \
+ *       ../STM32CubeIDE/Signal_gen/dds.c -o test_wave_tables
+ */
+
+#include <stdint.h>
+#include <math.h>
+#include "test_common.h"
+#include "wave_tables.h"
+#include "wave_tables.hpp"
+#include "sine_q15.h"
+#include "dds.h"
+
+static int16_t q15[1U << 12];
+static uint16_t norm[WAVE_TABLE_LEN];
+static uint16_t dac_a[WAVE_TABLE_LEN];
+static uint16_t dac_b[WAVE_TABLE_LEN];
+
+static int16_t ref_q15(double v)
+{
+    return (int16_t)lround(32767.0 * v);
+}
+
+template<class Table>
+static int matches_sine_q15(uint32_t bits)
+{
+    SineQ15_BuildPeriod(q15, bits);
+    for (uint32_t i = 0; i < Table::size; i++)
+        if (Table::data[i] != q15[i])
+            return 0;
+    return 1;
+}
+
+/**
+ * Test: C entry point hands out the flash table, bit-exact with the Q15 generator
+ */
+int test_sine_matches_q15_generator(void)
+{
+    const int16_t *sine = WaveTable_Get(WAVE_SINE);
+
+    SineQ15_BuildPeriod(q15, WAVE_TABLE_BITS);
+    for (uint32_t i = 0; i < WAVE_TABLE_LEN; i++)
+        TEST_ASSERT_EQUAL(q15[i], sine[i], "Sine sample");
+    return 1;
+}
+
+/**
+ * Test: other power-of-two lengths instantiate and stay bit-exact
+ */
+int test_sine_other_lengths(void)
+{
+    typedef wave::table<16, wave::sine> T16;
+    typedef wave::table<256, wave::sine> T256;
+    typedef wave::table<4096, wave::sine> T4096;
+
+    TEST_ASSERT(matches_sine_q15<T16>(4), "N=16");
+    TEST_ASSERT(matches_sine_q15<T256>(8), "N=256");
+    TEST_ASSERT(matches_sine_q15<T4096>(12), "N=4096");
+    return 1;
+}
+
+/**
+ * Test: non power-of-two length follows the double reference
+ */
+int test_sine_any_length(void)
+{
+    typedef wave::table<100, wave::sine> T;
+
+    for (uint32_t i = 0; i < T::size; i++)
+        TEST_ASSERT_EQUAL(ref_q15(sin(2.0 * M_PI * i / 100.0)), T::data[i], "N=100 sine");
+    return 1;
+}
+
+/**
+ * Test: triangle and saw shapes (header-only, not instantiated on target)
+ */
+int test_triangle_and_saw(void)
+{
+    const int16_t *tri = wave::table<WAVE_TABLE_LEN, wave::triangle>::data;
+    const int16_t *saw = wave::table<WAVE_TABLE_LEN, wave::saw>::data;
+    const double n = WAVE_TABLE_LEN;
+
+    for (uint32_t i = 0; i < WAVE_TABLE_LEN; i++) {
+        double u = i / n;
+        double t = (u < 0.25) ? 4.0 * u : (u < 0.75) ? 2.0 - 4.0 * u : 4.0 * u - 4.0;
+        double s = (u < 0.5) ? 2.0 * u : 2.0 * u - 2.0;
+        TEST_ASSERT_EQUAL(ref_q15(t), tri[i], "Triangle sample");
+        TEST_ASSERT_EQUAL(ref_q15(s), saw[i], "Saw sample");
+    }
+    return 1;
+}
+
+/**
+ * Test: the normalized table scaled on the fly equals the direct Q15 DAC builder
+ */
+int test_scale_matches_dac_builder(void)
+{
+    DDS_t dds;
+
+    WaveTable_OffsetBinary(norm, WaveTable_Get(WAVE_SINE), WAVE_TABLE_LEN);
+    for (uint32_t max_dac = 0; max_dac <= 4095; max_dac += 117) {
+        DDS_Init(&dds, norm, WAVE_TABLE_BITS, 1000000U);
+        dds.tuning_word = 1U << (32U - WAVE_TABLE_BITS);       /* one entry per sample */
+        DDS_FillScaled(&dds, 0, (uint16_t)max_dac, dac_a, WAVE_TABLE_LEN);
+        SineQ15_BuildDac(dac_b, WAVE_TABLE_BITS, max_dac);
+        for (uint32_t i = 0; i < WAVE_TABLE_LEN; i++)
+            TEST_ASSERT_EQUAL(dac_b[i], dac_a[i], "Scaled sample");
+    }
+    return 1;
+}
+
+int main(void)
+{
+    printf("========================================\n");
+    printf("Compile-time Wave Table Unit Tests\n");
+    printf("========================================\n\n");
+
+    RUN_TEST(test_sine_matches_q15_generator);
+    RUN_TEST(test_sine_other_lengths);
+    RUN_TEST(test_sine_any_length);
+    RUN_TEST(test_triangle_and_saw);
+    RUN_TEST(test_scale_matches_dac_builder);
+
+    TEST_SUMMARY();
+    return (tests_passed == tests_run) ? 0 : 1;
+}
@@ -0,0 +1,160 @@
+/**
+ * @file test_waveform.c
+ * @brief Unit tests for the per-waveform block kernels
+ *
+ * Build (host):
+ *   gcc -O2 -I../STM32CubeIDE/Signal_gen test_waveform.c ../STM32CubeIDE/Signal_gen/waveform.c \
+ *       ../STM32CubeIDE/Signal_gen/blep.c ../STM32CubeIDE/Signal_gen/dds.c -o test_waveform
+ */
+
+#include <stdint.h>
+#include "test_common.h"
+#include "waveform.h"
+
+#define N       1024U           /* samples per period in these tests */
+#define FS_HZ   1000000U
+
+static uint16_t out[N];
+static uint16_t dummy_table[4];
+
+static void setup(DDS_t *dds)
+{
+    DDS_Init(dds, dummy_table, 2, FS_HZ);
+    dds->tuning_word = 0xFFFFFFFFU / N + 1U;    /* exactly N samples per period */
+}
+
+static void fill(Waveform_t form, uint32_t duty, uint16_t low, uint16_t high)
+{
+    DDS_t dds;
+    WaveParams_t p;
+
+    setup(&dds);
+    p.form = form;
+    p.duty = duty;
+    p.low = low;
+    p.high = high;
+    p.band_limited = 0;
+    Waveform_Fill(&dds, &p, out, N);
+}
+
+/**
+ * Test: square is high for the first half, low for the second
+ */
+int test_square(void)
+{
+    fill(WAVEFORM_SQUARE, 0, 100, 4000);
+
+    for (uint32_t i = 0; i < N; i++)
+        TEST_ASSERT_EQUAL((i < N / 2) ? 4000 : 100, out[i], "Square level");
+    return 1;
+}
+
+/**
+ * Test: pulse duty sets the number of high samples
+ */
+int test_pulse_duty(void)
+{
+    static const uint32_t permille[] = { 0, 100, 250, 500, 900, 1000 };
+
+    for (unsigned k = 0; k < sizeof(permille) / sizeof(permille[0]); k++) {
+        uint32_t highs = 0;
+
+        fill(WAVEFORM_PULSE, Waveform_DutyFromPermille(permille[k]), 0, 4095);
+        for (uint32_t i = 0; i < N; i++)
+            highs += (out[i] == 4095);
+        TEST_ASSERT_NEAR(permille[k] * N / 1000U, highs, 1, "High samples for duty");
+    }
+    return 1;
+}
+
+/**
+ * Test: triangle starts mid-level, peaks at N/4, bottoms at 3N/4
+ */
+int test_triangle(void)
+{
+    fill(WAVEFORM_TRIANGLE, 0, 0, 4095);
+
+    TEST_ASSERT_NEAR(2048, out[0], 1, "Mid-level at phase 0");
+    TEST_ASSERT_EQUAL(4095, out[N / 4], "Peak at N/4");
+    TEST_ASSERT_NEAR(2048, out[N / 2], 1, "Mid-level at N/2");
+    TEST_ASSERT_EQUAL(0, out[3 * N / 4], "Trough at 3N/4");
+    for (uint32_t i = 1; i <= N / 4; i++)
+        TEST_ASSERT(out[i] >= out[i - 1], "Rising edge monotonic");
+    for (uint32_t i = N / 4 + 1; i <= 3 * N / 4; i++)
+        TEST_ASSERT(out[i] <= out[i - 1], "Falling edge monotonic");
+    return 1;
+}
+
+/**
+ * Test: ramps are monotonic apart from the single reset step
+ */
+int test_ramps(void)
+{
+    uint32_t resets = 0;
+
+    fill(WAVEFORM_RAMP_UP, 0, 0, 4095);
+    TEST_ASSERT_NEAR(2048, out[0], 1, "Ramp up starts mid-level");
+    for (uint32_t i = 1; i < N; i++)
+        resets += (out[i] < out[i - 1]);
+    TEST_ASSERT_EQUAL(1, resets, "Ramp up resets once per period");
+
+    resets = 0;
+    fill(WAVEFORM_RAMP_DOWN, 0, 0, 4095);
+    TEST_ASSERT_NEAR(2047, out[0], 1, "Ramp down starts mid-level");
+    for (uint32_t i = 1; i < N; i++)
+        resets += (out[i] > out[i - 1]);
+    TEST_ASSERT_EQUAL(1, resets, "Ramp down resets once per period");
+    return 1;
+}
+
+/**
+ * Test: every shaped kernel stays inside [low, high]
+ */
+int test_levels_respected(void)
+{
+    for (int f = WAVEFORM_SQUARE; f < WAVEFORM_COUNT; f++) {
+        fill((Waveform_t)f, Waveform_DutyFromPermille(300), 1000, 1500);
+        for (uint32_t i = 0; i < N; i++)
+            TEST_ASSERT(out[i] >= 1000 && out[i] <= 1500, "Sample inside swing");
+    }
+    return 1;
+}
+
+/**
+ * Test: phase is carried between blocks for all kernels
+ */
+int test_block_continuity(void)
+{
+    static uint16_t whole[N];
+    DDS_t a, b;
+    WaveParams_t p = { WAVEFORM_TRIANGLE, 0, 0, 4095, 0 };
+
+    for (int f = WAVEFORM_SQUARE; f < WAVEFORM_COUNT; f++) {
+        p.form = (Waveform_t)f;
+        setup(&a);
+        setup(&b);
+        Waveform_Fill(&a, &p, whole, N);
+        Waveform_Fill(&b, &p, out, 333);
+        Waveform_Fill(&b, &p, out + 333, N - 333);
+        for (uint32_t i = 0; i < N; i++)
+            TEST_ASSERT_EQUAL(whole[i], out[i], "Split block equals whole block");
+    }
+    return 1;
+}
+
+int main(void)
+{
+    printf("========================================\n");
+    printf("Waveform Kernel Unit Tests\n");
+    printf("========================================\n\n");
+
+    RUN_TEST(test_square);
+    RUN_TEST(test_pulse_duty);
+    RUN_TEST(test_triangle);
+    RUN_TEST(test_ramps);
+    RUN_TEST(test_levels_respected);
+    RUN_TEST(test_block_continuity);
+
+    TEST_SUMMARY();
+    return (tests_passed == tests_run) ? 0 : 1;
+}
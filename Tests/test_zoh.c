@@ -0,0 +1,157 @@
+/**
+ * @file test_zoh.c
+ * @brief Unit tests for the zero-order-hold droop compensation
+ *
+ * The held DAC output of a sampled tone at f has the amplitude of the
+ * sample sequence times sinc(f / fs); the tests rebuild that response
+ * from rendered blocks and check it against the programmed level.
+ *
+ * Build (host):
+ *   gcc -O2 -I../STM32CubeIDE/Signal_gen test_zoh.c ../STM32CubeIDE/Signal_gen/zoh.c \
+ *       ../STM32CubeIDE/Signal_gen/harmonics.c ../STM32CubeIDE/Signal_gen/dsp_kernels.c \
+ *       ../STM32CubeIDE/Signal_gen/dds.c -lm -o test_zoh
+ */
+
+#include <stdint.h>
+#include <math.h>
+#include "test_common.h"
+#include "zoh.h"
+#include "dds.h"
+
+#define FS      1000000U
+#define N       4096U
+#define BITS    12U
+#define PI      3.14159265358979323846
+
+static uint16_t table[1U << BITS];
+static uint16_t out[N];
+
+static double sinc(double x)
+{
+    return (x == 0.0) ? 1.0 : sin(PI * x) / (PI * x);
+}
+
+/* Amplitude of bin k in the sample sequence */
+static double tone_amplitude(uint32_t k)
+{
+    double re = 0.0, im = 0.0;
+
+    for (uint32_t i = 0; i < N; i++) {
+        re += out[i] * cos(2.0 * PI * k * i / N);
+        im -= out[i] * sin(2.0 * PI * k * i / N);
+    }
+    return 2.0 * sqrt(re * re + im * im) / N;
+}
+
+/* Held amplitude of a sine on bin k with swing [low, high], compensated or not */
+static double held_amplitude(uint32_t k, uint16_t low, uint16_t high, int compensate)
+{
+    DDS_t dds;
+
+    DDS_Init(&dds, table, BITS, FS);
+    dds.tuning_word = (uint32_t)(((uint64_t)k << 32) / N);
+    if (compensate)
+        Zoh_ScaleSwing(&low, &high, Zoh_Gain_q16(dds.tuning_word), 4095);
+    DDS_FillScaled(&dds, low, high, out, N);
+    return tone_amplitude(k) * sinc((double)k / N);
+}
+
+/**
+ * Test: table gain follows 1 / sinc up to Nyquist
+ */
+int test_gain_curve(void)
+{
+    for (uint64_t tw = 0; tw <= 0x80000000ULL; tw += 0x00F00000ULL) {
+        double ideal = 1.0 / sinc((double)tw / 4294967296.0);
+        double got = Zoh_Gain_q16((uint32_t)tw) / 65536.0;
+
+        TEST_ASSERT(fabs(got / ideal - 1.0) < 1e-4, "Gain within 0.01 %");
+    }
+    TEST_ASSERT_EQUAL(65536, Zoh_Gain_q16(0), "Unity at DC");
+    TEST_ASSERT_EQUAL(102944, Zoh_Gain_q16(0x80000000U), "pi / 2 at Nyquist");
+    TEST_ASSERT_EQUAL(102944, Zoh_Gain_q16(0xC0000000U), "Clamped above Nyquist");
+    return 1;
+}
+
+/**
+ * Test: the swing widens around its middle and clips at the rails
+ */
+int test_scale_swing(void)
+{
+    uint16_t lo = 1000, hi = 3000;
+
+    Zoh_ScaleSwing(&lo, &hi, 65536U, 4095);
+    TEST_ASSERT_EQUAL(1000, lo, "Unity low");
+    TEST_ASSERT_EQUAL(3000, hi, "Unity high");
+
+    Zoh_ScaleSwing(&lo, &hi, 98304U, 4095);     /* x1.5 */
+    TEST_ASSERT_EQUAL(500, lo, "Widened low");
+    TEST_ASSERT_EQUAL(3500, hi, "Widened high");
+
+    lo = 0; hi = 4095;
+    Zoh_ScaleSwing(&lo, &hi, 80000U, 4095);
+    TEST_ASSERT_EQUAL(0, lo, "Clipped low");
+    TEST_ASSERT_EQUAL(4095, hi, "Clipped high");
+    return 1;
+}
+
+/**
+ * Test: held amplitude matches the programmed swing across the band
+ */
+int test_corrected_response(void)
+{
+    static const uint32_t bins[] = { 41, 410, 1024, 1638 };     /* 10, 100, 250, 400 kHz */
+
+    for (uint32_t i = 0; i < (1U << BITS); i++)
+        table[i] = (uint16_t)lround(32767.5 + 32767.5 * sin(2.0 * PI * i / (1U << BITS)));
+
+    for (unsigned b = 0; b < sizeof(bins) / sizeof(bins[0]); b++) {
+        double want = 1200.0 / 2.0;
+        double raw = held_amplitude(bins[b], 1400, 2600, 0);
+        double cal = held_amplitude(bins[b], 1400, 2600, 1);
+
+        printf("    %6.1f kHz: uncompensated %.2f dB, compensated %+.3f dB\n",
+               bins[b] * (double)FS / N / 1000.0, 20.0 * log10(raw / want), 20.0 * log10(cal / want));
+        TEST_ASSERT(fabs(cal / want - 1.0) < 0.003, "Held amplitude within 0.3 %");
+    }
+    TEST_ASSERT(held_amplitude(1638, 1400, 2600, 0) < 0.8 * 600.0, "Droop is real at 400 kHz");
+    return 1;
+}
+
+/**
+ * Test: harmonics are lifted relative to the fundamental by the droop ratio
+ */
+int test_harmonic_gains(void)
+{
+    const uint32_t tw = 0x04000000U;        /* fs / 64: 15.6 kHz */
+    Harmonics_t in, outh;
+
+    Harmonics_Clear(&in);
+    Harmonics_Set(&in, 1, 20000, 0);
+    Harmonics_Set(&in, 3, -10000, 0);
+    Harmonics_Set(&in, 15, 4000, 0);
+    Harmonics_Set(&in, 32, 32000, 0);       /* at Nyquist: boosted, saturates */
+
+    Zoh_Harmonics(&in, &outh, tw);
+    TEST_ASSERT_EQUAL(20000, outh.amp_q15[0], "Fundamental untouched");
+    TEST_ASSERT_NEAR(lround(-10000 * sinc(1.0 / 64) / sinc(3.0 / 64)), outh.amp_q15[2], 1, "3rd");
+    TEST_ASSERT_NEAR(lround(4000 * sinc(1.0 / 64) / sinc(15.0 / 64)), outh.amp_q15[14], 1, "15th");
+    TEST_ASSERT_EQUAL(32767, outh.amp_q15[31], "Saturated");
+    TEST_ASSERT_EQUAL(in.count, outh.count, "Count kept");
+    return 1;
+}
+
+int main(void)
+{
+    printf("========================================\n");
+    printf("ZOH Compensation Unit Tests\n");
+    printf("========================================\n\n");
+
+    RUN_TEST(test_gain_curve);
+    RUN_TEST(test_scale_swing);
+    RUN_TEST(test_corrected_response);
+    RUN_TEST(test_harmonic_gains);
+
+    TEST_SUMMARY();
+    return (tests_passed == tests_run) ? 0 : 1;
+}
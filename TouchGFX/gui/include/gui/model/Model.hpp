@@ -1,6 +1,8 @@
 #ifndef MODEL_HPP
 #define MODEL_HPP
 
+#include <stdint.h>
+
 class ModelListener;
 
 class Model
@@ -16,6 +18,10 @@ public:
     void tick();
 protected:
     ModelListener* modelListener;
+
+    // Позиція свіпу, яку вже показали (1001 - ще не показували)
+    uint32_t sweepPosition;
+    bool sweepActive;
 };
 
 #endif // MODEL_HPP
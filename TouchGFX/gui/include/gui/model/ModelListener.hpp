@@ -14,6 +14,8 @@ public:
     {
         model = m;
     }
+
+    virtual void sweepPositionChanged(uint32_t /*permille*/, uint32_t /*freq_mhz*/) {}
 protected:
     Model* model;
 };
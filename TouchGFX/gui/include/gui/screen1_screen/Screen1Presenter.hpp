@@ -27,6 +27,8 @@ public:
 
     virtual void buttonStartUpdate(bool state);
 
+    virtual void sweepPositionChanged(uint32_t permille, uint32_t freq_mhz);
+
     virtual ~Screen1Presenter() {}
 
 private:
@@ -21,6 +21,8 @@ public:
 
     virtual void ButtonTextUpdate();
 
+    void showSweepFrequency(uint32_t freq_mhz);
+
 protected:
 };
 
@@ -1,12 +1,27 @@
 #include <gui/model/Model.hpp>
 #include <gui/model/ModelListener.hpp>
+#include "signal_gen.h"
 
-Model::Model() : modelListener(0)
+Model::Model() : modelListener(0), sweepPosition(1001), sweepActive(false)
 {
 
 }
 
 void Model::tick()
 {
+	// Свіп крокує в ISR DMA, GUI лише опитує позицію раз на кадр
+	bool active = SignalGen_IsSweeping();
 
+	if (active || sweepActive)
+	{
+		uint32_t position = SignalGen_GetSweepPosition_permille();
+
+		if (position != sweepPosition && modelListener)
+		{
+			sweepPosition = position;
+			modelListener->sweepPositionChanged(position, SignalGen_GetFrequency_mHz());
+		}
+	}
+	if (!active) sweepPosition = 1001;
+	sweepActive = active;
 }
@@ -26,3 +26,8 @@ void Screen1Presenter::buttonStartUpdate(bool state)
 {
 
 }
+
+void Screen1Presenter::sweepPositionChanged(uint32_t permille, uint32_t freq_mhz)
+{
+	view.showSweepFrequency(freq_mhz);
+}
@@ -10,8 +10,6 @@
 #include <stdint.h>
 
 
-extern uint16_t sine_table[];
-extern TIM_HandleTypeDef htim7;
 extern bool dacStart;
 
 Screen1View::Screen1View()
@@ -44,7 +42,7 @@ void Screen1View::ButtonStartPresset()
 		);
 		dacStart = false;
 		ButtonWithLabelState = true;
-		HAL_TIM_Base_Start(&htim7);
+		SignalGen_SetOutput(1);
 	}else
 	{
 		buttonWithLabel1.setLabelText(touchgfx::TypedText(T_TXT_START));
@@ -54,7 +52,7 @@ void Screen1View::ButtonStartPresset()
 		);
 		dacStart = true;
 		ButtonWithLabelState = false;
-		HAL_TIM_Base_Stop(&htim7);
+		SignalGen_SetOutput(0);
 	}
 	buttonWithLabel1.invalidate();
 
@@ -76,25 +74,40 @@ void Screen1View::ButtonTextUpdate()
 
 void Screen1View::setSlider1Value(int value)
 {
+	// Слайдер 1 обирає форму сигналу (0..WAVEFORM_COUNT-1)
+	Waveform_t form = (Waveform_t)value;
 
-	Unicode::snprintf(textArea6Buffer, TEXTAREA6_SIZE, "%d", value);
+	Unicode::strncpy(textArea6Buffer, Waveform_Name(form), TEXTAREA6_SIZE);
 	textArea6.invalidate();
+	SignalGen_SetWaveform(form);
 
 	//slider1.invalidate();
 }
 
 void Screen1View::setSlider2Value(int value)
 {
+	uint32_t freq_hz = value * SG_SLIDER_FREQ_STEP_HZ;
+	float floatValue = freq_hz / 1000.0f;
 
-	Unicode::snprintf(textArea7Buffer, TEXTAREA7_SIZE, "%d", value);
+	Unicode::snprintfFloat(textArea7Buffer, TEXTAREA7_SIZE, "%.1f", floatValue);
+	textArea7.invalidate();
+	// Планувальник підбирає PSC/ARR/N на кожен рух слайдера
+	SignalGen_SetFrequencyExact_mHz(freq_hz * 1000U);
+}
+
+// Поточна частота свіпу в тому ж полі, що й частота слайдера (кГц)
+void Screen1View::showSweepFrequency(uint32_t freq_mhz)
+{
+	Unicode::snprintfFloat(textArea7Buffer, TEXTAREA7_SIZE, "%.1f", freq_mhz / 1000000.0f);
 	textArea7.invalidate();
 }
 
 void Screen1View::setSlider3Value(int value)
 {
-	float floatValue = value/10.0f;
-	Unicode::snprintfFloat(textArea8Buffer, TEXTAREA7_SIZE, "%.1f", floatValue);
+	// Слайдер 3: скважність 0..100 %
+	Unicode::snprintf(textArea8Buffer, TEXTAREA8_SIZE, "%d", value);
 	textArea8.invalidate();
+	SignalGen_SetDuty_permille(value * 10U);
 }
 
 void Screen1View::setSlider4Value(int value)
@@ -103,6 +116,5 @@ void Screen1View::setSlider4Value(int value)
 	Unicode::snprintfFloat(textArea9Buffer, TEXTAREA7_SIZE, "%.1f", floatValue);
 	textArea9.invalidate();
 	Generete_SineTable(value);
-	SCB_CleanDCache_by_Addr((uint32_t*) sine_table, SINE_SAMPLES * sizeof(uint16_t));
 }
 